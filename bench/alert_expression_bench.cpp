@@ -0,0 +1,93 @@
+// Alert expressions at scale: compiling a rule, and evaluating thousands of compiled rules per tick against
+// 300-sample histories, split by the kind of work each rule does.
+#include "bench_support.hpp"
+#include "core/alert_expression.hpp"
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using BenchSupport::DoNotOptimize;
+using BenchSupport::Measure;
+using BenchSupport::Report;
+
+namespace
+{
+	struct Memory
+	{
+		uint64_t total = 16ull << 30;
+		uint64_t used = 12ull << 30;
+	};
+}
+
+int main()
+{
+	static constexpr QuantileSketch::Mapping Percent{ 0.1f, 100.0f, 0.01f };
+	SeriesArena arena(2 * TieredSeries::storageBytes(300) + 2 * QuantileWindows::storageBytes(Percent));
+	TieredSeries cpuHistory;
+	TieredSeries diskHistory;
+	QuantileWindows cpuQuantiles;
+	QuantileWindows diskQuantiles;
+	cpuHistory.allocate(arena, 300);
+	diskHistory.allocate(arena, 300);
+	cpuQuantiles.allocate(arena, Percent);
+	diskQuantiles.allocate(arena, Percent);
+
+	// A full raw window, pushed past capacity so the ring wraps
+	float cpu = 0.0f;
+	float disk = 0.0f;
+	for (uint64_t i = 0; i < 450; ++i) {
+		cpu = static_cast<float>((i * 37) % 100);
+		disk = static_cast<float>((i * 13) % 100);
+		cpuHistory.push(1000 + i * 1000, cpu);
+		diskHistory.push(1000 + i * 1000, disk);
+		cpuQuantiles.push(1000 + i * 1000, cpu);
+		diskQuantiles.push(1000 + i * 1000, disk);
+	}
+	uint32_t procs = 400;
+	Memory memory;
+
+	MetricTable metrics;
+	metrics.Add("cpu", cpu, &cpuHistory, &cpuQuantiles);
+	metrics.Add("disk", disk, &diskHistory, &diskQuantiles);
+	metrics.Add("procs", procs);
+	metrics.AddComputed("mem.available", &memory, [](const void* context) {
+		const Memory& memory = *static_cast<const Memory*>(context);
+		return static_cast<double>(memory.total - memory.used);
+	});
+
+	const std::pair<const char*, const char*> cases[] = {
+		{ "latest values", "cpu > 80 and procs > 1000 or mem.available < 2GiB" },
+		{ "avg over 30 s", "avg(cpu, 30s) > 80" },
+		{ "avg/min/max over 5 min", "avg(cpu, 5m) > 80 or min(disk, 5m) > 50 or max(cpu, 5m) > 99" },
+		{ "percentiles", "p95(cpu, 1m) > 90 and p99(disk, 1h) > 95" },
+		{ "mixed", "avg(cpu, 30s) > 10 and mem.available < 8GiB and not (p50(disk, 1m) < 5)" }
+	};
+
+	std::string error;
+	for (const auto& [name, source] : cases) {
+		AlertExpression expression;
+		std::string label = std::string("compile, ") + name;
+		Report(label.c_str(), Measure(10'000, [&] { DoNotOptimize(expression.Compile(source, metrics, error)); }));
+	}
+
+	// 5000 rules of each kind, evaluated once per tick as UpdateAlerts does
+	constexpr size_t RuleCount = 5000;
+	for (const auto& [name, source] : cases) {
+		std::vector<AlertExpression> rules(RuleCount);
+		for (AlertExpression& rule : rules) {
+			if (!rule.Compile(source, metrics, error)) {
+				std::fprintf(stderr, "%s: %s\n", source, error.c_str());
+				return 1;
+			}
+		}
+		double ns = Measure(20, [&] {
+			size_t hits = 0;
+			for (const AlertExpression& rule : rules) hits += rule.Test(metrics) ? 1 : 0;
+			DoNotOptimize(hits);
+		});
+		std::string label = "5000 rules, " + std::string(name);
+		Report((label + " per tick").c_str(), ns);
+		Report((label + " per rule").c_str(), ns / static_cast<double>(RuleCount));
+	}
+	return 0;
+}
@@ -0,0 +1,108 @@
+// Anomaly scoring for hundreds of metrics per tick: EwmaBaseline, SeasonalBaseline and AnomalyDetector with and
+// without the seasonal baseline, each updated once per metric per 1 Hz tick as AnomalyMonitor does.
+#include "bench_support.hpp"
+#include "core/anomaly_detector.hpp"
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+using BenchSupport::DoNotOptimize;
+using BenchSupport::Measure;
+using BenchSupport::Report;
+
+namespace
+{
+	constexpr size_t Ticks = 4096; // Samples prepared per metric, replayed in a loop
+	constexpr uint64_t TickMs = 1000;
+	// The default daily period would need a day of warm-up ticks; an hour with the same 288 slots exercises the
+	// same per-slot state once warm
+	constexpr uint64_t SeasonPeriodMs = 3'600'000;
+
+	// A wave, noise and the occasional spike per metric; tick-major, so one tick's samples sit together as the
+	// collector would have them
+	std::vector<float> MakeSamples(size_t metrics)
+	{
+		std::mt19937 random(3);
+		std::normal_distribution<float> noise(0.0f, 2.0f);
+		std::vector<float> samples(metrics * Ticks);
+		for (size_t m = 0; m < metrics; ++m) {
+			float base = 10.0f + static_cast<float>(m % 70);
+			for (size_t t = 0; t < Ticks; ++t) {
+				float wave = 10.0f * std::sin(static_cast<float>(t) * 6.2831853f / 900.0f + static_cast<float>(m));
+				float spike = random() % 500 == 0 ? 40.0f : 0.0f;
+				samples[t * metrics + m] = base + wave + noise(random) + spike;
+			}
+		}
+		return samples;
+	}
+
+	// Runs update(metric, timeMs, value) for every metric once per call, advancing one tick each time
+	template<typename Update>
+	void BenchTicks(const char* name, size_t metrics, const std::vector<float>& samples, uint64_t& timeMs, Update&& update)
+	{
+		size_t tick = 0;
+		double ns = Measure(2000, [&] {
+			for (size_t m = 0; m < metrics; ++m) update(m, timeMs, samples[tick * metrics + m]);
+			timeMs += TickMs;
+			tick = (tick + 1) % Ticks;
+		});
+		std::string label = std::to_string(metrics) + " x " + name;
+		Report((label + " per tick").c_str(), ns);
+		Report((label + " per update").c_str(), ns / static_cast<double>(metrics));
+	}
+
+	void Run(size_t metrics)
+	{
+		const std::vector<float> samples = MakeSamples(metrics);
+		// Starts past one season, after the warm-up pass below, so the seasonal paths are measured warm
+		uint64_t warmupTicks = SeasonPeriodMs / TickMs + 1;
+
+		{
+			std::vector<EwmaBaseline> baselines(metrics);
+			uint64_t timeMs = 0;
+			BenchTicks("EwmaBaseline", metrics, samples, timeMs, [&](size_t m, uint64_t, float value) {
+				DoNotOptimize(baselines[m].update(value, 1.0f));
+			});
+		}
+
+		{
+			std::vector<SeasonalBaseline> baselines(metrics, SeasonalBaseline(SeasonPeriodMs, 288));
+			uint64_t timeMs = 0;
+			for (uint64_t t = 0; t < warmupTicks; ++t, timeMs += TickMs) {
+				for (size_t m = 0; m < metrics; ++m) baselines[m].update(timeMs, samples[(t % Ticks) * metrics + m], 1.0f);
+			}
+			BenchTicks("SeasonalBaseline", metrics, samples, timeMs, [&](size_t m, uint64_t time, float value) {
+				DoNotOptimize(baselines[m].update(time, value, 1.0f));
+			});
+		}
+
+		for (bool seasonal : { false, true }) {
+			AnomalyDetector::Config config;
+			config.seasonal = seasonal;
+			config.seasonPeriodMs = SeasonPeriodMs;
+			std::vector<AnomalyDetector> detectors(metrics, AnomalyDetector(config));
+			uint64_t timeMs = 0;
+			if (seasonal) {
+				for (uint64_t t = 0; t < warmupTicks; ++t, timeMs += TickMs) {
+					for (size_t m = 0; m < metrics; ++m) detectors[m].update(timeMs, samples[(t % Ticks) * metrics + m]);
+				}
+			}
+			size_t anomalous = 0;
+			BenchTicks(seasonal ? "AnomalyDetector, seasonal" : "AnomalyDetector, EWMA", metrics, samples, timeMs,
+				[&](size_t m, uint64_t time, float value) { anomalous += detectors[m].update(time, value) ? 1 : 0; });
+			DoNotOptimize(anomalous);
+		}
+
+		std::printf("\n");
+	}
+}
+
+int main()
+{
+	std::printf("%-48s %10zu B (+ %zu B per seasonal slot)\n", "sizeof(AnomalyDetector)", sizeof(AnomalyDetector), 2 * sizeof(float));
+	std::printf("\n");
+	for (size_t metrics : { 100, 500, 2000 }) Run(metrics);
+	return 0;
+}
@@ -0,0 +1,44 @@
+// BenchSupport: Timing helpers shared by the benchmarks. Each benchmark is its own executable that prints one line
+// per case; they are built with the tests but not run by ctest, since timings depend on the machine.
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+namespace BenchSupport
+{
+	// Keeps the compiler from discarding a result the benchmark doesn't otherwise use
+	template<typename T>
+	inline void DoNotOptimize(const T& value)
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : "r,m"(value) : "memory");
+#else
+		static volatile const void* sink;
+		sink = &value;
+#endif
+	}
+
+	// Median over rounds of the wall time of `iterations` calls to run, in nanoseconds per call
+	template<typename Function>
+	double Measure(size_t iterations, Function&& run, int rounds = 7)
+	{
+		std::vector<double> perCall;
+		for (int round = 0; round < rounds; ++round) {
+			auto start = std::chrono::steady_clock::now();
+			for (size_t i = 0; i < iterations; ++i) run();
+			double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+			perCall.push_back(ns / static_cast<double>(iterations));
+		}
+		std::nth_element(perCall.begin(), perCall.begin() + perCall.size() / 2, perCall.end());
+		return perCall[perCall.size() / 2];
+	}
+
+	inline void Report(const char* name, double nsPerCall)
+	{
+		if (nsPerCall >= 1e6) std::printf("%-48s %10.3f ms\n", name, nsPerCall / 1e6);
+		else if (nsPerCall >= 1e3) std::printf("%-48s %10.3f us\n", name, nsPerCall / 1e3);
+		else std::printf("%-48s %10.2f ns\n", name, nsPerCall);
+	}
+}
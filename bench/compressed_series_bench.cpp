@@ -0,0 +1,137 @@
+// CompressedSeries against the RingBuffer<float, 300> the per-subsystem histories use: bytes per sample for a day
+// of 1 Hz samples of differently shaped metrics, how long the selected-process budget lasts, and push and decode
+// throughput per sample.
+#include "bench_support.hpp"
+#include "core/compressed_series.hpp"
+#include "core/ring_buffer.hpp"
+#include "core/system_state.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+using BenchSupport::DoNotOptimize;
+using BenchSupport::Measure;
+using BenchSupport::Report;
+
+namespace
+{
+	constexpr size_t Day = 24 * 60 * 60;
+
+	struct Workload
+	{
+		const char* name;
+		std::vector<int64_t> times;
+		std::vector<float> values;
+	};
+
+	// 1 Hz ticks with a few milliseconds of scheduling jitter, as the collector produces them
+	std::vector<int64_t> MakeTimes(size_t count, std::mt19937& random)
+	{
+		std::vector<int64_t> times(count);
+		std::uniform_int_distribution<int> jitter(-4, 4);
+		for (size_t i = 0; i < count; ++i) times[i] = 1'000'000 + static_cast<int64_t>(i) * 1000 + jitter(random);
+		return times;
+	}
+
+	std::vector<Workload> MakeWorkloads(size_t count)
+	{
+		std::mt19937 random(11);
+		std::vector<Workload> workloads;
+
+		// Busy CPU percentage: a wandering level plus noise, every sample a different float
+		Workload cpu{ "cpu % (noisy)", MakeTimes(count, random), {} };
+		std::normal_distribution<float> noise(0.0f, 3.0f);
+		float level = 30.0f;
+		for (size_t i = 0; i < count; ++i) {
+			level = std::clamp(level + noise(random) * 0.1f, 5.0f, 95.0f);
+			cpu.values.push_back(std::clamp(level + noise(random), 0.0f, 100.0f));
+		}
+		workloads.push_back(std::move(cpu));
+
+		// Idle process: 0 % with the occasional blip
+		Workload idle{ "cpu % (idle)", MakeTimes(count, random), {} };
+		for (size_t i = 0; i < count; ++i) idle.values.push_back(random() % 60 == 0 ? 0.5f : 0.0f);
+		workloads.push_back(std::move(idle));
+
+		// Resident memory in bytes: page-sized steps that hold for a while
+		Workload memory{ "memory bytes (steps)", MakeTimes(count, random), {} };
+		double bytes = 512.0 * 1024 * 1024;
+		for (size_t i = 0; i < count; ++i) {
+			if (random() % 10 == 0) bytes += 4096.0 * static_cast<double>(static_cast<int>(random() % 64) - 24);
+			memory.values.push_back(static_cast<float>(bytes));
+		}
+		workloads.push_back(std::move(memory));
+		return workloads;
+	}
+
+	template<typename Series>
+	Series Fill(const Workload& workload, Series series)
+	{
+		for (size_t i = 0; i < workload.times.size(); ++i) series.push(workload.times[i], workload.values[i]);
+		return series;
+	}
+}
+
+int main()
+{
+	const std::vector<Workload> workloads = MakeWorkloads(Day);
+
+	// RingBuffer keeps 300 values; a history that also draws by time needs a second ring for the timestamps
+	double ringValueBytes = static_cast<double>(sizeof(RingBuffer<float, 300>)) / 300.0;
+	double ringTimedBytes = static_cast<double>(sizeof(RingBuffer<float, 300>) + sizeof(RingBuffer<uint64_t, 300>)) / 300.0;
+	std::printf("%-48s %10.2f B/sample\n", "RingBuffer<float, 300>", ringValueBytes);
+	std::printf("%-48s %10.2f B/sample\n", "RingBuffer<float, 300> + RingBuffer<uint64_t, 300>", ringTimedBytes);
+
+	for (const Workload& workload : workloads) {
+		// Enough blocks to keep the whole day, so the ratio isn't hidden by eviction
+		CompressedSeries series = Fill(workload, CompressedSeries(4096));
+		std::string name = std::string(workload.name) + ", a day";
+		std::printf("%-48s %10.2f B/sample (%zu blocks)\n", name.c_str(),
+			static_cast<double>(series.encodedBytes()) / static_cast<double>(series.size()), series.blockCount());
+
+		// What the selected-process history keeps before it starts dropping its oldest block
+		CompressedSeries budget = Fill(workload, CompressedSeries(ProcessHistory::MaxBlocks));
+		double hours = static_cast<double>(budget.latestTime() - budget.oldestTime()) / 3.6e6;
+		name = std::string(workload.name) + ", ProcessHistory budget";
+		std::printf("%-48s %10.1f h in %zu KiB\n", name.c_str(), hours, budget.memoryBytes() / 1024);
+	}
+
+	std::printf("\n");
+	for (const Workload& workload : workloads) {
+		std::string name = std::string("push, ") + workload.name;
+		Report(name.c_str(), Measure(3, [&] {
+			CompressedSeries series(4096);
+			for (size_t i = 0; i < workload.times.size(); ++i) series.push(workload.times[i], workload.values[i]);
+			DoNotOptimize(series.size());
+		}) / static_cast<double>(workload.times.size()));
+
+		CompressedSeries series = Fill(workload, CompressedSeries(4096));
+		name = std::string("decode (forEach), ") + workload.name;
+		Report(name.c_str(), Measure(5, [&] {
+			float sum = 0.0f;
+			series.forEach([&sum](int64_t, float value) { sum += value; });
+			DoNotOptimize(sum);
+		}) / static_cast<double>(series.size()));
+
+		// A graph of the last 5 minutes only decodes the blocks that reach into them
+		std::vector<int64_t> times;
+		std::vector<float> values;
+		name = std::string("decode last 300 s, ") + workload.name;
+		Report(name.c_str(), Measure(1000, [&] {
+			series.decode(series.latestTime() - 300'000, times, values);
+			DoNotOptimize(values.size());
+		}));
+	}
+
+	RingBuffer<float, 300> ring;
+	for (size_t i = 0; i < 300; ++i) ring.push(workloads[0].values[i]);
+	Report("RingBuffer<float, 300> walk, per sample", Measure(100'000, [&] {
+		float sum = 0.0f;
+		for (float value : ring) sum += value;
+		DoNotOptimize(sum);
+	}) / 300.0);
+	return 0;
+}
@@ -0,0 +1,95 @@
+// Filtering a synthetic 50k-process snapshot: rebuilding the store and the filter index each tick, a fresh query,
+// and typing a query one character at a time. Every query and keystroke has to finish within a millisecond; one that
+// doesn't is reported as FAIL and makes the exit status nonzero.
+#include "bench_support.hpp"
+#include "monitoring/process_filter.hpp"
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <string>
+
+using BenchSupport::DoNotOptimize;
+using BenchSupport::Measure;
+using BenchSupport::Report;
+
+namespace
+{
+	constexpr double BudgetNs = 1e6;
+
+	// Reports a query or keystroke and whether it went over budget
+	bool ReportQuery(const std::string& name, double ns)
+	{
+		Report(name.c_str(), ns);
+		if (ns <= BudgetNs) return false;
+		std::printf("FAIL: %s took over 1 ms\n", name.c_str());
+		return true;
+	}
+
+	std::vector<ProcessInfo> MakeProcesses(size_t count)
+	{
+		static const char* const Names[] = { "chrome", "firefox", "code", "python3", "node", "java", "postgres", "nginx",
+			"systemd", "bash", "zsh", "kworker", "rust-analyzer", "clangd", "Xorg", "pipewire", "gnome-shell", "dockerd",
+			"containerd", "sshd" };
+		static const char* const Users[] = { "root", "alice", "bob", "postgres", "www-data" };
+
+		std::mt19937 random(7);
+		std::vector<ProcessInfo> processes(count);
+		for (size_t i = 0; i < count; ++i) {
+			ProcessInfo& process = processes[i];
+			std::string name = Names[random() % std::size(Names)];
+			process.pid = static_cast<uint32_t>(100 + i * 3);
+			process.name = random() % 3 == 0 ? name + "-" + std::to_string(random() % 5000) : name;
+			process.filePath = "/usr/lib/" + name + "/bin/" + name;
+			process.commandLine = process.filePath + " --type=renderer --field-trial-handle=" + std::to_string(random());
+			process.userName = Users[random() % std::size(Users)];
+			process.uid = static_cast<uint32_t>(random() % std::size(Users));
+		}
+		return processes;
+	}
+}
+
+int main()
+{
+	const std::vector<ProcessInfo> processes = MakeProcesses(50'000);
+	ProcessStore store;
+	store.assign(processes);
+	std::printf("50000 processes, %zu distinct strings\n", store.strings().size());
+
+	Report("ProcessStore::assign", Measure(5, [&] { store.assign(processes); }));
+
+	ProcessFilter filter;
+	filter.Update(store);
+	Report("assign + ProcessFilter::Update (new snapshot)", Measure(5, [&] {
+		store.assign(processes);
+		filter.Update(store);
+	}));
+
+	bool failed = false;
+	for (const char* query : { "node", "POSTGRES", "renderer", "user:bob", "pid:4711", "1234", "zzz" }) {
+		std::string name = std::string("SetQuery \"") + query + "\" from empty";
+		failed |= ReportQuery(name, Measure(20, [&] {
+			filter.SetQuery(store, "");
+			filter.SetQuery(store, query);
+			DoNotOptimize(filter.GetMatches().size());
+		}));
+	}
+
+	// Typing one character at a time; each keystroke narrows the previous matches
+	const std::string typed = "chrome-12";
+	std::vector<std::vector<double>> keystrokeNs(typed.size());
+	for (int round = 0; round < 21; ++round) {
+		filter.SetQuery(store, "");
+		for (size_t length = 1; length <= typed.size(); ++length) {
+			auto start = std::chrono::steady_clock::now();
+			filter.SetQuery(store, typed.substr(0, length));
+			keystrokeNs[length - 1].push_back(std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count());
+		}
+	}
+	for (size_t length = 1; length <= typed.size(); ++length) {
+		std::vector<double>& samples = keystrokeNs[length - 1];
+		std::nth_element(samples.begin(), samples.begin() + samples.size() / 2, samples.end());
+		std::string name = "keystroke \"" + typed.substr(0, length) + "\"";
+		failed |= ReportQuery(name, samples[samples.size() / 2]);
+	}
+	return failed ? 1 : 0;
+}
@@ -0,0 +1,77 @@
+// SeriesStats kernels side by side: scalar, SSE2 and AVX2 (where the CPU has it) for Min, Max, Summarize and
+// LastAbove, over a 300-sample window as the graphs and alerts use it, a wrapped 300-sample ring, and long spans.
+#include "bench_support.hpp"
+#include "core/ring_buffer.hpp"
+#include "core/series_stats.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+using BenchSupport::DoNotOptimize;
+using BenchSupport::Measure;
+using BenchSupport::Report;
+
+namespace
+{
+	// Enough calls per round that the shortest case still runs for milliseconds
+	size_t Iterations(size_t count)
+	{
+		return std::max<size_t>(20, 20'000'000 / count);
+	}
+
+	void RunSpan(const char* kernel, std::span<const float> values, const char* shape)
+	{
+		size_t iterations = Iterations(values.size());
+		auto name = [kernel, shape](const char* operation) { return std::string(kernel) + " " + operation + ", " + shape; };
+
+		Report(name("Min").c_str(), Measure(iterations, [values] { DoNotOptimize(SeriesStats::Min(values)); }));
+		Report(name("Max").c_str(), Measure(iterations, [values] { DoNotOptimize(SeriesStats::Max(values)); }));
+		Report(name("Summarize").c_str(), Measure(iterations, [values] { DoNotOptimize(SeriesStats::Summarize(values)); }));
+		// Nothing is above the threshold, so the search has to scan the whole span
+		Report(name("LastAbove (no hit)").c_str(), Measure(iterations, [values] { DoNotOptimize(SeriesStats::LastAbove(values, 101.0f)); }));
+	}
+
+	void RunRing(const char* kernel, const RingBuffer<float, 300>& ring)
+	{
+		size_t iterations = Iterations(ring.size());
+		auto name = [kernel](const char* operation) { return std::string(kernel) + " " + operation + ", 300 wrapped ring"; };
+
+		Report(name("Summarize").c_str(), Measure(iterations, [&ring] { DoNotOptimize(SeriesStats::Summarize(ring.view())); }));
+		Report(name("LastAbove (no hit)").c_str(), Measure(iterations, [&ring] { DoNotOptimize(SeriesStats::LastAbove(ring.view(), 101.0f)); }));
+	}
+}
+
+int main()
+{
+	std::mt19937 random(5);
+	std::uniform_real_distribution<float> percent(0.0f, 100.0f);
+	std::vector<float> values(1 << 20);
+	for (float& value : values) value = percent(random);
+
+	// Pushed past capacity so the window is split across the end of the storage
+	RingBuffer<float, 300> ring;
+	for (size_t i = 0; i < 450; ++i) ring.push(values[i]);
+
+	const std::pair<SeriesStats::Kernel, const char*> kernels[] = {
+		{ SeriesStats::Kernel::Scalar, "scalar" },
+		{ SeriesStats::Kernel::Sse2, "SSE2" },
+		{ SeriesStats::Kernel::Avx2, "AVX2" }
+	};
+	for (const auto& [kernel, name] : kernels) {
+		if (!SeriesStats::UseKernel(kernel)) {
+			std::printf("%s: not available on this CPU or build\n\n", name);
+			continue;
+		}
+		RunSpan(name, std::span<const float>(values).first(300), "300");
+		RunRing(name, ring);
+		RunSpan(name, std::span<const float>(values).first(64 * 1024), "64Ki");
+		RunSpan(name, values, "1Mi");
+		std::printf("\n");
+	}
+
+	SeriesStats::UseKernel(SeriesStats::Kernel::Best);
+	std::printf("default kernel: %s\n", SeriesStats::KernelName());
+	return 0;
+}
@@ -0,0 +1,432 @@
+#include "alert_expression.hpp"
+#include "series_stats.hpp"
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+size_t MetricTable::Find(std::string_view name) const
+{
+	for (size_t i = 0; i < metrics_.size(); ++i) {
+		if (metrics_[i].name == name) return i;
+	}
+	return npos;
+}
+
+// Recursive descent, lowest precedence first:
+//   or:         and (("or" | "||") and)*
+//   and:        not (("and" | "&&") not)*
+//   not:        ("not" | "!") not | comparison
+//   comparison: additive (("<" | "<=" | ">" | ">=" | "==" | "!=") additive)?
+//   additive:   term (("+" | "-") term)*
+//   term:       unary (("*" | "/") unary)*
+//   unary:      "-" unary | primary
+//   primary:    number[unit] | ("avg" | "min" | "max") "(" metric "," number duration ")"
+//               | ("p50" | "p95" | "p99") "(" metric "," ("1m" | "1h" | "all") ")" | metric | "(" or ")"
+// Instructions are emitted as each operator is reduced, which gives postfix order directly.
+class AlertExpression::Compiler
+{
+public:
+	Compiler(std::string_view source, const MetricTable& metrics, AlertExpression& out)
+		: source_(source), metrics_(metrics), out_(out) {}
+
+	// On failure error holds the first problem found and where
+	bool Run(std::string& error)
+	{
+		skipSpace();
+		bool ok = true;
+		if (metrics_.size() > std::numeric_limits<uint16_t>::max()) ok = fail("too many metrics in the table");
+		else if (atEnd()) ok = fail("empty expression");
+		if (ok) ok = parseOr();
+		skipSpace();
+		if (ok && !atEnd()) ok = fail("unexpected '" + std::string(1, peek()) + "'");
+		if (!ok) error = error_ + " at column " + std::to_string(errorPos_ + 1);
+		return ok;
+	}
+
+private:
+	static constexpr int MaxNesting = 64; // Bounds parser recursion on inputs like "((((...", which use no stack
+
+	std::string_view source_;
+	const MetricTable& metrics_;
+	AlertExpression& out_;
+	size_t pos_ = 0;
+	size_t depth_ = 0; // Values on the evaluation stack after the instructions emitted so far
+	int nesting_ = 0;
+	std::string error_;
+	size_t errorPos_ = 0;
+
+	bool fail(std::string message)
+	{
+		if (error_.empty()) {
+			error_ = std::move(message);
+			errorPos_ = pos_;
+		}
+		return false;
+	}
+
+	bool atEnd() const { return pos_ >= source_.size(); }
+	char peek(size_t ahead = 0) const { return pos_ + ahead < source_.size() ? source_[pos_ + ahead] : '\0'; }
+
+	void skipSpace()
+	{
+		while (!atEnd() && std::isspace(static_cast<unsigned char>(peek()))) ++pos_;
+	}
+
+	static bool isIdentifierStart(char c) { return std::isalpha(static_cast<unsigned char>(c)) || c == '_'; }
+	static bool isIdentifierChar(char c) { return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '.'; }
+
+	std::string_view peekIdentifier() const
+	{
+		if (!isIdentifierStart(peek())) return {};
+		size_t end = pos_ + 1;
+		while (end < source_.size() && isIdentifierChar(source_[end])) ++end;
+		return source_.substr(pos_, end - pos_);
+	}
+
+	// Consumes symbol, or a keyword that isn't just the start of a longer name ("order" is not "or")
+	bool accept(std::string_view symbol, std::string_view keyword = {})
+	{
+		skipSpace();
+		if (source_.substr(pos_, symbol.size()) == symbol) {
+			pos_ += symbol.size();
+			return true;
+		}
+		if (!keyword.empty() && peekIdentifier() == keyword) {
+			pos_ += keyword.size();
+			return true;
+		}
+		return false;
+	}
+
+	bool emit(Op op, uint16_t metric = 0, uint32_t operand = 0)
+	{
+		switch (op) {
+			case Op::Constant: case Op::Load: case Op::Avg: case Op::Min: case Op::Max: case Op::P50: case Op::P95: case Op::P99:
+				if (++depth_ > MaxStackDepth) return fail("expression is too large");
+				break;
+			case Op::Negate: case Op::Not:
+				break;
+			default:
+				--depth_;
+				break;
+		}
+		out_.program_.push_back({ op, metric, operand });
+		return true;
+	}
+
+	bool parseOr()
+	{
+		if (!parseAnd()) return false;
+		while (accept("||", "or")) {
+			if (!parseAnd() || !emit(Op::Or)) return false;
+		}
+		return true;
+	}
+
+	bool parseAnd()
+	{
+		if (!parseNot()) return false;
+		while (accept("&&", "and")) {
+			if (!parseNot() || !emit(Op::And)) return false;
+		}
+		return true;
+	}
+
+	bool parseNot()
+	{
+		skipSpace();
+		// "!" but not "!="
+		if ((peek() == '!' && peek(1) != '=') || peekIdentifier() == "not") {
+			pos_ += peek() == '!' ? 1 : 3;
+			if (++nesting_ > MaxNesting) return fail("expression is nested too deeply");
+			bool ok = parseNot() && emit(Op::Not);
+			--nesting_;
+			return ok;
+		}
+		return parseComparison();
+	}
+
+	bool parseComparison()
+	{
+		if (!parseAdditive()) return false;
+		static constexpr std::pair<std::string_view, Op> Comparisons[] = {
+			{ "<=", Op::LessEqual }, { ">=", Op::GreaterEqual }, { "==", Op::Equal }, { "!=", Op::NotEqual },
+			{ "<", Op::Less }, { ">", Op::Greater }
+		};
+		for (const auto& [symbol, op] : Comparisons) {
+			if (accept(symbol)) return parseAdditive() && emit(op);
+		}
+		return true;
+	}
+
+	bool parseAdditive()
+	{
+		if (!parseTerm()) return false;
+		for (;;) {
+			if (accept("+")) {
+				if (!parseTerm() || !emit(Op::Add)) return false;
+			} else if (accept("-")) {
+				if (!parseTerm() || !emit(Op::Subtract)) return false;
+			} else {
+				return true;
+			}
+		}
+	}
+
+	bool parseTerm()
+	{
+		if (!parseUnary()) return false;
+		for (;;) {
+			if (accept("*")) {
+				if (!parseUnary() || !emit(Op::Multiply)) return false;
+			} else if (accept("/")) {
+				if (!parseUnary() || !emit(Op::Divide)) return false;
+			} else {
+				return true;
+			}
+		}
+	}
+
+	bool parseUnary()
+	{
+		if (accept("-")) {
+			if (++nesting_ > MaxNesting) return fail("expression is nested too deeply");
+			bool ok = parseUnary() && emit(Op::Negate);
+			--nesting_;
+			return ok;
+		}
+		return parsePrimary();
+	}
+
+	bool parsePrimary()
+	{
+		skipSpace();
+		if (atEnd()) return fail("expression ends early");
+
+		if (accept("(")) {
+			if (++nesting_ > MaxNesting) return fail("expression is nested too deeply");
+			if (!parseOr()) return false;
+			--nesting_;
+			if (!accept(")")) return fail("expected ')'");
+			return true;
+		}
+
+		if (std::isdigit(static_cast<unsigned char>(peek())) || peek() == '.') {
+			double value = 0.0;
+			if (!parseNumber(value)) return false;
+			double scale = 1.0;
+			std::string_view unit = peekIdentifier();
+			if (peek() == '%') {
+				++pos_;
+			} else if (!unit.empty()) {
+				if (!SizeUnit(unit, scale)) return fail("unknown unit '" + std::string(unit) + "'");
+				pos_ += unit.size();
+			}
+			out_.constants_.push_back(value * scale);
+			return emit(Op::Constant, 0, static_cast<uint32_t>(out_.constants_.size() - 1));
+		}
+
+		std::string_view name = peekIdentifier();
+		if (name.empty()) return fail("unexpected '" + std::string(1, peek()) + "'");
+		size_t nameStart = pos_;
+		pos_ += name.size();
+
+		Op window = name == "avg" ? Op::Avg : name == "min" ? Op::Min : name == "max" ? Op::Max : Op::Load;
+		if (window != Op::Load && accept("(")) return parseWindow(window);
+		Op percentile = name == "p50" ? Op::P50 : name == "p95" ? Op::P95 : name == "p99" ? Op::P99 : Op::Load;
+		if (percentile != Op::Load && accept("(")) return parsePercentile(percentile);
+
+		size_t metric = metrics_.Find(name);
+		if (metric == MetricTable::npos) {
+			pos_ = nameStart;
+			return fail("unknown metric '" + std::string(name) + "'");
+		}
+		return emit(Op::Load, static_cast<uint16_t>(metric));
+	}
+
+	// After "avg(": metric "," duration ")"
+	bool parseWindow(Op op)
+	{
+		skipSpace();
+		std::string_view name = peekIdentifier();
+		size_t metric = metrics_.Find(name);
+		if (name.empty()) return fail("expected a metric name");
+		if (metric == MetricTable::npos) return fail("unknown metric '" + std::string(name) + "'");
+		if (!metrics_[metric].history) return fail("metric '" + std::string(name) + "' has no history");
+		pos_ += name.size();
+
+		if (!accept(",")) return fail("expected ','");
+		skipSpace();
+		double value = 0.0;
+		if (!parseNumber(value)) return false;
+		double milliseconds = 0.0;
+		std::string_view unit = peekIdentifier();
+		if (unit == "ms") milliseconds = value;
+		else if (unit == "s") milliseconds = value * 1000.0;
+		else if (unit == "m") milliseconds = value * 60000.0;
+		else if (unit == "h") milliseconds = value * 3600000.0;
+		else return fail("expected a duration such as 30s, 5m or 1h");
+		pos_ += unit.size();
+		if (milliseconds < 1.0 || milliseconds > std::numeric_limits<uint32_t>::max()) return fail("window out of range");
+
+		if (!accept(")")) return fail("expected ')'");
+		return emit(op, static_cast<uint16_t>(metric), static_cast<uint32_t>(milliseconds));
+	}
+
+	// After "p95(": metric "," window ")". Percentiles come from the sketches the collector keeps, so the window is
+	// one of theirs rather than any duration.
+	bool parsePercentile(Op op)
+	{
+		skipSpace();
+		std::string_view name = peekIdentifier();
+		size_t metric = metrics_.Find(name);
+		if (name.empty()) return fail("expected a metric name");
+		if (metric == MetricTable::npos) return fail("unknown metric '" + std::string(name) + "'");
+		if (!metrics_[metric].quantiles) return fail("metric '" + std::string(name) + "' has no percentiles");
+		pos_ += name.size();
+
+		if (!accept(",")) return fail("expected ','");
+		skipSpace();
+		static constexpr std::pair<std::string_view, QuantileWindows::Window> Windows[] = {
+			{ "1m", QuantileWindows::Window::LastMinute }, { "1h", QuantileWindows::Window::LastHour },
+			{ "all", QuantileWindows::Window::SinceStart }
+		};
+		for (const auto& [symbol, window] : Windows) {
+			// "1m" but not the start of "1ms" or "1min"
+			if (source_.substr(pos_, symbol.size()) != symbol || isIdentifierChar(peek(symbol.size()))) continue;
+			pos_ += symbol.size();
+			if (!accept(")")) return fail("expected ')'");
+			return emit(op, static_cast<uint16_t>(metric), static_cast<uint32_t>(window));
+		}
+		return fail("expected a percentile window: 1m, 1h or all");
+	}
+
+	bool parseNumber(double& value)
+	{
+		size_t start = pos_;
+		while (std::isdigit(static_cast<unsigned char>(peek()))) ++pos_;
+		if (peek() == '.') {
+			++pos_;
+			while (std::isdigit(static_cast<unsigned char>(peek()))) ++pos_;
+		}
+		if (pos_ == start || (pos_ == start + 1 && source_[start] == '.')) {
+			pos_ = start;
+			return fail("expected a number");
+		}
+		// strtod needs a terminated string; numbers are short, so a small buffer does
+		char buffer[64];
+		size_t length = std::min(pos_ - start, sizeof(buffer) - 1);
+		std::copy_n(source_.data() + start, length, buffer);
+		buffer[length] = '\0';
+		value = std::strtod(buffer, nullptr);
+		return true;
+	}
+
+	// Binary prefixes are powers of 1024, decimal ones powers of 1000
+	static bool SizeUnit(std::string_view unit, double& scale)
+	{
+		static constexpr std::pair<std::string_view, double> Units[] = {
+			{ "B", 1.0 },
+			{ "KiB", 1024.0 }, { "MiB", 1024.0 * 1024.0 }, { "GiB", 1024.0 * 1024.0 * 1024.0 }, { "TiB", 1024.0 * 1024.0 * 1024.0 * 1024.0 },
+			{ "KB", 1e3 }, { "MB", 1e6 }, { "GB", 1e9 }, { "TB", 1e12 }
+		};
+		for (const auto& [name, value] : Units) {
+			if (unit == name) {
+				scale = value;
+				return true;
+			}
+		}
+		return false;
+	}
+};
+
+bool AlertExpression::Compile(const std::string& source, const MetricTable& metrics, std::string& error)
+{
+	source_ = source;
+	program_.clear();
+	constants_.clear();
+	Compiler compiler(source_, metrics, *this);
+	if (compiler.Run(error)) {
+		program_.shrink_to_fit();
+		constants_.shrink_to_fit();
+		return true;
+	}
+	program_.clear();
+	constants_.clear();
+	return false;
+}
+
+namespace
+{
+	bool IsTrue(double value) { return value != 0.0 && !std::isnan(value); }
+}
+
+double AlertExpression::Evaluate(const MetricTable& metrics) const
+{
+	constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+	if (program_.empty()) return NaN;
+
+	std::array<double, MaxStackDepth> stack;
+	size_t top = 0; // Next free slot; Compile() has checked the program never exceeds MaxStackDepth
+
+	for (const Instruction& instruction : program_) {
+		switch (instruction.op) {
+			case Op::Constant:
+				stack[top++] = constants_[instruction.operand];
+				break;
+			case Op::Load: {
+				const MetricTable::Metric& metric = metrics[instruction.metric];
+				stack[top++] = metric.read(metric.source);
+				break;
+			}
+			case Op::Avg:
+			case Op::Min:
+			case Op::Max: {
+				SeriesStats::Summary summary = metrics[instruction.metric].history->summarize(instruction.operand);
+				double value = instruction.op == Op::Avg ? summary.mean() : instruction.op == Op::Min ? summary.min : summary.max;
+				stack[top++] = summary.count > 0 ? value : NaN;
+				break;
+			}
+			case Op::P50:
+			case Op::P95:
+			case Op::P99: {
+				const QuantileWindows& quantiles = *metrics[instruction.metric].quantiles;
+				const QuantileWindows::Percentiles& percentiles = quantiles.percentiles(static_cast<QuantileWindows::Window>(instruction.operand));
+				double value = instruction.op == Op::P50 ? percentiles.p50 : instruction.op == Op::P95 ? percentiles.p95 : percentiles.p99;
+				stack[top++] = quantiles.empty() ? NaN : value;
+				break;
+			}
+			case Op::Negate: stack[top - 1] = -stack[top - 1]; break;
+			case Op::Not: stack[top - 1] = IsTrue(stack[top - 1]) ? 0.0 : 1.0; break;
+			default: {
+				double right = stack[--top];
+				double& left = stack[top - 1];
+				switch (instruction.op) {
+					case Op::Add: left = left + right; break;
+					case Op::Subtract: left = left - right; break;
+					case Op::Multiply: left = left * right; break;
+					case Op::Divide: left = left / right; break;
+					case Op::Less: left = left < right ? 1.0 : 0.0; break;
+					case Op::LessEqual: left = left <= right ? 1.0 : 0.0; break;
+					case Op::Greater: left = left > right ? 1.0 : 0.0; break;
+					case Op::GreaterEqual: left = left >= right ? 1.0 : 0.0; break;
+					case Op::Equal: left = left == right ? 1.0 : 0.0; break;
+					case Op::NotEqual: left = left < right || left > right ? 1.0 : 0.0; break; // False for NaN, like the rest
+					case Op::And: left = IsTrue(left) && IsTrue(right) ? 1.0 : 0.0; break;
+					case Op::Or: left = IsTrue(left) || IsTrue(right) ? 1.0 : 0.0; break;
+					default: break;
+				}
+				break;
+			}
+		}
+	}
+	return stack[0];
+}
+
+bool AlertExpression::Test(const MetricTable& metrics) const
+{
+	return IsTrue(Evaluate(metrics));
+}
@@ -0,0 +1,116 @@
+// AlertExpression: Small expression language for alert conditions, compiled once to stack bytecode.
+// "avg(cpu, 30s) > 80 and mem.available < 2GiB" or "p95(cpu, 1h) > 90": metrics are looked up by name in a MetricTable at compile time,
+// so evaluation only indexes arrays. It runs on a fixed-size stack and windowed functions read the history in place (raw
+// samples, or its rollups for windows longer than the raw retention; percentiles come from the metric's quantile sketches),
+// so evaluating never allocates and thousands of rules fit in a tick.
+#pragma once
+#include "quantile_sketch.hpp"
+#include "tiered_series.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Named values an expression can refer to. Sources are read through pointers at evaluation time, so they must
+// outlive every expression compiled against the table, and the table must not change once expressions exist.
+class MetricTable
+{
+public:
+	using Reader = double (*)(const void* source);
+
+	struct Metric
+	{
+		std::string name;
+		const void* source = nullptr;
+		Reader read = nullptr;
+		const TieredSeries* history = nullptr; // Needed by avg/min/max; null for plain values
+		const QuantileWindows* quantiles = nullptr; // Needed by p50/p95/p99
+	};
+
+	// Any arithmetic field; history, when given, makes the metric usable in windowed functions, and quantiles
+	// in percentile ones
+	template<typename T>
+	void Add(const std::string& name, const T& value, const TieredSeries* history = nullptr, const QuantileWindows* quantiles = nullptr)
+	{
+		metrics_.push_back({ name, &value, [](const void* source) { return static_cast<double>(*static_cast<const T*>(source)); }, history, quantiles });
+	}
+
+	// A value derived from some context object, e.g. available memory from total and used
+	void AddComputed(const std::string& name, const void* context, Reader read)
+	{
+		metrics_.push_back({ name, context, read, nullptr, nullptr });
+	}
+
+	// Index of the metric, or npos
+	size_t Find(std::string_view name) const;
+
+	const Metric& operator[](size_t index) const { return metrics_[index]; }
+	size_t size() const { return metrics_.size(); }
+
+	static constexpr size_t npos = SIZE_MAX;
+
+private:
+	std::vector<Metric> metrics_;
+};
+
+class AlertExpression
+{
+public:
+	// Replaces the program; on failure returns false, leaves the expression empty and describes the problem
+	// (with its position in source) in error
+	bool Compile(const std::string& source, const MetricTable& metrics, std::string& error);
+
+	// Comparisons and logic give 1 or 0. A windowed function over an empty history gives NaN, which makes every
+	// comparison false, so a rule never fires on data it hasn't seen.
+	double Evaluate(const MetricTable& metrics) const;
+
+	// Evaluate() as a condition: nonzero and not NaN
+	bool Test(const MetricTable& metrics) const;
+
+	bool IsEmpty() const { return program_.empty(); }
+	const std::string& GetSource() const { return source_; }
+	size_t GetInstructionCount() const { return program_.size(); }
+
+	static constexpr size_t MaxStackDepth = 32;
+
+private:
+	enum class Op : uint8_t
+	{
+		Constant, // operand: index into constants_
+		Load, // metric: latest value
+		Avg, // metric over the last operand milliseconds of its history
+		Min,
+		Max,
+		P50, // metric's percentile over the QuantileWindows::Window in operand
+		P95,
+		P99,
+		Negate,
+		Not,
+		Add,
+		Subtract,
+		Multiply,
+		Divide,
+		Less,
+		LessEqual,
+		Greater,
+		GreaterEqual,
+		Equal,
+		NotEqual,
+		And,
+		Or
+	};
+
+	struct Instruction
+	{
+		Op op;
+		uint16_t metric = 0;
+		uint32_t operand = 0;
+	};
+
+	std::string source_;
+	std::vector<Instruction> program_;
+	std::vector<double> constants_;
+
+	class Compiler;
+};
@@ -0,0 +1,73 @@
+// AlertState: Pending/firing state machine of one alert rule, advanced once per evaluation.
+// A value above the threshold makes the rule pending; it fires once the condition has held for the rule's
+// duration and clears only when the value drops to the (lower) clear threshold, so a metric hovering around the
+// threshold doesn't flap. The state is a phase and two timestamps, so each step is O(1) and nothing is rescanned.
+#pragma once
+#include <algorithm>
+#include <cstdint>
+
+class AlertState
+{
+public:
+	enum class Phase
+	{
+		Inactive,
+		Pending,
+		Firing
+	};
+
+	enum class Change
+	{
+		None,
+		Fired,
+		Cleared
+	};
+
+	// A pending condition is only trusted across evaluations this close together; after a longer gap (a stalled
+	// collector, a suspended machine) nobody saw what happened in between, so the hold starts over
+	static constexpr uint64_t MaxGapMs = 10'000;
+
+	// nowMs is monotonic; clearThreshold above threshold is treated as threshold
+	Change update(float value, float threshold, float clearThreshold, uint64_t holdMs, uint64_t nowMs)
+	{
+		bool gap = lastUpdateMs_ != 0 && nowMs - lastUpdateMs_ > MaxGapMs;
+		lastUpdateMs_ = nowMs;
+
+		switch (phase_) {
+			case Phase::Inactive:
+			case Phase::Pending:
+				if (value <= threshold) {
+					phase_ = Phase::Inactive;
+					return Change::None;
+				}
+				if (phase_ == Phase::Inactive || gap) {
+					phase_ = Phase::Pending;
+					pendingSinceMs_ = nowMs;
+				}
+				if (nowMs - pendingSinceMs_ < holdMs) return Change::None;
+				phase_ = Phase::Firing;
+				return Change::Fired;
+			case Phase::Firing:
+				if (value > std::min(clearThreshold, threshold)) return Change::None;
+				phase_ = Phase::Inactive;
+				return Change::Cleared;
+		}
+		return Change::None;
+	}
+
+	Phase phase() const { return phase_; }
+	// When the current pending (or firing) episode began
+	uint64_t pendingSinceMs() const { return pendingSinceMs_; }
+
+	void reset()
+	{
+		phase_ = Phase::Inactive;
+		pendingSinceMs_ = 0;
+		lastUpdateMs_ = 0;
+	}
+
+private:
+	Phase phase_ = Phase::Inactive;
+	uint64_t pendingSinceMs_ = 0;
+	uint64_t lastUpdateMs_ = 0;
+};
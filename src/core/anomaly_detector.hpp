@@ -0,0 +1,203 @@
+// AnomalyDetector: How far each new sample of a metric sits from that metric's own recent behaviour.
+// EwmaBaseline tracks an exponentially weighted mean and variance and scores samples as z-scores; SeasonalBaseline
+// is Brutlag's Holt-Winters variant, which learns a repeating (daily) shape and a typical deviation per slot of
+// it. Once warm, both fold samples in clipped to ClipDeviations (and the EWMA leaves its variance alone for them),
+// so a burst moves the baseline only gradually and stays visible until it has lasted long enough to become the
+// new normal. State is fixed at construction and
+// each update is a handful of arithmetic operations.
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace AnomalyBaseline
+{
+	// How far from the baseline, in deviations, a sample may pull it
+	inline constexpr float ClipDeviations = 3.0f;
+}
+
+class EwmaBaseline
+{
+public:
+	explicit EwmaBaseline(float alpha = 0.02f) : alpha_(alpha) {}
+
+	// Signed distance of value from the baseline in standard deviations, measured before the value is folded in.
+	// Spread is floored at minDeviation so a flat metric doesn't turn every wobble into a huge score; 0 while
+	// the baseline is still warming up.
+	float update(float value, float minDeviation)
+	{
+		float spread = std::max(stdDev(), minDeviation);
+		float diff = value - mean_;
+		float score = warm() ? diff / spread : 0.0f;
+		bool outlier = std::fabs(score) > AnomalyBaseline::ClipDeviations;
+		if (outlier) diff = std::clamp(diff, -AnomalyBaseline::ClipDeviations * spread, AnomalyBaseline::ClipDeviations * spread);
+
+		// Until 1/alpha samples have arrived this is a plain running mean, so the start isn't biased to 0
+		++count_;
+		float weight = std::max(alpha_, 1.0f / static_cast<float>(count_));
+		float increment = weight * diff;
+		mean_ += increment;
+		if (!outlier) variance_ = (1.0f - weight) * (variance_ + diff * increment);
+		return score;
+	}
+
+	float mean() const { return mean_; }
+	float stdDev() const { return std::sqrt(variance_); }
+	bool warm() const { return count_ >= WarmupSamples; }
+
+	void clear()
+	{
+		mean_ = 0.0f;
+		variance_ = 0.0f;
+		count_ = 0;
+	}
+
+private:
+	static constexpr uint32_t WarmupSamples = 30;
+
+	float alpha_;
+	float mean_ = 0.0f;
+	float variance_ = 0.0f;
+	uint32_t count_ = 0;
+};
+
+class SeasonalBaseline
+{
+public:
+	// A period of periodMs split into slots; every sample updates the level, the trend and its slot
+	SeasonalBaseline(uint64_t periodMs, size_t slots, float alpha = 0.01f, float beta = 0.0005f, float gamma = 0.05f)
+		: periodMs_(periodMs), slotMs_(std::max<uint64_t>(periodMs / std::max<size_t>(slots, 1), 1)),
+		  alpha_(alpha), beta_(beta), gamma_(gamma), season_(slots, 0.0f), deviation_(slots, 0.0f)
+	{
+	}
+
+	// Signed distance of value from the forecast in units of the slot's typical deviation, floored at
+	// minDeviation; 0 until one whole period has been seen, since slots haven't all been learnt before that
+	float update(uint64_t timeMs, float value, float minDeviation)
+	{
+		if (season_.empty()) return 0.0f;
+		if (!started_) {
+			startMs_ = timeMs;
+			level_ = value;
+			started_ = true;
+		}
+		size_t slot = static_cast<size_t>((timeMs / slotMs_) % season_.size());
+		float forecast = level_ + trend_ + season_[slot];
+		float error = value - forecast;
+		float spread = std::max(deviation_[slot], minDeviation);
+		float score = warm(timeMs) ? error / spread : 0.0f;
+		if (warm(timeMs)) {
+			error = std::clamp(error, -AnomalyBaseline::ClipDeviations * spread, AnomalyBaseline::ClipDeviations * spread);
+			value = forecast + error;
+		}
+
+		float level = alpha_ * (value - season_[slot]) + (1.0f - alpha_) * (level_ + trend_);
+		trend_ = beta_ * (level - level_) + (1.0f - beta_) * trend_;
+		level_ = level;
+		season_[slot] = gamma_ * (value - level_) + (1.0f - gamma_) * season_[slot];
+		deviation_[slot] = gamma_ * std::fabs(error) + (1.0f - gamma_) * deviation_[slot];
+		return score;
+	}
+
+	float forecast(uint64_t timeMs) const
+	{
+		if (season_.empty()) return level_;
+		return level_ + trend_ + season_[static_cast<size_t>((timeMs / slotMs_) % season_.size())];
+	}
+
+	bool warm(uint64_t timeMs) const { return !season_.empty() && started_ && timeMs - startMs_ >= periodMs_; }
+
+	void clear()
+	{
+		std::fill(season_.begin(), season_.end(), 0.0f);
+		std::fill(deviation_.begin(), deviation_.end(), 0.0f);
+		level_ = 0.0f;
+		trend_ = 0.0f;
+		started_ = false;
+	}
+
+private:
+	uint64_t periodMs_;
+	uint64_t slotMs_;
+	uint64_t startMs_ = 0;
+	float alpha_;
+	float beta_;
+	float gamma_;
+	float level_ = 0.0f;
+	float trend_ = 0.0f;
+	bool started_ = false;
+	std::vector<float> season_;
+	std::vector<float> deviation_;
+};
+
+class AnomalyDetector
+{
+public:
+	struct Config
+	{
+		float threshold = 4.0f; // Score at which a sample counts as anomalous
+		float clearThreshold = 2.0f; // Score an anomaly has to fall back under before it clears
+		uint32_t confirmSamples = 3; // Consecutive anomalous samples before it is reported
+		float minDeviation = 1.0f; // Floor on the spread, in the metric's unit
+		float ewmaAlpha = 0.02f;
+		bool seasonal = false; // Learn a daily shape; costs two floats per slot
+		uint64_t seasonPeriodMs = 86'400'000;
+		size_t seasonSlots = 288; // 5 minute slots
+	};
+
+	AnomalyDetector() : AnomalyDetector(Config{}) {}
+
+	explicit AnomalyDetector(const Config& config)
+		: config_(config), ewma_(config.ewmaAlpha),
+		  seasonal_(config.seasonPeriodMs, config.seasonal ? config.seasonSlots : 0)
+	{
+	}
+
+	// Scores the sample against the seasonal baseline once it has learnt a full period, otherwise against the
+	// EWMA; returns whether the metric is (still) anomalous
+	bool update(uint64_t timeMs, float value)
+	{
+		float ewmaScore = ewma_.update(value, config_.minDeviation);
+		float seasonalScore = seasonal_.update(timeMs, value, config_.minDeviation);
+		score_ = seasonal_.warm(timeMs) ? seasonalScore : ewmaScore;
+		expected_ = seasonal_.warm(timeMs) ? seasonal_.forecast(timeMs) : ewma_.mean();
+
+		float magnitude = std::fabs(score_);
+		if (anomalous_) {
+			if (magnitude < config_.clearThreshold) {
+				anomalous_ = false;
+				streak_ = 0;
+			}
+		} else {
+			streak_ = magnitude >= config_.threshold ? streak_ + 1 : 0;
+			anomalous_ = streak_ >= config_.confirmSamples;
+		}
+		return anomalous_;
+	}
+
+	bool anomalous() const { return anomalous_; }
+	float score() const { return score_; }
+	float expected() const { return expected_; } // What the baseline predicted for the last sample
+	const Config& config() const { return config_; }
+
+	void clear()
+	{
+		ewma_.clear();
+		seasonal_.clear();
+		score_ = 0.0f;
+		expected_ = 0.0f;
+		streak_ = 0;
+		anomalous_ = false;
+	}
+
+private:
+	Config config_;
+	EwmaBaseline ewma_;
+	SeasonalBaseline seasonal_;
+	float score_ = 0.0f;
+	float expected_ = 0.0f;
+	uint32_t streak_ = 0;
+	bool anomalous_ = false;
+};
@@ -0,0 +1,293 @@
+// CompressedSeries: Append-only (timestamp, float) history packed Gorilla-style into fixed-size blocks.
+// Timestamps are stored as delta-of-deltas and values as the XOR with the previous value, so a steady 1 Hz
+// metric costs a few bits per sample instead of the 12 bytes of a raw (int64, float) pair. When the block
+// budget is used up the oldest block is dropped whole; decoding walks the blocks front to back.
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+class CompressedSeries
+{
+public:
+	static constexpr size_t BlockBytes = 1024;
+
+	// maxBlocks bounds memory at roughly maxBlocks * BlockBytes; 0 is treated as 1
+	explicit CompressedSeries(size_t maxBlocks = 64) : maxBlocks_(std::max<size_t>(maxBlocks, 1))
+	{
+		blocks_.reserve(maxBlocks_);
+	}
+
+	// Times must not go backwards (any unit; milliseconds is what the collector uses); earlier samples are dropped
+	void push(int64_t time, float value)
+	{
+		if (count_ > 0 && time < latestTime_) return;
+
+		Block* block = count_ > 0 ? &blockAt(count_ - 1) : nullptr;
+		if (!block || !block->append(time, value)) {
+			block = &startBlock();
+			block->start(time, value);
+		}
+		latestTime_ = time;
+		latestValue_ = value;
+		++size_;
+	}
+
+	size_t size() const { return size_; }
+	bool empty() const { return size_ == 0; }
+	size_t blockCount() const { return count_; }
+	size_t maxBlocks() const { return maxBlocks_; }
+
+	int64_t oldestTime() const { return count_ > 0 ? blockAt(0).firstTime : 0; }
+	int64_t latestTime() const { return latestTime_; }
+	float latest() const { return latestValue_; }
+
+	// Bytes actually holding samples; the fixed cost is maxBlocks() * sizeof(Block) once all blocks exist
+	size_t encodedBytes() const
+	{
+		size_t bits = 0;
+		for (size_t i = 0; i < count_; ++i) bits += blockAt(i).bitCount + HeaderBits;
+		return (bits + 7) / 8;
+	}
+
+	size_t memoryBytes() const { return sizeof(*this) + blocks_.capacity() * sizeof(Block); }
+
+	// Calls visit(time, value) for every sample, oldest first
+	template<typename Visitor>
+	void forEach(Visitor&& visit) const
+	{
+		for (size_t i = 0; i < count_; ++i) blockAt(i).decode(visit);
+	}
+
+	// Samples with time >= from, oldest first; whole blocks that end before `from` are skipped without decoding
+	void decode(int64_t from, std::vector<int64_t>& times, std::vector<float>& values) const
+	{
+		times.clear();
+		values.clear();
+		for (size_t i = 0; i < count_; ++i) {
+			const Block& block = blockAt(i);
+			if (block.lastTime < from) continue;
+			auto collect = [&times, &values, from](int64_t time, float value) {
+				if (time < from) return;
+				times.push_back(time);
+				values.push_back(value);
+			};
+			block.decode(collect);
+		}
+	}
+
+	// Drops the oldest block and every sample in it
+	void evictOldest()
+	{
+		if (count_ == 0) return;
+		size_ -= blockAt(0).sampleCount;
+		head_ = (head_ + 1) % maxBlocks_;
+		--count_;
+		if (count_ == 0) clear();
+	}
+
+	void clear()
+	{
+		head_ = 0;
+		count_ = 0;
+		size_ = 0;
+		latestTime_ = 0;
+		latestValue_ = 0.0f;
+	}
+
+private:
+	// first time, first value, sample count and bit count, charged per block in encodedBytes()
+	static constexpr size_t HeaderBits = 64 + 32 + 32 + 32;
+
+	struct Block
+	{
+		static constexpr size_t Words = BlockBytes / 8;
+		static constexpr size_t CapacityBits = Words * 64;
+		static constexpr size_t MaxSampleBits = 4 + 32 + 2 + 5 + 5 + 32; // Widest timestamp plus widest value
+
+		std::array<uint64_t, Words> words{};
+		uint32_t bitCount = 0;
+		uint32_t sampleCount = 0;
+		int64_t firstTime = 0;
+		int64_t lastTime = 0;
+		int64_t lastDelta = 0;
+		uint32_t firstValueBits = 0;
+		uint32_t lastValueBits = 0;
+		uint8_t lastLeading = 0xFF; // No XOR window yet
+		uint8_t lastTrailing = 0;
+
+		void start(int64_t time, float value)
+		{
+			words.fill(0);
+			bitCount = 0;
+			sampleCount = 1;
+			firstTime = lastTime = time;
+			lastDelta = 0;
+			firstValueBits = lastValueBits = FloatBits(value);
+			lastLeading = 0xFF;
+			lastTrailing = 0;
+		}
+
+		// false when the block is full or the time step can't be encoded; the caller starts a new block
+		bool append(int64_t time, float value)
+		{
+			if (bitCount + MaxSampleBits > CapacityBits) return false;
+			int64_t delta = time - lastTime;
+			int64_t deltaOfDelta = delta - lastDelta;
+			if (deltaOfDelta < INT32_MIN || deltaOfDelta > INT32_MAX) return false;
+
+			// Timestamp buckets as in the Gorilla paper: '0', '10'+7, '110'+9, '1110'+12, '1111'+32 bits
+			if (deltaOfDelta == 0) {
+				write(0, 1);
+			} else if (deltaOfDelta >= -63 && deltaOfDelta <= 64) {
+				write(0b10, 2);
+				write(static_cast<uint64_t>(deltaOfDelta + 63), 7);
+			} else if (deltaOfDelta >= -255 && deltaOfDelta <= 256) {
+				write(0b110, 3);
+				write(static_cast<uint64_t>(deltaOfDelta + 255), 9);
+			} else if (deltaOfDelta >= -2047 && deltaOfDelta <= 2048) {
+				write(0b1110, 4);
+				write(static_cast<uint64_t>(deltaOfDelta + 2047), 12);
+			} else {
+				write(0b1111, 4);
+				write(static_cast<uint32_t>(static_cast<int32_t>(deltaOfDelta)), 32);
+			}
+
+			// Value: '0' if unchanged, '10' + bits inside the previous window, '11' + new window + bits
+			uint32_t bits = FloatBits(value);
+			uint32_t x = bits ^ lastValueBits;
+			if (x == 0) {
+				write(0, 1);
+			} else {
+				uint8_t leading = static_cast<uint8_t>(std::min(std::countl_zero(x), 31));
+				uint8_t trailing = static_cast<uint8_t>(std::countr_zero(x));
+				if (lastLeading != 0xFF && leading >= lastLeading && trailing >= lastTrailing) {
+					write(0b10, 2);
+					write(x >> lastTrailing, 32 - lastLeading - lastTrailing);
+				} else {
+					uint32_t meaningful = 32 - leading - trailing;
+					write(0b11, 2);
+					write(leading, 5);
+					write(meaningful - 1, 5);
+					write(x >> trailing, meaningful);
+					lastLeading = leading;
+					lastTrailing = trailing;
+				}
+			}
+
+			lastTime = time;
+			lastDelta = delta;
+			lastValueBits = bits;
+			++sampleCount;
+			return true;
+		}
+
+		template<typename Visitor>
+		void decode(Visitor& visit) const
+		{
+			int64_t time = firstTime;
+			int64_t delta = 0;
+			uint32_t bits = firstValueBits;
+			uint32_t leading = 0;
+			uint32_t trailing = 0;
+			visit(time, BitsFloat(bits));
+
+			size_t position = 0;
+			for (uint32_t n = 1; n < sampleCount; ++n) {
+				int64_t deltaOfDelta = 0;
+				if (read(position, 1) != 0) {
+					if (read(position, 1) == 0) {
+						deltaOfDelta = static_cast<int64_t>(read(position, 7)) - 63;
+					} else if (read(position, 1) == 0) {
+						deltaOfDelta = static_cast<int64_t>(read(position, 9)) - 255;
+					} else if (read(position, 1) == 0) {
+						deltaOfDelta = static_cast<int64_t>(read(position, 12)) - 2047;
+					} else {
+						deltaOfDelta = static_cast<int32_t>(static_cast<uint32_t>(read(position, 32)));
+					}
+				}
+				delta += deltaOfDelta;
+				time += delta;
+
+				if (read(position, 1) != 0) {
+					if (read(position, 1) != 0) {
+						leading = static_cast<uint32_t>(read(position, 5));
+						uint32_t meaningful = static_cast<uint32_t>(read(position, 5)) + 1;
+						trailing = 32 - leading - meaningful;
+					}
+					bits ^= static_cast<uint32_t>(read(position, 32 - leading - trailing)) << trailing;
+				}
+				visit(time, BitsFloat(bits));
+			}
+		}
+
+		// MSB-first within each word; count is at most 32
+		void write(uint64_t value, uint32_t count)
+		{
+			size_t word = bitCount / 64;
+			uint32_t used = bitCount % 64;
+			uint32_t room = 64 - used;
+			if (count <= room) {
+				words[word] |= value << (room - count);
+			} else {
+				words[word] |= value >> (count - room);
+				words[word + 1] |= value << (64 - (count - room));
+			}
+			bitCount += count;
+		}
+
+		uint64_t read(size_t& position, uint32_t count) const
+		{
+			size_t word = position / 64;
+			uint32_t used = position % 64;
+			uint64_t mask = count == 64 ? ~0ull : ((1ull << count) - 1);
+			uint64_t value;
+			if (used + count <= 64) {
+				value = words[word] >> (64 - used - count);
+			} else {
+				uint32_t spill = used + count - 64;
+				value = (words[word] << spill) | (words[word + 1] >> (64 - spill));
+			}
+			position += count;
+			return value & mask;
+		}
+	};
+
+	size_t maxBlocks_;
+	std::vector<Block> blocks_; // Ring of up to maxBlocks_, allocated as they are first needed
+	size_t head_ = 0;
+	size_t count_ = 0;
+	size_t size_ = 0;
+	int64_t latestTime_ = 0;
+	float latestValue_ = 0.0f;
+
+	Block& blockAt(size_t i) { return blocks_[(head_ + i) % maxBlocks_]; }
+	const Block& blockAt(size_t i) const { return blocks_[(head_ + i) % maxBlocks_]; }
+
+	Block& startBlock()
+	{
+		if (count_ == maxBlocks_) evictOldest();
+		size_t slot = (head_ + count_) % maxBlocks_;
+		if (slot >= blocks_.size()) blocks_.resize(slot + 1);
+		++count_;
+		return blocks_[slot];
+	}
+
+	static uint32_t FloatBits(float value)
+	{
+		uint32_t bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+		return bits;
+	}
+
+	static float BitsFloat(uint32_t bits)
+	{
+		float value;
+		std::memcpy(&value, &bits, sizeof(value));
+		return value;
+	}
+};
@@ -0,0 +1,48 @@
+// CounterRate: Per-second rate of a cumulative counter, over the time that actually passed between readings.
+// A counter that goes backwards has either wrapped at its width or been reset (interface re-created, driver
+// reloaded). A wrap is only assumed for counters narrower than 64 bits, and only when the wrapped delta is
+// small enough to be plausible; anything else starts a new baseline and yields no rate for that reading.
+#pragma once
+#include <chrono>
+#include <cstdint>
+
+class CounterRate
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	// bits is the width the counter wraps at: 32 for the DWORD and "unsigned long" counters some drivers still keep
+	explicit CounterRate(unsigned bits = 64) : mask_(bits >= 64 ? ~0ull : (1ull << bits) - 1) {}
+
+	// false while there's no usable previous reading: the first one, one taken no later than the last, or a reset
+	bool update(uint64_t value, Clock::time_point time, double& ratePerSecond)
+	{
+		value &= mask_;
+		if (hasReading_ && time <= lastTime_) return false;
+
+		bool hasRate = false;
+		if (hasReading_) {
+			uint64_t delta = (value - lastValue_) & mask_; // Modular, so a wrap comes out right by itself
+			bool wrapped = value < lastValue_;
+			if (!wrapped || (mask_ != ~0ull && delta <= mask_ / 2)) {
+				ratePerSecond = static_cast<double>(delta) / std::chrono::duration<double>(time - lastTime_).count();
+				hasRate = true;
+			}
+		}
+		lastValue_ = value;
+		lastTime_ = time;
+		hasReading_ = true;
+		return hasRate;
+	}
+
+	bool hasReading() const { return hasReading_; }
+	uint64_t lastValue() const { return lastValue_; }
+
+	void clear() { hasReading_ = false; }
+
+private:
+	uint64_t mask_;
+	uint64_t lastValue_ = 0;
+	Clock::time_point lastTime_;
+	bool hasReading_ = false;
+};
@@ -0,0 +1,39 @@
+// CpuFeatures: Compile-time x86 detection and the runtime AVX2 check shared by the SIMD code paths.
+// SSE2 is part of x86-64, so it is the baseline; AVX2 functions are compiled with a target attribute (which also
+// enables POPCNT, present on every AVX2 CPU) and only called once HasAvx2() has confirmed both the CPU and the OS
+// support them.
+#pragma once
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define PULSE_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(PULSE_X86) && (defined(__GNUC__) || defined(__clang__))
+#define PULSE_TARGET_AVX2 __attribute__((target("avx2,popcnt")))
+#else
+#define PULSE_TARGET_AVX2
+#endif
+
+#ifdef PULSE_X86
+namespace CpuFeatures
+{
+	inline bool HasAvx2()
+	{
+#ifdef _MSC_VER
+		int info[4] = {};
+		__cpuid(info, 0);
+		if (info[0] < 7) return false;
+		__cpuid(info, 1);
+		bool osSavesYmm = (info[2] & (1 << 27)) && (_xgetbv(0) & 0x6) == 0x6;
+		__cpuidex(info, 7, 0);
+		return osSavesYmm && (info[1] & (1 << 5));
+#else
+		return __builtin_cpu_supports("avx2");
+#endif
+	}
+}
+#endif
@@ -0,0 +1,115 @@
+// HistoryBuffer: Circular buffer like RingBuffer, but with its capacity chosen at runtime.
+// Storage is a slice of a SeriesArena of exactly the capacity, wrapped with a compare as in RingBuffer; the buffer owns
+// no memory itself and must not outlive its arena. A default-constructed buffer has no storage and drops pushes.
+#pragma once
+#include "series_arena.hpp"
+#include "series_view.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <utility>
+
+template<typename T>
+class HistoryBuffer
+{
+public:
+	using const_iterator = typename SeriesView<T>::const_iterator;
+
+	HistoryBuffer() = default;
+
+	HistoryBuffer(SeriesArena& arena, size_t capacity)
+	{
+		if (capacity == 0) return;
+		std::span<T> storage = arena.allocate<T>(capacity);
+		if (storage.empty()) return;
+		buffer_ = storage.data();
+		capacity_ = capacity;
+	}
+
+	// Copies would share storage, so histories are only ever moved into place
+	HistoryBuffer(const HistoryBuffer&) = delete;
+	HistoryBuffer& operator=(const HistoryBuffer&) = delete;
+
+	HistoryBuffer(HistoryBuffer&& other) noexcept
+		: buffer_(std::exchange(other.buffer_, nullptr)), capacity_(std::exchange(other.capacity_, 0)), head_(std::exchange(other.head_, 0)), size_(std::exchange(other.size_, 0))
+	{
+	}
+
+	HistoryBuffer& operator=(HistoryBuffer&& other) noexcept
+	{
+		buffer_ = std::exchange(other.buffer_, nullptr);
+		capacity_ = std::exchange(other.capacity_, 0);
+		head_ = std::exchange(other.head_, 0);
+		size_ = std::exchange(other.size_, 0);
+		return *this;
+	}
+
+	// Arena bytes a buffer of this capacity takes
+	static constexpr size_t storageBytes(size_t capacity)
+	{
+		return capacity > 0 ? SeriesArena::bytesFor<T>(capacity) : 0;
+	}
+
+	void push(const T& value)
+	{
+		if (capacity_ == 0) return;
+		buffer_[head_] = value;
+		if (++head_ == capacity_) head_ = 0;
+		if (size_ < capacity_) ++size_;
+	}
+
+	// Same result as pushing each value in turn
+	void push_range(std::span<const T> values)
+	{
+		if (capacity_ == 0) return;
+		if (values.size() > capacity_) values = values.last(capacity_);
+		size_t first = std::min(values.size(), capacity_ - head_);
+		std::copy_n(values.begin(), first, buffer_ + head_);
+		std::copy(values.begin() + first, values.end(), buffer_);
+		head_ = SeriesView<T>::Wrap(head_ + values.size(), capacity_);
+		size_ = std::min(size_ + values.size(), capacity_);
+	}
+
+	// Oldest first; out of range gives T{}
+	T get(size_t index) const
+	{
+		if (index >= size_) return T{};
+		return buffer_[SeriesView<T>::Wrap(start() + index, capacity_)];
+	}
+
+	// Unchecked get()
+	const T& operator[](size_t index) const { return buffer_[SeriesView<T>::Wrap(start() + index, capacity_)]; }
+
+	size_t size() const { return size_; }
+	size_t capacity() const { return capacity_; }
+	bool empty() const { return size_ == 0; }
+	bool full() const { return size_ == capacity_; }
+
+	T latest() const
+	{
+		if (empty()) return T{};
+		return buffer_[head_ == 0 ? capacity_ - 1 : head_ - 1];
+	}
+
+	SeriesView<T> view() const { return SeriesView<T>(buffer_, capacity_, start(), size_); }
+
+	std::pair<std::span<const T>, std::span<const T>> as_spans() const { return view().as_spans(); }
+	size_t copy_to(std::span<T> out, size_t offset = 0) const { return view().copy_to(out, offset); }
+
+	const_iterator begin() const { return view().begin(); }
+	const_iterator end() const { return view().end(); }
+
+	void clear()
+	{
+		head_ = 0;
+		size_ = 0;
+	}
+
+private:
+	T* buffer_ = nullptr;
+	size_t capacity_ = 0;
+	size_t head_ = 0;
+	size_t size_ = 0;
+
+	size_t start() const { return head_ >= size_ ? head_ - size_ : head_ + capacity_ - size_; }
+};
@@ -4,7 +4,7 @@
 
 class IProcessMonitor
 {
-//public:s
+public:
 	virtual ~IProcessMonitor() = default;
 
 	virtual void UpdateProcesses() = 0;
@@ -0,0 +1,236 @@
+// ProcessStore: Column-oriented process list. Numbers live in parallel arrays so sorting, filtering and
+// aggregation walk dense memory; names, paths, states and owners are interned and referenced by id.
+#pragma once
+#include "string_interner.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Per-process record as reported by the platform monitors; the collector folds these into a ProcessStore
+struct ProcessInfo
+{
+	uint32_t pid = 0;
+	uint32_t parentPid = 0;
+	std::string name;
+	uint64_t memoryUsage = 0;
+	float cpuUsagePercent = 0.0f;
+	std::string status = "Running";
+	uint32_t threadCount = 0;
+	std::string filePath;    // Executable; empty until the platform's lazy metadata fetch has loaded it
+	std::string commandLine; // Arguments joined by spaces; same lazy loading as filePath
+	uint32_t uid = 0;
+	std::string userName; // Empty where the platform doesn't report an owner
+	uint64_t ioReadBytesPerSec = 0;
+	uint64_t ioWriteBytesPerSec = 0;
+	uint32_t fdCount = 0; // Open file descriptors; 0 where not tracked
+	uint64_t fdLimit = 0; // Soft RLIMIT_NOFILE; 0 where unknown
+	
+	ProcessInfo() = default;
+	ProcessInfo(uint32_t p, const std::string& n, uint64_t mem, float cpu) 
+		: pid(p), name(n), memoryUsage(mem), cpuUsagePercent(cpu) {}
+};
+
+// Details that are costly to read and fixed for a process's lifetime, fetched only for processes someone looks at
+struct ProcessMetadata
+{
+	std::string commandLine;
+	std::string executablePath;
+	std::string workingDirectory;
+	std::string cgroup;
+	bool timedOut = false; // The read hung (e.g. a process in D state); left empty rather than retried
+};
+
+class ProcessStore
+{
+public:
+	static constexpr size_t npos = static_cast<size_t>(-1);
+
+	// One row as seen by the UI; the strings point into the intern table and stay valid until the next assign
+	struct Row
+	{
+		uint32_t pid = 0;
+		const std::string* name = nullptr;
+		const std::string* status = nullptr;
+		float cpuUsagePercent = 0.0f;
+		uint64_t memoryUsage = 0;
+		uint64_t ioBytesPerSec = 0;
+		float fdUsagePercent = -1.0f; // Negative when the limit isn't known
+	};
+
+	void assign(const std::vector<ProcessInfo>& processes)
+	{
+		// clear() keeps capacity, so a steady process count means no reallocation per tick
+		clearColumns();
+		reserve(processes.size());
+		for (const auto& process : processes) push(process);
+		compactStrings();
+	}
+
+	size_t size() const { return pid_.size(); }
+	bool empty() const { return pid_.empty(); }
+
+	// Linear scan over the pid column; cheap at process-list sizes and needs no side index
+	size_t find(uint32_t pid) const
+	{
+		for (size_t i = 0; i < pid_.size(); ++i) {
+			if (pid_[i] == pid) return i;
+		}
+		return npos;
+	}
+
+	uint32_t pid(size_t i) const { return pid_[i]; }
+	uint32_t parentPid(size_t i) const { return parentPid_[i]; }
+	uint32_t uid(size_t i) const { return uid_[i]; }
+	float cpuUsagePercent(size_t i) const { return cpu_[i]; }
+	uint64_t memoryUsage(size_t i) const { return memory_[i]; }
+	uint32_t threadCount(size_t i) const { return threads_[i]; }
+	uint64_t ioReadBytesPerSec(size_t i) const { return ioRead_[i]; }
+	uint64_t ioWriteBytesPerSec(size_t i) const { return ioWrite_[i]; }
+	uint32_t fdCount(size_t i) const { return fdCount_[i]; }
+	uint64_t fdLimit(size_t i) const { return fdLimit_[i]; }
+	float fdUsagePercent(size_t i) const
+	{
+		return fdLimit_[i] > 0 ? static_cast<float>(fdCount_[i]) / static_cast<float>(fdLimit_[i]) * 100.0f : -1.0f;
+	}
+
+	uint32_t nameId(size_t i) const { return name_[i]; }
+	uint32_t filePathId(size_t i) const { return filePath_[i]; }
+	uint32_t commandLineId(size_t i) const { return commandLine_[i]; }
+	uint32_t userNameId(size_t i) const { return userName_[i]; }
+	const std::string& name(size_t i) const { return strings_.get(name_[i]); }
+	const std::string& status(size_t i) const { return strings_.get(status_[i]); }
+	const std::string& filePath(size_t i) const { return strings_.get(filePath_[i]); }
+	const std::string& commandLine(size_t i) const { return strings_.get(commandLine_[i]); }
+	const std::string& userName(size_t i) const { return strings_.get(userName_[i]); }
+
+	// Whole columns, for loops that only need one or two fields
+	const std::vector<uint32_t>& pids() const { return pid_; }
+	const std::vector<float>& cpuColumn() const { return cpu_; }
+	const std::vector<uint64_t>& memoryColumn() const { return memory_; }
+	const std::vector<uint32_t>& nameIds() const { return name_; }
+	const std::vector<uint32_t>& filePathIds() const { return filePath_; }
+	const std::vector<uint32_t>& commandLineIds() const { return commandLine_; }
+	const std::vector<uint32_t>& userNameIds() const { return userName_; }
+
+	Row row(size_t i) const
+	{
+		Row result;
+		result.pid = pid_[i];
+		result.name = &name(i);
+		result.status = &status(i);
+		result.cpuUsagePercent = cpu_[i];
+		result.memoryUsage = memory_[i];
+		result.ioBytesPerSec = ioRead_[i] + ioWrite_[i];
+		result.fdUsagePercent = fdUsagePercent(i);
+		return result;
+	}
+
+	ProcessInfo get(size_t i) const
+	{
+		ProcessInfo process;
+		process.pid = pid_[i];
+		process.parentPid = parentPid_[i];
+		process.name = name(i);
+		process.memoryUsage = memory_[i];
+		process.cpuUsagePercent = cpu_[i];
+		process.status = status(i);
+		process.threadCount = threads_[i];
+		process.filePath = filePath(i);
+		process.commandLine = commandLine(i);
+		process.uid = uid_[i];
+		process.userName = userName(i);
+		process.ioReadBytesPerSec = ioRead_[i];
+		process.ioWriteBytesPerSec = ioWrite_[i];
+		process.fdCount = fdCount_[i];
+		process.fdLimit = fdLimit_[i];
+		return process;
+	}
+
+	const StringInterner& strings() const { return strings_; }
+
+	// Bumped whenever the intern table is compacted and ids are renumbered; until then ids only grow
+	uint64_t stringGeneration() const { return stringGeneration_; }
+
+	// Heap use of the columns plus the intern table, for comparing against a vector of ProcessInfo
+	size_t memoryBytes() const
+	{
+		size_t perRow = sizeof(uint32_t) * 10 + sizeof(float) + sizeof(uint64_t) * 4;
+		return pid_.capacity() * perRow + strings_.memoryBytes();
+	}
+
+private:
+	std::vector<uint32_t> pid_;
+	std::vector<uint32_t> parentPid_;
+	std::vector<uint32_t> uid_;
+	std::vector<float> cpu_;
+	std::vector<uint64_t> memory_;
+	std::vector<uint32_t> threads_;
+	std::vector<uint64_t> ioRead_;
+	std::vector<uint64_t> ioWrite_;
+	std::vector<uint32_t> fdCount_;
+	std::vector<uint64_t> fdLimit_;
+	std::vector<uint32_t> name_;
+	std::vector<uint32_t> status_;
+	std::vector<uint32_t> filePath_;
+	std::vector<uint32_t> commandLine_;
+	std::vector<uint32_t> userName_;
+	StringInterner strings_;
+	uint64_t stringGeneration_ = 0;
+
+	void clearColumns()
+	{
+		pid_.clear(); parentPid_.clear(); uid_.clear(); cpu_.clear(); memory_.clear(); threads_.clear();
+		ioRead_.clear(); ioWrite_.clear(); fdCount_.clear(); fdLimit_.clear(); name_.clear(); status_.clear(); filePath_.clear(); commandLine_.clear(); userName_.clear();
+	}
+
+	void reserve(size_t count)
+	{
+		pid_.reserve(count); parentPid_.reserve(count); uid_.reserve(count); cpu_.reserve(count);
+		memory_.reserve(count); threads_.reserve(count); ioRead_.reserve(count); ioWrite_.reserve(count);
+		fdCount_.reserve(count); fdLimit_.reserve(count);
+		name_.reserve(count); status_.reserve(count); filePath_.reserve(count); commandLine_.reserve(count); userName_.reserve(count);
+	}
+
+	void push(const ProcessInfo& process)
+	{
+		pid_.push_back(process.pid);
+		parentPid_.push_back(process.parentPid);
+		uid_.push_back(process.uid);
+		cpu_.push_back(process.cpuUsagePercent);
+		memory_.push_back(process.memoryUsage);
+		threads_.push_back(process.threadCount);
+		ioRead_.push_back(process.ioReadBytesPerSec);
+		ioWrite_.push_back(process.ioWriteBytesPerSec);
+		fdCount_.push_back(process.fdCount);
+		fdLimit_.push_back(process.fdLimit);
+		name_.push_back(strings_.intern(process.name));
+		status_.push_back(strings_.intern(process.status));
+		filePath_.push_back(strings_.intern(process.filePath));
+		commandLine_.push_back(strings_.intern(process.commandLine));
+		userName_.push_back(strings_.intern(process.userName));
+	}
+
+	// Strings of exited processes stay interned until more than half the table is dead, then it is rebuilt
+	void compactStrings()
+	{
+		std::vector<bool> used(strings_.size(), false);
+		size_t usedCount = 0;
+		for (const auto* column : { &name_, &status_, &filePath_, &commandLine_, &userName_ }) {
+			for (uint32_t id : *column) {
+				if (!used[id]) { used[id] = true; ++usedCount; }
+			}
+		}
+		if (strings_.size() <= 256 || usedCount * 2 >= strings_.size()) return;
+
+		StringInterner compacted;
+		std::vector<uint32_t> remap(strings_.size(), 0);
+		for (uint32_t id = 1; id < strings_.size(); ++id) {
+			if (used[id]) remap[id] = compacted.intern(strings_.get(id));
+		}
+		for (auto* column : { &name_, &status_, &filePath_, &commandLine_, &userName_ }) {
+			for (uint32_t& id : *column) id = remap[id];
+		}
+		strings_ = std::move(compacted);
+		++stringGeneration_;
+	}
+};
@@ -0,0 +1,273 @@
+// QuantileSketch: Streaming quantiles with a bounded relative error (DDSketch).
+// Each value is counted in a logarithmic bucket whose width is a fixed fraction of its value, so any quantile
+// reads back within relativeAccuracy of the true sample. The bucket range is fixed up front, which keeps memory
+// constant; sketches built with the same Mapping merge (and un-merge) by adding (subtracting) counts.
+#pragma once
+#include "series_arena.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+class QuantileSketch
+{
+public:
+	struct Mapping
+	{
+		float minValue = 0.1f; // Smaller values, zero and negatives share one bucket and read back as 0
+		float maxValue = 100.0f; // Larger values are counted in the top bucket
+		float relativeAccuracy = 0.01f;
+
+		double logGamma() const { return std::log1p(2.0 * relativeAccuracy / (1.0 - relativeAccuracy)); }
+		int32_t minKey() const { return static_cast<int32_t>(std::ceil(std::log(minValue) / logGamma())); }
+		int32_t maxKey() const { return static_cast<int32_t>(std::ceil(std::log(maxValue) / logGamma())); }
+		// The zero bucket plus one per logarithmic key
+		size_t bucketCount() const { return static_cast<size_t>(maxKey() - minKey()) + 2; }
+	};
+
+	QuantileSketch() = default;
+
+	QuantileSketch(SeriesArena& arena, const Mapping& mapping)
+		: mapping_(mapping), logGamma_(mapping.logGamma()), minKey_(mapping.minKey()),
+		  buckets_(arena.allocate<uint32_t>(mapping.bucketCount()))
+	{
+	}
+
+	static size_t storageBytes(const Mapping& mapping) { return SeriesArena::bytesFor<uint32_t>(mapping.bucketCount()); }
+
+	// Dropped when the sketch has no storage
+	void add(float value, uint32_t count = 1)
+	{
+		if (buckets_.empty()) return;
+		buckets_[bucketOf(value)] += count;
+		count_ += count;
+	}
+
+	// Both sketches must share a Mapping
+	void merge(const QuantileSketch& other)
+	{
+		if (other.buckets_.size() != buckets_.size()) return;
+		for (size_t i = 0; i < buckets_.size(); ++i) buckets_[i] += other.buckets_[i];
+		count_ += other.count_;
+	}
+
+	// Removes a sketch that was merged (or added value by value) into this one earlier
+	void subtract(const QuantileSketch& other)
+	{
+		if (other.buckets_.size() != buckets_.size()) return;
+		for (size_t i = 0; i < buckets_.size(); ++i) buckets_[i] -= other.buckets_[i];
+		count_ -= other.count_;
+	}
+
+	// Value at quantile q in [0, 1]; 0 when empty
+	float quantile(float q) const
+	{
+		float value = 0.0f;
+		quantiles(std::span<const float>(&q, 1), std::span<float>(&value, 1));
+		return value;
+	}
+
+	// Several quantiles in one pass over the buckets; qs must be ascending
+	void quantiles(std::span<const float> qs, std::span<float> out) const
+	{
+		std::fill(out.begin(), out.end(), 0.0f);
+		if (count_ == 0) return;
+		size_t next = 0;
+		uint64_t seen = 0;
+		for (size_t bucket = 0; bucket < buckets_.size() && next < qs.size(); ++bucket) {
+			seen += buckets_[bucket];
+			// Rank is 0-based, as in the DDSketch paper: the sample at q * (count - 1)
+			while (next < qs.size() && static_cast<double>(seen) > std::clamp(static_cast<double>(qs[next]), 0.0, 1.0) * static_cast<double>(count_ - 1)) {
+				out[next++] = valueOf(bucket);
+			}
+		}
+	}
+
+	uint64_t count() const { return count_; }
+	bool empty() const { return count_ == 0; }
+	const Mapping& mapping() const { return mapping_; }
+
+	void clear()
+	{
+		std::fill(buckets_.begin(), buckets_.end(), 0u);
+		count_ = 0;
+	}
+
+private:
+	Mapping mapping_;
+	double logGamma_ = 0.0;
+	int32_t minKey_ = 0;
+	std::span<uint32_t> buckets_; // [0] holds values below minValue, in the arena
+	uint64_t count_ = 0;
+
+	size_t bucketOf(float value) const
+	{
+		if (!(value >= mapping_.minValue)) return 0;
+		double key = std::ceil(std::log(static_cast<double>(value)) / logGamma_);
+		return static_cast<size_t>(std::clamp(key - minKey_ + 1.0, 1.0, static_cast<double>(buckets_.size() - 1)));
+	}
+
+	// The point of the bucket equally far, relatively, from both its edges
+	float valueOf(size_t bucket) const
+	{
+		if (bucket == 0) return 0.0f;
+		double key = static_cast<double>(static_cast<int32_t>(bucket) - 1 + minKey_);
+		double gamma = std::exp(logGamma_);
+		double value = 2.0 * std::exp(key * logGamma_) / (gamma + 1.0);
+		return static_cast<float>(std::min(value, static_cast<double>(mapping_.maxValue)));
+	}
+};
+
+// QuantileWindows: p50, p95 and p99 of one metric over the last minute, the last hour and since start.
+// The sliding windows are rings of sub-window sketches plus their running sum: a sample goes into the current
+// slice and the sum, and a slice that falls out of the window is subtracted again, so nothing is rescanned.
+// The minute slides in 10 s steps and the hour in 5 min steps, so each covers its span less up to one step.
+class QuantileWindows
+{
+public:
+	enum class Window
+	{
+		LastMinute,
+		LastHour,
+		SinceStart
+	};
+
+	struct Percentiles
+	{
+		float p50 = 0.0f;
+		float p95 = 0.0f;
+		float p99 = 0.0f;
+	};
+
+	QuantileWindows() = default;
+
+	static size_t storageBytes(const QuantileSketch::Mapping& mapping)
+	{
+		return (MinuteSlices + 1 + HourSlices + 1 + 1) * QuantileSketch::storageBytes(mapping);
+	}
+
+	void allocate(SeriesArena& arena, const QuantileSketch::Mapping& mapping)
+	{
+		minute_.allocate(arena, mapping, 10'000);
+		hour_.allocate(arena, mapping, 300'000);
+		sinceStart_ = QuantileSketch(arena, mapping);
+		percentiles_ = {};
+	}
+
+	// allocate() that keeps the windows, merging each sketch into its new storage; the old arena has to outlive
+	// this call. Sketches under a different mapping don't merge, so changing it starts the windows over.
+	void reallocate(SeriesArena& arena, const QuantileSketch::Mapping& mapping)
+	{
+		QuantileWindows previous = *this;
+		allocate(arena, mapping);
+		minute_.copyFrom(previous.minute_);
+		hour_.copyFrom(previous.hour_);
+		sinceStart_.merge(previous.sinceStart_);
+		if (!sinceStart_.empty()) percentiles_ = previous.percentiles_;
+	}
+
+	// Times are monotonic milliseconds, as for TieredSeries; the cached percentiles are refreshed on every push
+	void push(uint64_t timeMs, float value)
+	{
+		minute_.push(timeMs, value);
+		hour_.push(timeMs, value);
+		sinceStart_.add(value);
+		for (Window window : { Window::LastMinute, Window::LastHour, Window::SinceStart }) {
+			std::array<float, 3> values{};
+			sketch(window).quantiles(Quantiles, values);
+			percentiles_[static_cast<size_t>(window)] = { values[0], values[1], values[2] };
+		}
+	}
+
+	const Percentiles& percentiles(Window window) const { return percentiles_[static_cast<size_t>(window)]; }
+	float quantile(Window window, float q) const { return sketch(window).quantile(q); }
+	bool empty() const { return sinceStart_.empty(); }
+
+	// Mergeable, so per-core windows can be combined into an all-CPU sketch
+	const QuantileSketch& sketch(Window window) const
+	{
+		switch (window) {
+			case Window::LastMinute: return minute_.total;
+			case Window::LastHour: return hour_.total;
+			default: return sinceStart_;
+		}
+	}
+
+	void clear()
+	{
+		minute_.clear();
+		hour_.clear();
+		sinceStart_.clear();
+		percentiles_ = {};
+	}
+
+private:
+	static constexpr size_t MinuteSlices = 6;
+	static constexpr size_t HourSlices = 12;
+	static constexpr std::array<float, 3> Quantiles = { 0.5f, 0.95f, 0.99f };
+
+	template<size_t Slices>
+	struct Sliding
+	{
+		std::array<QuantileSketch, Slices> slices;
+		QuantileSketch total; // Sum of the live slices
+		uint64_t sliceMs = 0;
+		uint64_t current = 0; // Number of the slice being filled, timeMs / sliceMs
+		size_t head = 0;
+		bool started = false;
+
+		void allocate(SeriesArena& arena, const QuantileSketch::Mapping& mapping, uint64_t ms)
+		{
+			for (auto& slice : slices) slice = QuantileSketch(arena, mapping);
+			total = QuantileSketch(arena, mapping);
+			sliceMs = ms;
+			current = 0;
+			head = 0;
+			started = false;
+		}
+
+		void push(uint64_t timeMs, float value)
+		{
+			if (sliceMs == 0) return;
+			uint64_t slice = timeMs / sliceMs;
+			if (!started) {
+				current = slice;
+				started = true;
+			}
+			// Each slice step retires the oldest slice; a long gap retires them all
+			for (uint64_t steps = std::min<uint64_t>(slice > current ? slice - current : 0, Slices); steps > 0; --steps) {
+				head = (head + 1) % Slices;
+				total.subtract(slices[head]);
+				slices[head].clear();
+			}
+			current = std::max(current, slice);
+			slices[head].add(value);
+			total.add(value);
+		}
+
+		// Takes over other's counts and position; slices come out empty if the mappings differ
+		void copyFrom(const Sliding& other)
+		{
+			for (size_t i = 0; i < Slices; ++i) slices[i].merge(other.slices[i]);
+			total.merge(other.total);
+			current = other.current;
+			head = other.head;
+			started = other.started;
+		}
+
+		void clear()
+		{
+			for (auto& slice : slices) slice.clear();
+			total.clear();
+			head = 0;
+			started = false;
+		}
+	};
+
+	Sliding<MinuteSlices> minute_;
+	Sliding<HourSlices> hour_;
+	QuantileSketch sinceStart_;
+	std::array<Percentiles, 3> percentiles_{};
+};
@@ -1,25 +1,53 @@
-// RingBuffer
+// RingBuffer: Fixed-capacity circular buffer holding the newest N values.
+// N is known at compile time, so storage is rounded up to a power of two and every index is a mask rather than a
+// modulo; histories sized at runtime use HistoryBuffer, which keeps exactly its capacity. The live window is at
+// most two contiguous runs (as_spans()), which lets consumers loop over plain arrays instead of calling get().
 #pragma once
+#include "series_view.hpp"
+#include <algorithm>
+#include <bit>
 #include <cstddef>
+#include <span>
+#include <utility>
 
 template<typename T, size_t N>
 class RingBuffer
 {
+	static_assert(N > 0, "RingBuffer needs a capacity");
+	static constexpr size_t Storage = std::bit_ceil(N);
+	static constexpr size_t Mask = Storage - 1;
+
 public:
+	using const_iterator = typename SeriesView<T>::const_iterator;
+
 	void push(const T& value)
 	{
 		buffer_[head_] = value;
-		head_ = (head_ + 1) % N;
+		head_ = (head_ + 1) & Mask;
 		if (size_ < N) ++size_;
 	}
 
+	// Same result as pushing each value in turn; only the last N can survive, so only those are copied
+	void push_range(std::span<const T> values)
+	{
+		if (values.size() > N) values = values.last(N);
+		size_t first = std::min(values.size(), Storage - head_);
+		std::copy_n(values.begin(), first, buffer_ + head_);
+		std::copy(values.begin() + first, values.end(), buffer_);
+		head_ = (head_ + values.size()) & Mask;
+		size_ = std::min(size_ + values.size(), N);
+	}
+
+	// Oldest first; out of range gives T{}
 	T get(size_t index) const
 	{
 		if (index >= size_) return T{};
-		size_t actualIndex = (head_ + N - size_ + index) % N;
-		return buffer_[actualIndex];
+		return buffer_[(start() + index) & Mask];
 	}
 
+	// Unchecked get()
+	const T& operator[](size_t index) const { return buffer_[(start() + index) & Mask]; }
+
 	size_t size() const { return size_; }
 	size_t capacity() const { return N; }
 	bool empty() const { return size_ == 0; }
@@ -28,9 +56,20 @@ public:
 	T latest() const
 	{
 		if (empty()) return T{};
-		return buffer_[(head_ + N - 1) % N];
+		return buffer_[(head_ + Mask) & Mask];
 	}
 
+	SeriesView<T> view() const { return SeriesView<T>(buffer_, Storage, start(), size_); }
+
+	// The live values, oldest first, as two contiguous runs; the second is empty unless the window wraps
+	std::pair<std::span<const T>, std::span<const T>> as_spans() const { return view().as_spans(); }
+
+	// Copies values from logical index offset onward into out, oldest first; returns how many were copied
+	size_t copy_to(std::span<T> out, size_t offset = 0) const { return view().copy_to(out, offset); }
+
+	const_iterator begin() const { return view().begin(); }
+	const_iterator end() const { return view().end(); }
+
 	void clear()
 	{
 		head_ = 0;
@@ -38,7 +77,9 @@ public:
 	}
 
 private:
-	T buffer_[N];
+	T buffer_[Storage];
 	size_t head_ = 0;
 	size_t size_ = 0;
-};
\ No newline at end of file
+
+	size_t start() const { return (head_ - size_) & Mask; }
+};
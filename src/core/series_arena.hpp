@@ -0,0 +1,54 @@
+// SeriesArena: One allocation made at startup that history storage is carved out of.
+// Sizes are known once retention has been chosen, so the collector adds up storageBytes() of every history,
+// creates the arena and hands out slices; nothing is freed or grown afterwards.
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <type_traits>
+
+class SeriesArena
+{
+public:
+	static constexpr size_t Alignment = alignof(std::max_align_t);
+
+	explicit SeriesArena(size_t bytes)
+		: memory_(new (std::align_val_t(Alignment)) std::byte[bytes]), capacity_(bytes)
+	{
+	}
+
+	~SeriesArena() { ::operator delete[](memory_, std::align_val_t(Alignment)); }
+
+	SeriesArena(const SeriesArena&) = delete;
+	SeriesArena& operator=(const SeriesArena&) = delete;
+
+	// Bytes one allocate<T>(count) takes, padding included
+	template<typename T>
+	static constexpr size_t bytesFor(size_t count)
+	{
+		return (count * sizeof(T) + Alignment - 1) / Alignment * Alignment;
+	}
+
+	// count value-initialized Ts, or an empty span once the arena is used up. Destructors never run, so T has
+	// to be trivially destructible.
+	template<typename T>
+	std::span<T> allocate(size_t count)
+	{
+		static_assert(std::is_trivially_destructible_v<T>, "SeriesArena never runs destructors");
+		static_assert(alignof(T) <= Alignment, "SeriesArena only aligns to max_align_t");
+		size_t bytes = bytesFor<T>(count);
+		if (count == 0 || bytes > capacity_ - used_) return {};
+		T* first = reinterpret_cast<T*>(memory_ + used_);
+		std::uninitialized_value_construct_n(first, count);
+		used_ += bytes;
+		return std::span<T>(first, count);
+	}
+
+	size_t used() const { return used_; }
+	size_t capacity() const { return capacity_; }
+
+private:
+	std::byte* memory_;
+	size_t capacity_;
+	size_t used_ = 0;
+};
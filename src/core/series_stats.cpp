@@ -0,0 +1,280 @@
+#include "series_stats.hpp"
+#include "cpu_features.hpp"
+
+namespace
+{
+	using Summary = SeriesStats::Summary;
+
+	struct Kernels
+	{
+		const char* name;
+		float (*min)(const float*, size_t);
+		float (*max)(const float*, size_t);
+		float (*sum)(const float*, size_t);
+		Summary (*summarize)(const float*, size_t);
+		size_t (*lastAbove)(const float*, size_t, float);
+	};
+
+	// The scalar forms also finish off the tails the vector loops leave behind
+	float MinScalar(const float* data, size_t count)
+	{
+		float result = data[0];
+		for (size_t i = 1; i < count; ++i) result = data[i] < result ? data[i] : result;
+		return result;
+	}
+
+	float MaxScalar(const float* data, size_t count)
+	{
+		float result = data[0];
+		for (size_t i = 1; i < count; ++i) result = data[i] > result ? data[i] : result;
+		return result;
+	}
+
+	float SumScalar(const float* data, size_t count)
+	{
+		float result = 0.0f;
+		for (size_t i = 0; i < count; ++i) result += data[i];
+		return result;
+	}
+
+	Summary SummarizeScalar(const float* data, size_t count)
+	{
+		Summary summary{ data[0], data[0], 0.0f, count };
+		for (size_t i = 0; i < count; ++i) {
+			summary.min = data[i] < summary.min ? data[i] : summary.min;
+			summary.max = data[i] > summary.max ? data[i] : summary.max;
+			summary.sum += data[i];
+		}
+		return summary;
+	}
+
+	size_t LastAboveScalar(const float* data, size_t count, float threshold)
+	{
+		for (size_t i = count; i-- > 0;) {
+			if (data[i] > threshold) return i;
+		}
+		return SeriesStats::npos;
+	}
+
+	unsigned HighestBit(unsigned mask)
+	{
+#ifdef _MSC_VER
+		unsigned long index = 0;
+		_BitScanReverse(&index, mask);
+		return static_cast<unsigned>(index);
+#else
+		return 31u - static_cast<unsigned>(__builtin_clz(mask));
+#endif
+	}
+
+#ifdef PULSE_X86
+	// Horizontal reductions of a 4-lane register
+	float MinLanes(__m128 v)
+	{
+		v = _mm_min_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+		return _mm_cvtss_f32(_mm_min_ss(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1))));
+	}
+
+	float MaxLanes(__m128 v)
+	{
+		v = _mm_max_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+		return _mm_cvtss_f32(_mm_max_ss(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1))));
+	}
+
+	float SumLanes(__m128 v)
+	{
+		v = _mm_add_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+		return _mm_cvtss_f32(_mm_add_ss(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1))));
+	}
+
+	float MinSse2(const float* data, size_t count)
+	{
+		if (count < 4) return MinScalar(data, count);
+		__m128 lanes = _mm_loadu_ps(data);
+		size_t i = 4;
+		for (; i + 4 <= count; i += 4) lanes = _mm_min_ps(lanes, _mm_loadu_ps(data + i));
+		float result = MinLanes(lanes);
+		return i < count ? std::min(result, MinScalar(data + i, count - i)) : result;
+	}
+
+	float MaxSse2(const float* data, size_t count)
+	{
+		if (count < 4) return MaxScalar(data, count);
+		__m128 lanes = _mm_loadu_ps(data);
+		size_t i = 4;
+		for (; i + 4 <= count; i += 4) lanes = _mm_max_ps(lanes, _mm_loadu_ps(data + i));
+		float result = MaxLanes(lanes);
+		return i < count ? std::max(result, MaxScalar(data + i, count - i)) : result;
+	}
+
+	float SumSse2(const float* data, size_t count)
+	{
+		__m128 lanes = _mm_setzero_ps();
+		size_t i = 0;
+		for (; i + 4 <= count; i += 4) lanes = _mm_add_ps(lanes, _mm_loadu_ps(data + i));
+		return SumLanes(lanes) + SumScalar(data + i, count - i);
+	}
+
+	Summary SummarizeSse2(const float* data, size_t count)
+	{
+		if (count < 4) return SummarizeScalar(data, count);
+		__m128 first = _mm_loadu_ps(data);
+		__m128 minLanes = first, maxLanes = first, sumLanes = first;
+		size_t i = 4;
+		for (; i + 4 <= count; i += 4) {
+			__m128 v = _mm_loadu_ps(data + i);
+			minLanes = _mm_min_ps(minLanes, v);
+			maxLanes = _mm_max_ps(maxLanes, v);
+			sumLanes = _mm_add_ps(sumLanes, v);
+		}
+		Summary summary{ MinLanes(minLanes), MaxLanes(maxLanes), SumLanes(sumLanes), i };
+		return i < count ? SeriesStats::Merge(summary, SummarizeScalar(data + i, count - i)) : summary;
+	}
+
+	size_t LastAboveSse2(const float* data, size_t count, float threshold)
+	{
+		const __m128 limit = _mm_set1_ps(threshold);
+		size_t end = count;
+		for (; end >= 4; end -= 4) {
+			unsigned mask = static_cast<unsigned>(_mm_movemask_ps(_mm_cmpgt_ps(_mm_loadu_ps(data + end - 4), limit)));
+			if (mask != 0) return end - 4 + HighestBit(mask);
+		}
+		return LastAboveScalar(data, end, threshold);
+	}
+
+	PULSE_TARGET_AVX2 __m128 FoldMin(__m256 v) { return _mm_min_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1)); }
+	PULSE_TARGET_AVX2 __m128 FoldMax(__m256 v) { return _mm_max_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1)); }
+	PULSE_TARGET_AVX2 __m128 FoldSum(__m256 v) { return _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1)); }
+
+	PULSE_TARGET_AVX2 float MinAvx2(const float* data, size_t count)
+	{
+		if (count < 8) return MinSse2(data, count);
+		__m256 lanes = _mm256_loadu_ps(data);
+		size_t i = 8;
+		for (; i + 8 <= count; i += 8) lanes = _mm256_min_ps(lanes, _mm256_loadu_ps(data + i));
+		float result = MinLanes(FoldMin(lanes));
+		return i < count ? std::min(result, MinScalar(data + i, count - i)) : result;
+	}
+
+	PULSE_TARGET_AVX2 float MaxAvx2(const float* data, size_t count)
+	{
+		if (count < 8) return MaxSse2(data, count);
+		__m256 lanes = _mm256_loadu_ps(data);
+		size_t i = 8;
+		for (; i + 8 <= count; i += 8) lanes = _mm256_max_ps(lanes, _mm256_loadu_ps(data + i));
+		float result = MaxLanes(FoldMax(lanes));
+		return i < count ? std::max(result, MaxScalar(data + i, count - i)) : result;
+	}
+
+	PULSE_TARGET_AVX2 float SumAvx2(const float* data, size_t count)
+	{
+		__m256 lanes = _mm256_setzero_ps();
+		size_t i = 0;
+		for (; i + 8 <= count; i += 8) lanes = _mm256_add_ps(lanes, _mm256_loadu_ps(data + i));
+		return SumLanes(FoldSum(lanes)) + SumScalar(data + i, count - i);
+	}
+
+	PULSE_TARGET_AVX2 Summary SummarizeAvx2(const float* data, size_t count)
+	{
+		if (count < 8) return SummarizeSse2(data, count);
+		__m256 first = _mm256_loadu_ps(data);
+		__m256 minLanes = first, maxLanes = first, sumLanes = first;
+		size_t i = 8;
+		for (; i + 8 <= count; i += 8) {
+			__m256 v = _mm256_loadu_ps(data + i);
+			minLanes = _mm256_min_ps(minLanes, v);
+			maxLanes = _mm256_max_ps(maxLanes, v);
+			sumLanes = _mm256_add_ps(sumLanes, v);
+		}
+		Summary summary{ MinLanes(FoldMin(minLanes)), MaxLanes(FoldMax(maxLanes)), SumLanes(FoldSum(sumLanes)), i };
+		return i < count ? SeriesStats::Merge(summary, SummarizeScalar(data + i, count - i)) : summary;
+	}
+
+	PULSE_TARGET_AVX2 size_t LastAboveAvx2(const float* data, size_t count, float threshold)
+	{
+		const __m256 limit = _mm256_set1_ps(threshold);
+		size_t end = count;
+		for (; end >= 8; end -= 8) {
+			unsigned mask = static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(data + end - 8), limit, _CMP_GT_OQ)));
+			if (mask != 0) return end - 8 + HighestBit(mask);
+		}
+		// GCC turns this into a tail jump without its usual vzeroupper, and SSE code after dirty upper halves
+		// runs several times slower
+		_mm256_zeroupper();
+		return LastAboveSse2(data, end, threshold);
+	}
+#endif
+
+	// null when this CPU or build can't run the kernel
+	const Kernels* Lookup(SeriesStats::Kernel kernel)
+	{
+		static const Kernels scalar{ "scalar", MinScalar, MaxScalar, SumScalar, SummarizeScalar, LastAboveScalar };
+#ifdef PULSE_X86
+		static const Kernels avx2{ "AVX2", MinAvx2, MaxAvx2, SumAvx2, SummarizeAvx2, LastAboveAvx2 };
+		static const Kernels sse2{ "SSE2", MinSse2, MaxSse2, SumSse2, SummarizeSse2, LastAboveSse2 };
+		static const bool hasAvx2 = CpuFeatures::HasAvx2();
+		switch (kernel) {
+			case SeriesStats::Kernel::Scalar: return &scalar;
+			case SeriesStats::Kernel::Sse2: return &sse2;
+			case SeriesStats::Kernel::Avx2: return hasAvx2 ? &avx2 : nullptr;
+			default: return hasAvx2 ? &avx2 : &sse2;
+		}
+#else
+		return kernel == SeriesStats::Kernel::Best || kernel == SeriesStats::Kernel::Scalar ? &scalar : nullptr;
+#endif
+	}
+
+	const Kernels*& Selected()
+	{
+		static const Kernels* selected = Lookup(SeriesStats::Kernel::Best);
+		return selected;
+	}
+
+	const Kernels& Active()
+	{
+		return *Selected();
+	}
+}
+
+float SeriesStats::Min(std::span<const float> values)
+{
+	return values.empty() ? 0.0f : Active().min(values.data(), values.size());
+}
+
+float SeriesStats::Max(std::span<const float> values)
+{
+	return values.empty() ? 0.0f : Active().max(values.data(), values.size());
+}
+
+float SeriesStats::Sum(std::span<const float> values)
+{
+	return Active().sum(values.data(), values.size());
+}
+
+float SeriesStats::Mean(std::span<const float> values)
+{
+	return values.empty() ? 0.0f : Sum(values) / static_cast<float>(values.size());
+}
+
+SeriesStats::Summary SeriesStats::Summarize(std::span<const float> values)
+{
+	return values.empty() ? Summary{} : Active().summarize(values.data(), values.size());
+}
+
+size_t SeriesStats::LastAbove(std::span<const float> values, float threshold)
+{
+	return Active().lastAbove(values.data(), values.size(), threshold);
+}
+
+const char* SeriesStats::KernelName()
+{
+	return Active().name;
+}
+
+bool SeriesStats::UseKernel(Kernel kernel)
+{
+	const Kernels* kernels = Lookup(kernel);
+	if (!kernels) return false;
+	Selected() = kernels;
+	return true;
+}
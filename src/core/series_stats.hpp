@@ -0,0 +1,92 @@
+// SeriesStats: Min, max, sum, mean and threshold searches over float histories.
+// The loops run on SSE2 or AVX2 (picked once from the CPU's features) with a scalar fallback elsewhere, and
+// take spans, so a ring history is handled as its two contiguous runs rather than element by element.
+#pragma once
+#include "series_view.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+
+class SeriesStats
+{
+public:
+	static constexpr size_t npos = SIZE_MAX;
+
+	struct Summary
+	{
+		float min = 0.0f;
+		float max = 0.0f;
+		float sum = 0.0f;
+		size_t count = 0;
+
+		float mean() const { return count > 0 ? sum / static_cast<float>(count) : 0.0f; }
+	};
+
+	// Empty input gives 0 (and a Summary with count 0). Sums accumulate in float lanes, so the last bits can
+	// differ from a sequential sum.
+	static float Min(std::span<const float> values);
+	static float Max(std::span<const float> values);
+	static float Sum(std::span<const float> values);
+	static float Mean(std::span<const float> values);
+
+	// min, max and sum in one pass over the data
+	static Summary Summarize(std::span<const float> values);
+
+	// Index of the newest value strictly above threshold, or npos
+	static size_t LastAbove(std::span<const float> values, float threshold);
+
+	// "AVX2", "SSE2" or "scalar"
+	static const char* KernelName();
+
+	// Forces one kernel set, for benchmarks and tests; Best is what the CPU picks by default. false (and no
+	// change) if this CPU or build can't run it. Not synchronized: call it before other threads use SeriesStats.
+	enum class Kernel
+	{
+		Best,
+		Scalar,
+		Sse2,
+		Avx2
+	};
+	static bool UseKernel(Kernel kernel);
+
+	// SeriesView forms (RingBuffer, HistoryBuffer), over the values from logical index `from` (0 = oldest) to
+	// the newest
+	static Summary Summarize(SeriesView<float> series, size_t from = 0)
+	{
+		auto [older, newer] = series.subview(from).as_spans();
+		return Merge(Summarize(older), Summarize(newer));
+	}
+
+	static float Max(SeriesView<float> series, size_t from = 0)
+	{
+		auto [older, newer] = series.subview(from).as_spans();
+		if (older.empty() || newer.empty()) return Max(older.empty() ? newer : older);
+		return std::max(Max(older), Max(newer));
+	}
+
+	static float Min(SeriesView<float> series, size_t from = 0)
+	{
+		auto [older, newer] = series.subview(from).as_spans();
+		if (older.empty() || newer.empty()) return Min(older.empty() ? newer : older);
+		return std::min(Min(older), Min(newer));
+	}
+
+	// Logical index into the series, or npos
+	static size_t LastAbove(SeriesView<float> series, float threshold, size_t from = 0)
+	{
+		auto [older, newer] = series.subview(from).as_spans();
+		size_t hit = LastAbove(newer, threshold);
+		if (hit != npos) return series.size() - newer.size() + hit;
+		hit = LastAbove(older, threshold);
+		return hit != npos ? series.size() - newer.size() - older.size() + hit : npos;
+	}
+
+	static Summary Merge(const Summary& a, const Summary& b)
+	{
+		if (a.count == 0) return b;
+		if (b.count == 0) return a;
+		return { std::min(a.min, b.min), std::max(a.max, b.max), a.sum + b.sum, a.count + b.count };
+	}
+};
@@ -0,0 +1,132 @@
+// SeriesView: Non-owning, read-only window onto a history, oldest value first.
+// It covers a ring or a plain contiguous array, so RingBuffer, HistoryBuffer and spans can all be passed to the
+// same drawing and statistics code without copying. A ring of power-of-two storage (RingBuffer) is indexed by
+// mask; one of any other size (a HistoryBuffer sized at runtime) wraps an index past the end with one compare.
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <span>
+#include <utility>
+
+template<typename T>
+class SeriesView
+{
+public:
+	class const_iterator
+	{
+	public:
+		using iterator_category = std::random_access_iterator_tag;
+		using value_type = T;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const T*;
+		using reference = const T&;
+
+		const_iterator() = default;
+
+		reference operator*() const { return data_[Slot(start_ + static_cast<size_t>(index_), storage_, mask_)]; }
+		pointer operator->() const { return &**this; }
+		reference operator[](difference_type n) const { return *(*this + n); }
+
+		const_iterator& operator++() { ++index_; return *this; }
+		const_iterator operator++(int) { const_iterator old = *this; ++index_; return old; }
+		const_iterator& operator--() { --index_; return *this; }
+		const_iterator operator--(int) { const_iterator old = *this; --index_; return old; }
+		const_iterator& operator+=(difference_type n) { index_ += n; return *this; }
+		const_iterator& operator-=(difference_type n) { index_ -= n; return *this; }
+		friend const_iterator operator+(const_iterator it, difference_type n) { return it += n; }
+		friend const_iterator operator+(difference_type n, const_iterator it) { return it += n; }
+		friend const_iterator operator-(const_iterator it, difference_type n) { return it -= n; }
+		friend difference_type operator-(const const_iterator& a, const const_iterator& b) { return a.index_ - b.index_; }
+
+		bool operator==(const const_iterator& other) const { return index_ == other.index_; }
+		auto operator<=>(const const_iterator& other) const { return index_ <=> other.index_; }
+
+	private:
+		friend class SeriesView;
+		const_iterator(const T* data, size_t storage, size_t mask, size_t start, difference_type index)
+			: data_(data), storage_(storage), mask_(mask), start_(start), index_(index) {}
+
+		const T* data_ = nullptr;
+		size_t storage_ = 0;
+		size_t mask_ = 0;
+		size_t start_ = 0;
+		difference_type index_ = 0; // Logical position, 0 being the oldest value
+	};
+
+	SeriesView() = default;
+
+	// A ring: storage holds storageSize slots and the window starts at slot `start`
+	SeriesView(const T* storage, size_t storageSize, size_t start, size_t size)
+		: data_(storage), storage_(storageSize), mask_(MaskFor(storageSize)), start_(storageSize > 0 ? start % storageSize : 0),
+		  size_(size) {}
+
+	// A contiguous array: the window starts at slot 0 and fills the storage, so indexing never wraps
+	SeriesView(std::span<const T> values)
+		: data_(values.data()), storage_(values.size()), size_(values.size()) {}
+
+	// Anything that can hand out a view of itself (RingBuffer, HistoryBuffer)
+	template<typename Series>
+		requires requires(const Series& series) { { series.view() } -> std::same_as<SeriesView<T>>; }
+	SeriesView(const Series& series) : SeriesView(series.view()) {}
+
+	size_t size() const { return size_; }
+	bool empty() const { return size_ == 0; }
+
+	// Unchecked; get() gives T{} out of range
+	const T& operator[](size_t index) const { return data_[Slot(start_ + index, storage_, mask_)]; }
+	T get(size_t index) const { return index < size_ ? (*this)[index] : T{}; }
+	T latest() const { return size_ > 0 ? (*this)[size_ - 1] : T{}; }
+
+	// The values as two contiguous runs; the second is empty unless the window wraps
+	std::pair<std::span<const T>, std::span<const T>> as_spans() const
+	{
+		if (size_ == 0) return {};
+		size_t first = std::min(size_, storage_ - start_);
+		return { std::span<const T>(data_ + start_, first), std::span<const T>(data_, size_ - first) };
+	}
+
+	// Copies values from logical index offset onward into out; returns how many were copied
+	size_t copy_to(std::span<T> out, size_t offset = 0) const
+	{
+		if (offset >= size_) return 0;
+		auto [older, newer] = subview(offset).as_spans();
+		size_t count = std::min(out.size(), size_ - offset);
+		size_t first = std::min(count, older.size());
+		std::copy_n(older.begin(), first, out.begin());
+		std::copy_n(newer.begin(), count - first, out.begin() + first);
+		return count;
+	}
+
+	// The values from logical index offset onward, and the newest count values
+	SeriesView subview(size_t offset) const
+	{
+		offset = std::min(offset, size_);
+		SeriesView view = *this;
+		view.start_ = Slot(start_ + offset, storage_, mask_);
+		view.size_ = size_ - offset;
+		return view;
+	}
+
+	SeriesView last(size_t count) const { return subview(size_ - std::min(count, size_)); }
+
+	const_iterator begin() const { return const_iterator(data_, storage_, mask_, start_, 0); }
+	const_iterator end() const { return const_iterator(data_, storage_, mask_, start_, static_cast<std::ptrdiff_t>(size_)); }
+
+	// A slot past the end of storage comes round to the front; slot is always below twice the storage size
+	static size_t Wrap(size_t slot, size_t storage) { return slot >= storage ? slot - storage : slot; }
+
+private:
+	const T* data_ = nullptr;
+	size_t storage_ = 0;
+	size_t mask_ = 0; // storage_ - 1 for power-of-two storage, else 0 and slots wrap by compare
+	size_t start_ = 0;
+	size_t size_ = 0;
+
+	static constexpr size_t MaskFor(size_t storage) { return storage > 1 && std::has_single_bit(storage) ? storage - 1 : 0; }
+	static size_t Slot(size_t slot, size_t storage, size_t mask) { return mask != 0 ? slot & mask : Wrap(slot, storage); }
+};
@@ -0,0 +1,69 @@
+// StringInterner: Deduplicating string table; each distinct string is stored once and referenced by a 32-bit id.
+// Id 0 is always the empty string.
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+class StringInterner
+{
+public:
+	StringInterner() { clear(); }
+
+	StringInterner(StringInterner&&) = default;
+	StringInterner& operator=(StringInterner&&) = default;
+	StringInterner(const StringInterner& other) { *this = other; }
+	StringInterner& operator=(const StringInterner& other)
+	{
+		// ids_ holds views into strings_, so it has to be rebuilt against the new copies
+		if (this != &other) {
+			clear();
+			for (size_t i = 1; i < other.strings_.size(); ++i) intern(other.strings_[i]);
+		}
+		return *this;
+	}
+
+	uint32_t intern(std::string_view text)
+	{
+		auto it = ids_.find(text);
+		if (it != ids_.end()) return it->second;
+
+		uint32_t id = static_cast<uint32_t>(strings_.size());
+		strings_.emplace_back(text);
+		ids_.emplace(strings_.back(), id); // deque never moves existing elements, so the view stays valid
+		return id;
+	}
+
+	const std::string& get(uint32_t id) const
+	{
+		return id < strings_.size() ? strings_[id] : strings_[0];
+	}
+
+	size_t size() const { return strings_.size(); }
+
+	void clear()
+	{
+		ids_.clear();
+		strings_.clear();
+		strings_.emplace_back();
+		ids_.emplace(strings_.back(), 0);
+	}
+
+	// Approximate heap use: string headers, out-of-line characters and the lookup table
+	size_t memoryBytes() const
+	{
+		size_t bytes = strings_.size() * sizeof(std::string);
+		for (const auto& text : strings_) {
+			if (text.capacity() > std::string().capacity()) bytes += text.capacity() + 1;
+		}
+		bytes += ids_.size() * (sizeof(std::string_view) + sizeof(uint32_t) + 2 * sizeof(void*));
+		bytes += ids_.bucket_count() * sizeof(void*);
+		return bytes;
+	}
+
+private:
+	std::deque<std::string> strings_;
+	std::unordered_map<std::string_view, uint32_t> ids_;
+};
@@ -1,22 +1,25 @@
 #pragma once
+#include "alert_expression.hpp"
+#include "alert_state.hpp"
+#include "compressed_series.hpp"
+#include "process_store.hpp"
+#include "quantile_sketch.hpp"
 #include "ring_buffer.hpp"
+#include "tiered_series.hpp"
 #include <string>
 #include <vector>
 #include <cstdint>
 
-struct ProcessInfo
+struct UserUsage
 {
-	uint32_t pid = 0;
+	uint32_t uid = 0;
 	std::string name;
-	uint64_t memoryUsage = 0;
-	float cpuUsagePercent = 0.0f;
-	std::string status = "Running";
+	uint32_t processCount = 0;
 	uint32_t threadCount = 0;
-	std::string filePath;
-	
-	ProcessInfo() = default;
-	ProcessInfo(uint32_t p, const std::string& n, uint64_t mem, float cpu) 
-		: pid(p), name(n), memoryUsage(mem), cpuUsagePercent(cpu) {}
+	float cpuUsagePercent = 0.0f;
+	uint64_t memoryBytes = 0;
+	uint64_t ioReadBytesPerSec = 0;
+	uint64_t ioWriteBytesPerSec = 0;
 };
 
 struct NetworkInterface
@@ -35,6 +38,7 @@ struct NetworkInterface
 
 struct NetworkStats
 {
+	// Sums of the interfaces' own cumulative counters, so they drop when an interface goes away
 	uint64_t totalBytesReceived = 0;
 	uint64_t totalBytesSent = 0;
 	uint32_t activeConnections = 0;
@@ -42,22 +46,59 @@ struct NetworkStats
 	std::vector<NetworkInterface> interfaces;
 };
 
+// TCP/IP stack counters from /proc/net/snmp, /proc/net/netstat and /proc/net/sockstat (Linux only)
+struct NetworkHealth
+{
+	bool isAvailable = false;
+
+	// Per-second rates
+	float tcpRetransPerSec = 0.0f;
+	float tcpRetransPercent = 0.0f; // Retransmitted share of outgoing segments
+	float tcpInErrorsPerSec = 0.0f;
+	float listenOverflowsPerSec = 0.0f;
+	float listenDropsPerSec = 0.0f;
+	float synCookiesSentPerSec = 0.0f;
+	float outOfOrderPerSec = 0.0f;
+	float udpRcvbufErrorsPerSec = 0.0f;
+	float udpInErrorsPerSec = 0.0f;
+
+	// Socket gauges
+	uint32_t tcpInUse = 0;
+	uint32_t tcpTimeWait = 0;
+	uint32_t tcpOrphans = 0;
+	uint32_t udpInUse = 0;
+	uint64_t tcpMemoryBytes = 0;
+	uint64_t udpMemoryBytes = 0;
+
+	RingBuffer<float, 300> retransHistory;
+	RingBuffer<float, 300> listenOverflowHistory;
+	RingBuffer<float, 300> listenDropHistory;
+	RingBuffer<float, 300> synCookieHistory;
+	RingBuffer<float, 300> outOfOrderHistory;
+	RingBuffer<float, 300> udpRcvbufErrorHistory;
+	RingBuffer<float, 300> socketMemoryHistory;
+};
+
 struct AlertRule
 {
-	enum Type { CPU_USAGE, MEMORY_USAGE, DISK_USAGE, NETWORK_USAGE, PROCESS_COUNT };
-	
+	enum Type { CPU_USAGE, MEMORY_USAGE, DISK_USAGE, NETWORK_USAGE, PROCESS_COUNT, FD_HEADROOM, ANOMALY, EXPRESSION }; // ANOMALY alerts come from AnomalyMonitor, not rules
+
 	Type type;
-	float threshold = 80.0f;
-	uint32_t durationSeconds = 60; // How long the condition must persist
+	float threshold = 80.0f; // Above this the rule is pending
+	float clearThreshold = 70.0f; // A firing rule clears once the value is back at or below this
+	uint32_t durationSeconds = 60; // How long the value must stay above threshold before the rule fires
 	bool isEnabled = true;
 	std::string message;
 	uint32_t triggeredCount = 0;
 	uint64_t lastTriggeredTime = 0;
+	AlertState state;
+	AlertExpression expression; // EXPRESSION rules: 1 while the condition holds, 0 otherwise, against a 0.5 threshold; percentile conditions are written as p95(cpu, 1h) > 90
 };
 
 struct SystemAlert
 {
 	AlertRule::Type type;
+	int32_t ruleIndex = -1; // Index into SystemState::alertRules of the rule that raised it; -1 for anomalies
 	std::string title;
 	std::string message;
 	float currentValue = 0.0f;
@@ -67,6 +108,196 @@ struct SystemAlert
 	uint32_t severity = 1; // 1=Info, 2=Warning, 3=Critical
 };
 
+struct FilesystemInfo
+{
+	std::string mountPoint;
+	std::string device;
+	std::string fsType;
+	bool isNetwork = false;
+	bool hasData = false;  // At least one statvfs has completed
+	bool isStale = false;  // The last statvfs timed out; values are from the previous successful call
+
+	uint64_t totalBytes = 0;
+	uint64_t usedBytes = 0;
+	uint64_t freeBytes = 0; // Available to unprivileged users
+	uint64_t totalInodes = 0;
+	uint64_t usedInodes = 0;
+	uint64_t freeInodes = 0;
+	float usagePercent = 0.0f;
+	float inodeUsagePercent = 0.0f;
+	uint64_t lastUpdateTime = 0;
+
+	RingBuffer<float, 300> usageHistory;
+	RingBuffer<float, 300> inodeHistory;
+};
+
+struct SensorReading
+{
+	std::string chip;   // hwmon driver name, e.g. "coretemp", "nct6775"
+	std::string label;  // "Package id 0", "fan2", ...
+	float value = 0.0f; // Celsius for temperatures, RPM for fans
+	float critical = 0.0f; // Critical threshold if the driver exposes one, otherwise 0
+	RingBuffer<float, 300> history;
+};
+
+struct CpuFrequency
+{
+	uint32_t cpu = 0;
+	float currentMHz = 0.0f;
+	float maxMHz = 0.0f;
+	uint64_t throttleCount = 0;      // Cumulative core_throttle_count (Intel only)
+	float throttlesPerSec = 0.0f;
+	RingBuffer<float, 300> frequencyHistory;
+	RingBuffer<float, 300> throttleHistory;
+};
+
+struct SensorStats
+{
+	bool isAvailable = false; // False on VMs and machines without hwmon/cpufreq drivers
+	std::vector<SensorReading> temperatures;
+	std::vector<SensorReading> fans;
+	std::vector<CpuFrequency> cpuFrequencies;
+};
+
+struct PowerDomain
+{
+	enum Type { PACKAGE, CORE, UNCORE, DRAM, PLATFORM, OTHER };
+
+	std::string name; // powercap zone name, e.g. "package-0", "dram"
+	Type type = OTHER;
+	float watts = 0.0f;
+};
+
+struct PowerStats
+{
+	bool isAvailable = false;
+	std::vector<PowerDomain> domains;
+
+	// Summed across sockets
+	float packageWatts = 0.0f;
+	float coreWatts = 0.0f;
+	float dramWatts = 0.0f;
+
+	// Package energy per second of busy CPU time; lower means more work per joule
+	float joulesPerCpuSecond = 0.0f;
+
+	RingBuffer<float, 300> packageHistory;
+	RingBuffer<float, 300> coreHistory;
+	RingBuffer<float, 300> dramHistory;
+	RingBuffer<float, 300> efficiencyHistory;
+};
+
+struct GpuEngine
+{
+	std::string name; // DRM engine class, e.g. "render", "video", "copy", "compute"
+	float utilizationPercent = 0.0f;
+	RingBuffer<float, 300> history;
+};
+
+struct GpuProcess
+{
+	uint32_t pid = 0;
+	std::string name;
+	float utilizationPercent = 0.0f; // Busiest engine for this process
+	uint64_t memoryBytes = 0;
+};
+
+struct GpuStats
+{
+	bool isAvailable = false; // No DRM device at all; the UI says so rather than showing 0%
+	std::string driver;
+	std::vector<GpuEngine> engines;
+	std::vector<GpuProcess> processes; // Clients with GPU activity or memory, busiest first
+};
+
+struct NumaNode
+{
+	uint32_t id = 0;
+	std::vector<uint32_t> cpus;
+
+	// Memory local to this node
+	uint64_t memoryTotal = 0;
+	uint64_t memoryUsed = 0;
+	float memoryUsagePercent = 0.0f;
+
+	// Utilization of the CPUs attached to this node
+	float cpuUsagePercent = 0.0f;
+
+	// numastat counters (pages) and their per-second rates
+	uint64_t numaHit = 0;
+	uint64_t numaMiss = 0;
+	uint64_t otherNode = 0;
+	float numaHitPerSec = 0.0f;
+	float numaMissPerSec = 0.0f;
+	float otherNodePerSec = 0.0f;
+
+	RingBuffer<float, 300> cpuHistory;
+	RingBuffer<float, 300> memoryHistory;
+	RingBuffer<float, 300> numaHitHistory;
+	RingBuffer<float, 300> numaMissHistory;
+	RingBuffer<float, 300> otherNodeHistory;
+};
+
+struct NumaProcessPlacement
+{
+	uint32_t pid = 0;
+	bool isValid = false;
+	std::vector<uint64_t> nodeBytes; // Indexed like NumaStats::nodes
+	uint64_t totalBytes = 0;
+	uint64_t lastUpdateTime = 0;
+};
+
+// Open descriptors of one process by kind
+struct ProcessFdBreakdown
+{
+	uint32_t pid = 0;
+	std::string name;
+	uint64_t softLimit = 0;
+	uint32_t total = 0;
+	uint32_t sockets = 0;
+	uint32_t pipes = 0;
+	uint32_t files = 0;
+	uint32_t other = 0; // eventfd, epoll, inotify and other anonymous inodes
+};
+
+struct FdStats
+{
+	bool isAvailable = false;
+	float maxUsagePercent = 0.0f; // Highest open-fds / soft-limit share of any process, for FD_HEADROOM alerts
+	uint32_t maxUsagePid = 0;
+	std::string maxUsageName;
+	std::vector<ProcessFdBreakdown> top; // Processes nearest their limit; refreshed less often than the counts
+	uint64_t lastBreakdownTime = 0;
+};
+
+struct NumaStats
+{
+	bool isAvailable = false;
+	std::vector<NumaNode> nodes;
+	NumaProcessPlacement selectedProcess;
+};
+
+// CPU and memory of the selected process since it was picked, every sample kept. Gorilla packing makes a 1 Hz
+// sample cost 1-5 bytes, so the fixed block budget holds about 4 hours of a busy process and 14 of an idle one.
+struct ProcessHistory
+{
+	static constexpr size_t MaxBlocks = 64; // Per series, BlockBytes each
+
+	uint32_t pid = 0; // 0 while nothing is selected
+	CompressedSeries cpu{ MaxBlocks }; // Percent; times are monotonic milliseconds
+	CompressedSeries memory{ MaxBlocks }; // Bytes
+};
+
+// Raw samples kept per TieredSeries history, at ~1 Hz; chosen at startup and carved from one arena
+struct HistoryRetention
+{
+	size_t cpu = TieredSeries::DefaultRawCapacity;
+	size_t memory = TieredSeries::DefaultRawCapacity;
+	size_t gpu = TieredSeries::DefaultRawCapacity;
+	size_t disk = TieredSeries::DefaultRawCapacity;
+	size_t network = TieredSeries::DefaultRawCapacity; // Utilization, upload and download each
+};
+
 struct SystemState
 {
 	// Basic system info
@@ -77,44 +308,70 @@ struct SystemState
 
 	// CPU metrics
 	float cpuUsagePercent = 0.0f;
-	RingBuffer<float, 300> cpuHistory;
+	TieredSeries cpuHistory; // Raw window per HistoryRetention, then 10 s and 1 min rollups; graphs draw cpuHistory.raw()
+	QuantileWindows cpuQuantiles; // p50/p95/p99 over the last minute, the last hour and since start
 
 	// Memory metrics
 	uint64_t totalRAMBytes = 0;
 	uint64_t usedRAMBytes = 0;
 	float memoryUsagePercent = 0.0f;
-	RingBuffer<float, 300> memoryHistory;
+	TieredSeries memoryHistory;
+	QuantileWindows memoryQuantiles;
 
 	// GPU metrics
 	float gpuUsagePercent = 0.0f;
-	RingBuffer<float, 300> gpuHistory;
+	TieredSeries gpuHistory;
+	QuantileWindows gpuQuantiles;
 	std::string gpuName = "Unknown GPU";
 	uint64_t gpuMemoryUsed = 0;
 	uint64_t gpuMemoryTotal = 0;
+	GpuStats gpu; // Per-engine and per-process breakdown where the platform provides it
 
 	// Disk I/O metrics
-	float diskUsagePercent = 0.0f;
+	float diskUsagePercent = 0.0f; // Busy time ("% Disk Time"), not capacity - see filesystems
 	uint64_t diskReadBytesPerSec = 0;
 	uint64_t diskWriteBytesPerSec = 0;
-	RingBuffer<float, 300> diskHistory;
+	TieredSeries diskHistory;
+	QuantileWindows diskQuantiles;
 	std::string primaryDiskName = "System Drive";
 
+	// Filesystem capacity per mount (Linux only), refreshed at a slow cadence
+	std::vector<FilesystemInfo> filesystems;
+
 	// Network metrics
 	float networkUsagePercent = 0.0f;
 	uint64_t uploadBytesPerSec = 0;
 	uint64_t downloadBytesPerSec = 0;
-	RingBuffer<float, 300> networkHistory;
-	RingBuffer<uint64_t, 300> uploadHistory;
-	RingBuffer<uint64_t, 300> downloadHistory;
+	TieredSeries networkHistory;
+	TieredSeries uploadHistory; // Bytes per second
+	TieredSeries downloadHistory;
+	QuantileWindows networkQuantiles;
+	QuantileWindows uploadQuantiles; // Bytes per second
+	QuantileWindows downloadQuantiles;
 	std::string primaryNetworkInterface = "Ethernet";
 
 	// Process information
-	std::vector<ProcessInfo> processes;
+	ProcessStore processes;
 	uint32_t totalProcesses = 0;
 	uint32_t totalThreads = 0;
+	std::vector<UserUsage> users; // Per-owner totals of the process list, heaviest CPU first
+	ProcessHistory selectedProcessHistory;
 
 	// Network details
 	NetworkStats networkStats;
+	NetworkHealth networkHealth;
+
+	// Temperatures, fans and CPU frequency (Linux only)
+	SensorStats sensors;
+
+	// RAPL power draw (Linux only)
+	PowerStats power;
+
+	// NUMA topology (Linux only)
+	NumaStats numa;
+
+	// File descriptor usage against per-process limits (Linux only)
+	FdStats fds;
 
 	// Alert system
 	std::vector<AlertRule> alertRules;
@@ -0,0 +1,301 @@
+// TieredSeries: Multi-resolution history for one metric sampled at ~1 Hz.
+// Raw samples cover a retention chosen at startup (5 minutes by default), 10 s min/max/avg rollups the last
+// 6 hours and 1 min rollups the last 2 days. Rollups are folded in as samples arrive, so a query only copies out
+// points. All storage is carved from a SeriesArena by allocate(); until then the series holds nothing.
+// Times are milliseconds on a monotonic clock, kept per raw sample so late or missed ticks stay visible.
+#pragma once
+#include "history_buffer.hpp"
+#include "series_arena.hpp"
+#include "series_stats.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+class TieredSeries
+{
+public:
+	static constexpr size_t DefaultRawCapacity = 300;
+
+	enum class Tier
+	{
+		Raw,
+		TenSeconds,
+		OneMinute
+	};
+
+	// One point of a query; raw samples have min == max == avg
+	struct Point
+	{
+		uint64_t time = 0; // Milliseconds; for rollups, the start of the bucket
+		float min = 0.0f;
+		float max = 0.0f;
+		float avg = 0.0f;
+	};
+
+	TieredSeries() = default;
+
+	// Arena bytes allocate() takes for a raw window of rawCapacity samples
+	static constexpr size_t storageBytes(size_t rawCapacity)
+	{
+		size_t bytes = HistoryBuffer<float>::storageBytes(rawCapacity) + HistoryBuffer<uint64_t>::storageBytes(rawCapacity);
+		for (size_t capacity : RollupCapacities) bytes += SeriesArena::bytesFor<Bucket>(capacity);
+		return bytes;
+	}
+
+	// Takes the series' storage from the arena and empties it; false (and no storage) if the arena is too small
+	bool allocate(SeriesArena& arena, size_t rawCapacity = DefaultRawCapacity)
+	{
+		if (arena.capacity() - arena.used() < storageBytes(rawCapacity)) return false;
+		raw_ = HistoryBuffer<float>(arena, rawCapacity);
+		rawTimes_ = HistoryBuffer<uint64_t>(arena, rawCapacity);
+		for (size_t t = 0; t < rollups_.size(); ++t) {
+			rollups_[t] = Rollup{};
+			rollups_[t].resolution = RollupResolutions[t] * 1000ull;
+			rollups_[t].buckets = arena.allocate<Bucket>(RollupCapacities[t]);
+		}
+		return true;
+	}
+
+	// allocate() that keeps the data: the newest rawCapacity samples and every rollup are copied onto the new
+	// storage, so the old arena has to outlive this call. False (and an empty series) if the arena is too small.
+	bool reallocate(SeriesArena& arena, size_t rawCapacity = DefaultRawCapacity)
+	{
+		TieredSeries previous = std::move(*this);
+		if (!allocate(arena, rawCapacity)) return false;
+		auto [olderValues, newerValues] = previous.raw_.as_spans();
+		auto [olderTimes, newerTimes] = previous.rawTimes_.as_spans();
+		raw_.push_range(olderValues);
+		raw_.push_range(newerValues);
+		rawTimes_.push_range(olderTimes);
+		rawTimes_.push_range(newerTimes);
+		for (size_t t = 0; t < rollups_.size(); ++t) {
+			const Rollup& from = previous.rollups_[t];
+			Rollup& to = rollups_[t];
+			if (from.buckets.size() != to.buckets.size()) continue;
+			std::copy(from.buckets.begin(), from.buckets.end(), to.buckets.begin());
+			to.head = from.head;
+			to.size = from.size;
+			to.open = from.open;
+		}
+		return true;
+	}
+
+	// Samples must arrive in time order; one older than the last is dropped
+	void push(uint64_t timeMs, float value)
+	{
+		if (raw_.capacity() == 0) return;
+		if (!raw_.empty() && timeMs < rawTimes_.latest()) return;
+		raw_.push(value);
+		rawTimes_.push(timeMs);
+
+		Bucket sample{ timeMs, value, value, value, 1 };
+		fold(0, sample);
+	}
+
+	// The raw window, for graphs that draw recent samples one by one
+	const HistoryBuffer<float>& raw() const { return raw_; }
+	// When each raw sample was taken, index for index with raw()
+	const HistoryBuffer<uint64_t>& rawTimes() const { return rawTimes_; }
+
+	size_t size() const { return raw_.size(); }
+	bool empty() const { return raw_.empty(); }
+	float latest() const { return raw_.latest(); }
+	float get(size_t index) const { return raw_.get(index); }
+	uint64_t latestTime() const { return rawTimes_.latest(); }
+
+	// How far back each tier reaches once it has filled up
+	uint64_t retentionSeconds(Tier tier) const
+	{
+		return tier == Tier::Raw ? raw_.capacity()
+			: static_cast<uint64_t>(RollupResolutions[static_cast<size_t>(tier) - 1]) * RollupCapacities[static_cast<size_t>(tier) - 1];
+	}
+
+	static constexpr uint32_t resolutionSeconds(Tier tier)
+	{
+		return tier == Tier::Raw ? 1 : RollupResolutions[static_cast<size_t>(tier) - 1];
+	}
+
+	// Finest tier that reaches back far enough and doesn't give more points than there are pixels to draw
+	// them in; ranges longer than every tier get the coarsest one
+	Tier bestTier(uint64_t rangeSeconds, uint32_t pixelWidth) const
+	{
+		for (Tier tier : { Tier::Raw, Tier::TenSeconds }) {
+			uint64_t points = rangeSeconds / resolutionSeconds(tier);
+			if (rangeSeconds <= retentionSeconds(tier) && points <= std::max<uint64_t>(pixelWidth, 1)) return tier;
+		}
+		return Tier::OneMinute;
+	}
+
+	// Points covering the last rangeSeconds (up to the newest sample), oldest first, from bestTier.
+	// The rollup still being filled is included last, so the newest data is never missing from a coarse view.
+	void query(uint64_t rangeSeconds, uint32_t pixelWidth, std::vector<Point>& out) const
+	{
+		queryTier(bestTier(rangeSeconds, pixelWidth), rangeSeconds, out);
+	}
+
+	void queryTier(Tier tier, uint64_t rangeSeconds, std::vector<Point>& out) const
+	{
+		out.clear();
+		if (raw_.empty()) return;
+		uint64_t newest = rawTimes_.latest();
+		uint64_t range = rangeSeconds * 1000;
+		uint64_t from = newest >= range ? newest - range : 0;
+
+		if (tier == Tier::Raw) {
+			// Times only grow, so the first sample in range is a binary search away
+			size_t first = static_cast<size_t>(std::lower_bound(rawTimes_.begin(), rawTimes_.end(), from) - rawTimes_.begin());
+			for (size_t i = first; i < raw_.size(); ++i) {
+				float value = raw_[i];
+				out.push_back({ rawTimes_[i], value, value, value });
+			}
+			return;
+		}
+
+		const Rollup& rollup = rollups_[static_cast<size_t>(tier) - 1];
+		auto emit = [&out, from, &rollup](const Bucket& bucket) {
+			if (bucket.time + rollup.resolution <= from) return;
+			out.push_back({ bucket.time, bucket.min, bucket.max, bucket.sum / static_cast<float>(bucket.count) });
+		};
+		size_t capacity = rollup.buckets.size();
+		for (size_t i = 0; i < rollup.size; ++i) {
+			emit(rollup.buckets[(rollup.head + capacity - rollup.size + i) % capacity]);
+		}
+		// A coarse open bucket hasn't seen the tier below's open bucket yet; merge it in for the partial point
+		Bucket open = rollup.open;
+		for (size_t t = static_cast<size_t>(tier) - 1; t-- > 0;) {
+			const Bucket& lower = rollups_[t].open;
+			if (lower.count == 0) continue;
+			if (open.count == 0) {
+				open = lower;
+				open.time = lower.time - lower.time % rollup.resolution;
+				continue;
+			}
+			open.min = std::min(open.min, lower.min);
+			open.max = std::max(open.max, lower.max);
+			open.sum += lower.sum;
+			open.count += lower.count;
+		}
+		if (open.count > 0) emit(open);
+	}
+
+	// Min, max, sum and count of the samples taken in the last windowMs up to the newest; count 0 if there are
+	// none. A window the raw samples cover is exact. A longer one adds up whole buckets of the finest rollup that
+	// reaches back far enough, so its oldest edge is rounded out to that tier's resolution. Allocates nothing.
+	SeriesStats::Summary summarize(uint64_t windowMs) const
+	{
+		if (raw_.empty()) return {};
+		uint64_t newest = rawTimes_.latest();
+		bool whole = windowMs >= newest; // Reaches back before the first sample
+		uint64_t from = whole ? 0 : newest - windowMs; // Otherwise, samples strictly after this count
+
+		// Nothing has been dropped from the raw window yet, or the window starts inside it
+		if (raw_.size() < raw_.capacity() || (!whole && rawTimes_[0] <= from)) {
+			size_t first = whole ? 0 : static_cast<size_t>(std::upper_bound(rawTimes_.begin(), rawTimes_.end(), from) - rawTimes_.begin());
+			return SeriesStats::Summarize(raw_.view(), first);
+		}
+
+		size_t tier = 0;
+		for (; tier + 1 < rollups_.size(); ++tier) {
+			const Rollup& rollup = rollups_[tier];
+			if (rollup.size < rollup.buckets.size() || (!whole && oldest(rollup).time <= from)) break;
+		}
+
+		// Newest first, so a short window stops early; the open buckets of this tier and the ones below hold
+		// whatever hasn't been folded into a closed bucket yet
+		const Rollup& rollup = rollups_[tier];
+		SeriesStats::Summary summary;
+		auto add = [&summary](const Bucket& bucket) {
+			if (bucket.count > 0) summary = SeriesStats::Merge(summary, { bucket.min, bucket.max, bucket.sum, bucket.count });
+		};
+		size_t capacity = rollup.buckets.size();
+		for (size_t i = rollup.size; i-- > 0;) {
+			const Bucket& bucket = rollup.buckets[(rollup.head + capacity - rollup.size + i) % capacity];
+			if (!whole && bucket.time + rollup.resolution <= from) break;
+			add(bucket);
+		}
+		for (size_t t = 0; t <= tier; ++t) add(rollups_[t].open);
+		return summary;
+	}
+
+	void clear()
+	{
+		raw_.clear();
+		rawTimes_.clear();
+		for (auto& rollup : rollups_) {
+			rollup.head = 0;
+			rollup.size = 0;
+			rollup.open = Bucket{};
+		}
+	}
+
+	// Fixed for the lifetime of the series: the object plus its slices of the arena
+	size_t memoryBytes() const
+	{
+		size_t bytes = sizeof(*this) + HistoryBuffer<float>::storageBytes(raw_.capacity())
+			+ HistoryBuffer<uint64_t>::storageBytes(rawTimes_.capacity());
+		for (const auto& rollup : rollups_) bytes += SeriesArena::bytesFor<Bucket>(rollup.buckets.size());
+		return bytes;
+	}
+
+private:
+	static constexpr std::array<uint32_t, 2> RollupResolutions = { 10, 60 };
+	static constexpr std::array<size_t, 2> RollupCapacities = { 2160, 2880 }; // 6 hours, 2 days
+
+	struct Bucket
+	{
+		uint64_t time = 0; // Start in milliseconds, aligned to the tier's resolution
+		float min = 0.0f;
+		float max = 0.0f;
+		float sum = 0.0f;
+		uint32_t count = 0;
+	};
+
+	struct Rollup
+	{
+		uint64_t resolution = 0; // Milliseconds
+		std::span<Bucket> buckets; // Ring of closed buckets, in the arena
+		size_t head = 0;
+		size_t size = 0;
+		Bucket open; // Still collecting; count == 0 when nothing has arrived yet
+	};
+
+	HistoryBuffer<float> raw_;
+	HistoryBuffer<uint64_t> rawTimes_;
+	std::array<Rollup, 2> rollups_;
+
+	static const Bucket& oldest(const Rollup& rollup)
+	{
+		size_t capacity = rollup.buckets.size();
+		return rollup.buckets[(rollup.head + capacity - rollup.size) % capacity];
+	}
+
+	// Adds a sample (tier 0) or a closed bucket of the tier below; closing a bucket cascades one tier up.
+	// Each push touches at most one open bucket per tier, so the cost is constant.
+	void fold(size_t tier, const Bucket& input)
+	{
+		Rollup& rollup = rollups_[tier];
+		uint64_t start = input.time - input.time % rollup.resolution;
+
+		if (rollup.open.count > 0 && rollup.open.time != start) {
+			Bucket closed = rollup.open;
+			rollup.buckets[rollup.head] = closed;
+			rollup.head = (rollup.head + 1) % rollup.buckets.size();
+			if (rollup.size < rollup.buckets.size()) ++rollup.size;
+			rollup.open = Bucket{};
+			if (tier + 1 < rollups_.size()) fold(tier + 1, closed);
+		}
+
+		if (rollup.open.count == 0) {
+			rollup.open = input;
+			rollup.open.time = start;
+			return;
+		}
+		rollup.open.min = std::min(rollup.open.min, input.min);
+		rollup.open.max = std::max(rollup.open.max, input.max);
+		rollup.open.sum += input.sum;
+		rollup.open.count += input.count;
+	}
+};
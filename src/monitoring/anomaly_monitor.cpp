@@ -0,0 +1,81 @@
+#include "anomaly_monitor.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+void AnomalyMonitor::Watch(const std::string& name, const TieredSeries& history, const AnomalyDetector::Config& config, const std::string& unit)
+{
+	Metric metric;
+	metric.name = name;
+	metric.title = "Unusual " + name;
+	metric.unit = unit;
+	metric.history = &history;
+	metric.detector = AnomalyDetector(config);
+	metrics_.push_back(std::move(metric));
+}
+
+void AnomalyMonitor::Update(std::vector<SystemAlert>& alerts, uint64_t timeMs)
+{
+	for (Metric& metric : metrics_) {
+		const auto& values = metric.history->raw();
+		const auto& times = metric.history->rawTimes();
+		if (values.empty()) continue;
+
+		// Usually one new sample per tick; walk back to the first one not seen yet
+		size_t first = values.size();
+		while (first > 0 && (!metric.hasSample || times[first - 1] > metric.lastSampleTime)) --first;
+		if (first == values.size()) continue;
+
+		bool wasAnomalous = metric.detector.anomalous();
+		for (size_t i = first; i < values.size(); ++i) metric.detector.update(times[i], values[i]);
+		metric.lastSampleTime = times.latest();
+		metric.hasSample = true;
+
+		bool isAnomalous = metric.detector.anomalous();
+		if (isAnomalous && !wasAnomalous) {
+			float score = metric.detector.score();
+			SystemAlert alert;
+			alert.type = AlertRule::ANOMALY;
+			alert.title = metric.title;
+			alert.message = metric.name + " is " + FormatValue(values.latest(), metric.unit) + " against a baseline of "
+				+ FormatValue(metric.detector.expected(), metric.unit) + " (" + (score > 0.0f ? "+" : "")
+				+ FormatValue(score, "") + " deviations)";
+			alert.currentValue = values.latest();
+			alert.threshold = metric.detector.expected();
+			alert.timestamp = timeMs;
+			alert.severity = std::fabs(score) >= 2.0f * metric.detector.config().threshold ? 3 : 2;
+			alerts.push_back(alert);
+		} else if (!isAnomalous && wasAnomalous) {
+			alerts.erase(std::remove_if(alerts.begin(), alerts.end(), [&metric](const SystemAlert& alert) {
+				return alert.type == AlertRule::ANOMALY && alert.title == metric.title;
+			}), alerts.end());
+		}
+	}
+}
+
+bool AnomalyMonitor::IsAnomalous(const std::string& name) const
+{
+	for (const Metric& metric : metrics_) {
+		if (metric.name == name) return metric.detector.anomalous();
+	}
+	return false;
+}
+
+std::string AnomalyMonitor::FormatValue(float value, const std::string& unit)
+{
+	std::ostringstream oss;
+	oss << std::fixed << std::setprecision(1);
+	if (unit == "B/s") {
+		const char* units[] = { "B/s", "KB/s", "MB/s", "GB/s" };
+		size_t index = 0;
+		while (std::fabs(value) >= 1024.0f && index + 1 < std::size(units)) {
+			value /= 1024.0f;
+			++index;
+		}
+		oss << value << " " << units[index];
+	} else {
+		oss << value << unit;
+	}
+	return oss.str();
+}
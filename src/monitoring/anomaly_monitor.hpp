@@ -0,0 +1,38 @@
+// AnomalyMonitor: Runs an AnomalyDetector over each watched metric history and turns deviations into alerts.
+// Complements the fixed thresholds of AlertRule: a metric is flagged when it leaves its own baseline, whatever
+// that baseline is on this host. Each update only looks at the samples that arrived since the previous one.
+#pragma once
+#include "../core/anomaly_detector.hpp"
+#include "../core/system_state.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class AnomalyMonitor
+{
+public:
+	// The history must outlive the monitor; unit is "%" or "B/s" and only affects alert messages
+	void Watch(const std::string& name, const TieredSeries& history, const AnomalyDetector::Config& config, const std::string& unit);
+
+	// Feeds new samples to the detectors and adds or clears each metric's ANOMALY alert; timeMs stamps new alerts
+	void Update(std::vector<SystemAlert>& alerts, uint64_t timeMs);
+
+	size_t GetWatchedCount() const { return metrics_.size(); }
+	bool IsAnomalous(const std::string& name) const;
+
+private:
+	struct Metric
+	{
+		std::string name;
+		std::string title; // Identifies the metric's alert in the active list
+		std::string unit;
+		const TieredSeries* history = nullptr;
+		AnomalyDetector detector;
+		uint64_t lastSampleTime = 0;
+		bool hasSample = false;
+	};
+
+	std::vector<Metric> metrics_;
+
+	static std::string FormatValue(float value, const std::string& unit);
+};
@@ -1,12 +1,68 @@
 #include "data_collector.hpp"
+#ifdef _WIN32
 #include "../platform/windows/windows_system_monitor.hpp"
+#endif
+#ifdef __linux__
+#include "../platform/linux/linux_numa_monitor.hpp"
+#include "../platform/linux/linux_filesystem_monitor.hpp"
+#include "../platform/linux/linux_net_health_monitor.hpp"
+#include "../platform/linux/linux_sensor_monitor.hpp"
+#include "../platform/linux/linux_power_monitor.hpp"
+#include "../platform/linux/linux_gpu_monitor.hpp"
+#include "../platform/linux/linux_process_monitor.hpp"
+#include "../platform/linux/linux_fd_monitor.hpp"
+#endif
+#include <algorithm>
+#include <cstdlib>
 #include <iostream>
+#include <unordered_map>
 
-DataCollector::DataCollector() : lastUpdate_(std::chrono::steady_clock::now()) {}
+namespace
+{
+	// Monotonic milliseconds, the time base of every TieredSeries history; wall-clock steps don't move samples
+	uint64_t NowMilliseconds()
+	{
+		return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count());
+	}
+}
+
+DataCollector::DataCollector() : lastUpdate_(std::chrono::steady_clock::now())
+{
+	InitializeAlertMetrics();
+}
 DataCollector::~DataCollector() {}
 
 bool DataCollector::Initialize()
 {
+	// PULSE_HISTORY_SECONDS overrides the raw retention of every metric history
+	if (const char* seconds = std::getenv("PULSE_HISTORY_SECONDS")) {
+		long value = std::strtol(seconds, nullptr, 10);
+		if (value > 0) {
+			size_t samples = static_cast<size_t>(value);
+			historyRetention_ = HistoryRetention{ samples, samples, samples, samples, samples };
+		}
+	}
+	AllocateHistories();
+	InitializeAnomalyDetection();
+
+	// PULSE_ALERT_RULES adds expression rules, e.g. "avg(cpu, 30s) > 90; mem.available < 1GiB"
+	if (const char* rules = std::getenv("PULSE_ALERT_RULES")) {
+		std::string list = rules;
+		size_t start = 0;
+		while (start <= list.size()) {
+			size_t end = std::min(list.find(';', start), list.size());
+			std::string source = list.substr(start, end - start);
+			std::string error;
+			if (source.find_first_not_of(" \t") != std::string::npos
+				&& !AddAlertExpression(source, "Alert rule matched", 60, error)) {
+				std::cerr << "Ignoring alert rule \"" << source << "\": " << error << "\n";
+			}
+			start = end + 1;
+		}
+	}
+
+#ifdef _WIN32
 	systemMonitor_ = std::unique_ptr<ISystemMonitor>(new WindowsSystemMonitor());
 	
 	if (!systemMonitor_)
@@ -27,6 +83,11 @@ bool DataCollector::Initialize()
 	std::cout << "GPU: " << systemState_.gpuName << "\n";
 	std::cout << "Primary Disk: " << systemState_.primaryDiskName << "\n";
 	std::cout << "Network Interface: " << systemState_.primaryNetworkInterface << "\n";
+#endif
+
+#ifdef __linux__
+	InitializeLinuxProviders();
+#endif
 	
 	return true;
 }
@@ -39,28 +100,162 @@ void DataCollector::Update()
 	if (elapsed >= 1000)
 	{
 		UpdateSystemMetrics();
+#ifdef __linux__
+		UpdateLinuxProviders();
+#endif
+		// After every provider, so rules see this tick's values on each platform
+		UpdateAlerts();
+		UpdateAnomalies();
+		processTree_.Update(systemState_.processes);
+		processRanking_.Rebuild(systemState_.processes);
+		processFilter_.Update(systemState_.processes);
+		UpdateFilteredRanking();
+#ifdef __linux__
+		RequestSearchMetadata();
+#endif
+		UpdateUserUsage();
+		UpdateSelectedProcessHistory();
 		lastUpdate_ = now;
 	}
 }
 
+void DataCollector::SetHistoryRetention(const HistoryRetention& retention)
+{
+	historyRetention_ = retention;
+	AllocateHistories();
+}
+
+void DataCollector::AllocateHistories()
+{
+	// One allocation covers every history and quantile sketch; series and sketches copy their data onto the new
+	// arena before the old one is freed
+	const HistoryRetention& r = historyRetention_;
+	const QuantileSketch::Mapping percent{ 0.1f, 100.0f, 0.01f };
+	const QuantileSketch::Mapping bytesPerSecond{ 1.0f, 1e11f, 0.01f };
+	size_t bytes = TieredSeries::storageBytes(r.cpu) + TieredSeries::storageBytes(r.memory)
+		+ TieredSeries::storageBytes(r.gpu) + TieredSeries::storageBytes(r.disk) + 3 * TieredSeries::storageBytes(r.network)
+		+ 5 * QuantileWindows::storageBytes(percent) + 2 * QuantileWindows::storageBytes(bytesPerSecond);
+	auto arena = std::make_unique<SeriesArena>(bytes);
+	systemState_.cpuHistory.reallocate(*arena, r.cpu);
+	systemState_.memoryHistory.reallocate(*arena, r.memory);
+	systemState_.gpuHistory.reallocate(*arena, r.gpu);
+	systemState_.diskHistory.reallocate(*arena, r.disk);
+	systemState_.networkHistory.reallocate(*arena, r.network);
+	systemState_.uploadHistory.reallocate(*arena, r.network);
+	systemState_.downloadHistory.reallocate(*arena, r.network);
+	systemState_.cpuQuantiles.reallocate(*arena, percent);
+	systemState_.memoryQuantiles.reallocate(*arena, percent);
+	systemState_.gpuQuantiles.reallocate(*arena, percent);
+	systemState_.diskQuantiles.reallocate(*arena, percent);
+	systemState_.networkQuantiles.reallocate(*arena, percent);
+	systemState_.uploadQuantiles.reallocate(*arena, bytesPerSecond);
+	systemState_.downloadQuantiles.reallocate(*arena, bytesPerSecond);
+	historyArena_ = std::move(arena);
+}
+
+void DataCollector::SetSelectedProcess(uint32_t pid)
+{
+	if (pid == selectedPid_) return;
+	selectedPid_ = pid;
+	if (pid != 0) RequestProcessMetadata(pid);
+
+	ProcessHistory& history = systemState_.selectedProcessHistory;
+	history.pid = pid;
+	history.cpu.clear();
+	history.memory.clear();
+
+#ifdef __linux__
+	// Start the placement read right away; it runs on the NUMA monitor's worker and lands on a later tick, so a
+	// large or stuck process never holds up the click
+	systemState_.numa.selectedProcess = NumaProcessPlacement{};
+	UpdateSelectedProcessPlacement();
+#endif
+}
+
+void DataCollector::SetProcessFilter(const std::string& query)
+{
+	// Called per keystroke; the filter narrows its previous matches when the query grows
+	bool wasActive = processFilter_.IsActive();
+	processFilter_.SetQuery(systemState_.processes, query);
+	UpdateFilteredRanking();
+#ifdef __linux__
+	if (!wasActive) RequestSearchMetadata();
+#endif
+}
+
+void DataCollector::RequestProcessMetadata(uint32_t pid)
+{
+#ifdef __linux__
+	if (processMonitor_) processMonitor_->RequestMetadata(pid);
+#else
+	(void)pid;
+#endif
+}
+
+const ProcessMetadata* DataCollector::GetProcessMetadata(uint32_t pid) const
+{
+#ifdef __linux__
+	if (processMonitor_) return processMonitor_->GetMetadata(pid);
+#else
+	(void)pid;
+#endif
+	return nullptr;
+}
+
+void DataCollector::EnsureVisibleRankDepth(ProcessSortKey key, size_t depth)
+{
+	ProcessRanking& ranking = processFilter_.IsActive() ? filteredRanking_ : processRanking_;
+	ranking.EnsureDepth(systemState_.processes, key, depth);
+}
+
+void DataCollector::UpdateFilteredRanking()
+{
+	if (processFilter_.IsActive()) filteredRanking_.Rebuild(systemState_.processes, processFilter_.GetMatches());
+}
+
+void DataCollector::SetFilesystemRefreshInterval(std::chrono::seconds interval)
+{
+	filesystemRefreshInterval_ = interval;
+#ifdef __linux__
+	if (filesystemMonitor_) filesystemMonitor_->SetRefreshInterval(interval);
+#endif
+}
+
+void DataCollector::SetFdTrackingEnabled(bool enabled)
+{
+	fdTrackingEnabled_ = enabled;
+#ifdef __linux__
+	if (!enabled) {
+		fdMonitor_.reset();
+		systemState_.fds = FdStats{};
+	} else if (!fdMonitor_ && processMonitor_) {
+		fdMonitor_ = std::make_unique<LinuxFdMonitor>();
+	}
+#endif
+}
+
 void DataCollector::UpdateSystemMetrics()
 {
 	if (!systemMonitor_) return;
 
 	systemMonitor_->UpdateSystemMetrics();
+	uint64_t now = NowMilliseconds();
 	
 		// Record new CPU usage so we know what’s going on under the hood
 	systemState_.cpuUsagePercent = systemMonitor_->GetCPUUsage();
-	systemState_.cpuHistory.push(systemState_.cpuUsagePercent);
+	systemState_.cpuHistory.push(now, systemState_.cpuUsagePercent);
+	systemState_.cpuQuantiles.push(now, systemState_.cpuUsagePercent);
 	
 		// Check memory use – keeping an eye on how much RAM you’re using
 	systemState_.usedRAMBytes = systemMonitor_->GetUsedMemory();
 	systemState_.memoryUsagePercent = systemMonitor_->GetMemoryUsagePercent();
-	systemState_.memoryHistory.push(systemState_.memoryUsagePercent);
+	systemState_.memoryHistory.push(now, systemState_.memoryUsagePercent);
+	systemState_.memoryQuantiles.push(now, systemState_.memoryUsagePercent);
 	
 		// Fetch GPU stats to see how hard your graphics card is working
 	systemState_.gpuUsagePercent = systemMonitor_->GetGPUUsage();
-	systemState_.gpuHistory.push(systemState_.gpuUsagePercent);
+	systemState_.gpuHistory.push(now, systemState_.gpuUsagePercent);
+	systemState_.gpuQuantiles.push(now, systemState_.gpuUsagePercent);
 	systemState_.gpuMemoryUsed = systemMonitor_->GetGPUMemoryUsed();
 	systemState_.gpuMemoryTotal = systemMonitor_->GetGPUMemoryTotal();
 	
@@ -68,19 +263,22 @@ void DataCollector::UpdateSystemMetrics()
 	systemState_.diskUsagePercent = systemMonitor_->GetDiskUsage();
 	systemState_.diskReadBytesPerSec = systemMonitor_->GetDiskReadBytesPerSec();
 	systemState_.diskWriteBytesPerSec = systemMonitor_->GetDiskWriteBytesPerSec();
-	systemState_.diskHistory.push(systemState_.diskUsagePercent);
+	systemState_.diskHistory.push(now, systemState_.diskUsagePercent);
+	systemState_.diskQuantiles.push(now, systemState_.diskUsagePercent);
 	
 		// Measure network throughput – upload and download speeds included
 	systemState_.networkUsagePercent = systemMonitor_->GetNetworkUsage();
 	systemState_.uploadBytesPerSec = systemMonitor_->GetNetworkUploadBytesPerSec();
 	systemState_.downloadBytesPerSec = systemMonitor_->GetNetworkDownloadBytesPerSec();
-	systemState_.networkHistory.push(systemState_.networkUsagePercent);
-	systemState_.uploadHistory.push(systemState_.uploadBytesPerSec);
-	systemState_.downloadHistory.push(systemState_.downloadBytesPerSec);
+	systemState_.networkHistory.push(now, systemState_.networkUsagePercent);
+	systemState_.uploadHistory.push(now, static_cast<float>(systemState_.uploadBytesPerSec));
+	systemState_.downloadHistory.push(now, static_cast<float>(systemState_.downloadBytesPerSec));
+	systemState_.networkQuantiles.push(now, systemState_.networkUsagePercent);
+	systemState_.uploadQuantiles.push(now, static_cast<float>(systemState_.uploadBytesPerSec));
+	systemState_.downloadQuantiles.push(now, static_cast<float>(systemState_.downloadBytesPerSec));
 	
 		// Refresh process list – see which programs are hogging resources
-	systemState_.processes = systemMonitor_->GetProcesses();
-	systemState_.processes.shrink_to_fit();  // release excess capacity
+	systemState_.processes.assign(systemMonitor_->GetProcesses());
 	systemState_.totalProcesses = systemMonitor_->GetTotalProcesses();
 	systemState_.totalThreads = systemMonitor_->GetTotalThreads();
 	
@@ -88,9 +286,6 @@ void DataCollector::UpdateSystemMetrics()
 	systemState_.networkStats = systemMonitor_->GetNetworkStats();
 	systemState_.networkStats.interfaces.shrink_to_fit();
 	
-		// Evaluate alert rules and pop up warnings if something trips
-	UpdateAlerts();
-	
 	systemState_.lastUpdateTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
 }
 
@@ -102,12 +297,13 @@ void DataCollector::UpdateAlerts()
 	
 	auto currentTime = std::chrono::duration_cast<std::chrono::milliseconds>(
 		std::chrono::system_clock::now().time_since_epoch()).count();
+	uint64_t now = NowMilliseconds();
 	
-	for (auto& rule : systemState_.alertRules) {
+	for (size_t ruleIndex = 0; ruleIndex < systemState_.alertRules.size(); ++ruleIndex) {
+		AlertRule& rule = systemState_.alertRules[ruleIndex];
 		if (!rule.isEnabled) continue;
 		
 		float currentValue = 0.0f;
-		bool shouldTrigger = false;
 		
 		switch (rule.type) {
 			case AlertRule::CPU_USAGE:
@@ -125,60 +321,73 @@ void DataCollector::UpdateAlerts()
 			case AlertRule::PROCESS_COUNT:
 				currentValue = static_cast<float>(systemState_.totalProcesses);
 				break;
+			case AlertRule::FD_HEADROOM:
+				currentValue = systemState_.fds.maxUsagePercent;
+				break;
+			case AlertRule::EXPRESSION:
+				currentValue = rule.expression.Test(alertMetrics_) ? 1.0f : 0.0f;
+				break;
+			case AlertRule::ANOMALY:
+				continue;
 		}
 		
-		shouldTrigger = currentValue > rule.threshold;
+		// Pending once above the threshold, firing after durationSeconds of it, cleared at the clear threshold
+		AlertState::Change change = rule.state.update(currentValue, rule.threshold, rule.clearThreshold,
+			static_cast<uint64_t>(rule.durationSeconds) * 1000, now);
+		auto existing = std::find_if(systemState_.activeAlerts.begin(), systemState_.activeAlerts.end(),
+			[ruleIndex](const SystemAlert& alert) { return alert.ruleIndex == static_cast<int32_t>(ruleIndex); });
 		
-		if (shouldTrigger) {
-			bool alertExists = false;
-			for (const auto& alert : systemState_.activeAlerts) {
-				if (alert.type == rule.type) {
-					alertExists = true;
+		if (change == AlertState::Change::Fired && existing == systemState_.activeAlerts.end()) {
+			SystemAlert alert;
+			alert.type = rule.type;
+			alert.ruleIndex = static_cast<int32_t>(ruleIndex);
+			alert.currentValue = currentValue;
+			alert.threshold = rule.threshold;
+			alert.timestamp = currentTime;
+			alert.severity = (rule.type != AlertRule::EXPRESSION && currentValue > rule.threshold * 1.5f) ? 3 : 2; // Critical if 150% of threshold
+			
+			switch (rule.type) {
+				case AlertRule::CPU_USAGE:
+					alert.title = "High CPU Usage";
+					alert.message = "CPU usage is " + std::to_string((int)currentValue) + "%, exceeding threshold of " + std::to_string((int)rule.threshold) + "%";
+					break;
+				case AlertRule::MEMORY_USAGE:
+					alert.title = "High Memory Usage";
+					alert.message = "Memory usage is " + std::to_string((int)currentValue) + "%, exceeding threshold of " + std::to_string((int)rule.threshold) + "%";
+					break;
+				case AlertRule::DISK_USAGE:
+					alert.title = "High Disk Usage";
+					alert.message = "Disk usage is " + std::to_string((int)currentValue) + "%, exceeding threshold of " + std::to_string((int)rule.threshold) + "%";
+					break;
+				case AlertRule::NETWORK_USAGE:
+					alert.title = "High Network Usage";
+					alert.message = "Network usage is " + std::to_string((int)currentValue) + "%, exceeding threshold of " + std::to_string((int)rule.threshold) + "%";
+					break;
+				case AlertRule::PROCESS_COUNT:
+					alert.title = "High Process Count";
+					alert.message = "Process count is " + std::to_string((int)currentValue) + ", exceeding threshold of " + std::to_string((int)rule.threshold);
+					break;
+				case AlertRule::FD_HEADROOM:
+					alert.title = "File Descriptors Near Limit";
+					alert.message = systemState_.fds.maxUsageName + " (" + std::to_string(systemState_.fds.maxUsagePid) + ") has " + std::to_string((int)currentValue) + "% of its open file limit in use, exceeding threshold of " + std::to_string((int)rule.threshold) + "%";
+					break;
+				case AlertRule::EXPRESSION:
+					alert.title = rule.message;
+					alert.message = rule.expression.GetSource() + " has held for " + std::to_string(rule.durationSeconds) + "s";
+					break;
+				case AlertRule::ANOMALY:
 					break;
-				}
 			}
 			
-			if (!alertExists) {
-				SystemAlert alert;
-				alert.type = rule.type;
-				alert.currentValue = currentValue;
-				alert.threshold = rule.threshold;
-				alert.timestamp = currentTime;
-				alert.severity = (currentValue > rule.threshold * 1.5f) ? 3 : 2; // Critical if 150% of threshold
-				
-				switch (rule.type) {
-					case AlertRule::CPU_USAGE:
-						alert.title = "High CPU Usage";
-						alert.message = "CPU usage is " + std::to_string((int)currentValue) + "%, exceeding threshold of " + std::to_string((int)rule.threshold) + "%";
-						break;
-					case AlertRule::MEMORY_USAGE:
-						alert.title = "High Memory Usage";
-						alert.message = "Memory usage is " + std::to_string((int)currentValue) + "%, exceeding threshold of " + std::to_string((int)rule.threshold) + "%";
-						break;
-					case AlertRule::DISK_USAGE:
-						alert.title = "High Disk Usage";
-						alert.message = "Disk usage is " + std::to_string((int)currentValue) + "%, exceeding threshold of " + std::to_string((int)rule.threshold) + "%";
-						break;
-					case AlertRule::NETWORK_USAGE:
-						alert.title = "High Network Usage";
-						alert.message = "Network usage is " + std::to_string((int)currentValue) + "%, exceeding threshold of " + std::to_string((int)rule.threshold) + "%";
-						break;
-					case AlertRule::PROCESS_COUNT:
-						alert.title = "High Process Count";
-						alert.message = "Process count is " + std::to_string((int)currentValue) + ", exceeding threshold of " + std::to_string((int)rule.threshold);
-						break;
-				}
-				
-				systemState_.activeAlerts.push_back(alert);
-				rule.triggeredCount++;
-				rule.lastTriggeredTime = currentTime;
-			}
-		} else {
-			auto it = std::remove_if(systemState_.activeAlerts.begin(), systemState_.activeAlerts.end(),
-				[&rule](const SystemAlert& alert) {
-					return alert.type == rule.type;
-				});
-			systemState_.activeAlerts.erase(it, systemState_.activeAlerts.end());
+			systemState_.activeAlerts.push_back(alert);
+			rule.triggeredCount++;
+			rule.lastTriggeredTime = currentTime;
+		} else if (change == AlertState::Change::Cleared && existing != systemState_.activeAlerts.end()) {
+			systemState_.activeAlerts.erase(existing);
+		} else if (existing != systemState_.activeAlerts.end()) {
+			// Still firing; keep the shown value and severity current
+			existing->currentValue = currentValue;
+			existing->severity = (rule.type != AlertRule::EXPRESSION && currentValue > rule.threshold * 1.5f) ? 3 : 2;
 		}
 	}
 	
@@ -187,11 +396,121 @@ void DataCollector::UpdateAlerts()
 	systemState_.totalAlerts = static_cast<uint32_t>(systemState_.activeAlerts.size());
 }
 
+void DataCollector::UpdateSelectedProcessHistory()
+{
+	ProcessHistory& history = systemState_.selectedProcessHistory;
+	if (history.pid == 0) return;
+	size_t row = systemState_.processes.find(history.pid);
+	if (row == ProcessStore::npos) return; // Exited; the history stays up to its last sample
+
+	uint64_t now = NowMilliseconds();
+	history.cpu.push(static_cast<int64_t>(now), systemState_.processes.cpuUsagePercent(row));
+	history.memory.push(static_cast<int64_t>(now), static_cast<float>(systemState_.processes.memoryUsage(row)));
+}
+
+void DataCollector::UpdateUserUsage()
+{
+	// Aggregated from the process list already collected this tick, so it costs no extra syscalls
+	const ProcessStore& processes = systemState_.processes;
+	std::unordered_map<uint32_t, UserUsage> byUid;
+	for (size_t i = 0; i < processes.size(); ++i) {
+		if (processes.userNameId(i) == 0) continue;
+
+		UserUsage& user = byUid[processes.uid(i)];
+		if (user.processCount == 0) {
+			user.uid = processes.uid(i);
+			user.name = processes.userName(i);
+		}
+		user.processCount++;
+		user.threadCount += processes.threadCount(i);
+		user.cpuUsagePercent += processes.cpuUsagePercent(i);
+		user.memoryBytes += processes.memoryUsage(i);
+		user.ioReadBytesPerSec += processes.ioReadBytesPerSec(i);
+		user.ioWriteBytesPerSec += processes.ioWriteBytesPerSec(i);
+	}
+
+	systemState_.users.clear();
+	for (auto& entry : byUid) systemState_.users.push_back(std::move(entry.second));
+	std::sort(systemState_.users.begin(), systemState_.users.end(), [](const UserUsage& a, const UserUsage& b) {
+		return a.cpuUsagePercent != b.cpuUsagePercent ? a.cpuUsagePercent > b.cpuUsagePercent : a.memoryBytes > b.memoryBytes;
+	});
+}
+
+void DataCollector::InitializeAnomalyDetection()
+{
+	// Utilization baselines learn a daily shape; spreads are floored so idle, flat metrics don't flag noise
+	AnomalyDetector::Config percent;
+	percent.minDeviation = 2.0f;
+	percent.seasonal = true;
+	AnomalyDetector::Config bytesPerSecond = percent;
+	bytesPerSecond.minDeviation = 64.0f * 1024.0f;
+
+	anomalyMonitor_.Watch("CPU", systemState_.cpuHistory, percent, "%");
+	anomalyMonitor_.Watch("Memory", systemState_.memoryHistory, percent, "%");
+	anomalyMonitor_.Watch("GPU", systemState_.gpuHistory, percent, "%");
+	anomalyMonitor_.Watch("Disk", systemState_.diskHistory, percent, "%");
+	anomalyMonitor_.Watch("Network", systemState_.networkHistory, percent, "%");
+	anomalyMonitor_.Watch("Upload", systemState_.uploadHistory, bytesPerSecond, "B/s");
+	anomalyMonitor_.Watch("Download", systemState_.downloadHistory, bytesPerSecond, "B/s");
+}
+
+void DataCollector::UpdateAnomalies()
+{
+	uint64_t now = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+		std::chrono::system_clock::now().time_since_epoch()).count());
+	anomalyMonitor_.Update(systemState_.activeAlerts, now);
+	systemState_.totalAlerts = static_cast<uint32_t>(systemState_.activeAlerts.size());
+}
+
+void DataCollector::InitializeAlertMetrics()
+{
+	// Sources live in systemState_, so the table is built once at construction and expressions can be added
+	// before Initialize(); metrics with a history also work in avg/min/max, and those with quantiles in p50/p95/p99
+	SystemState& s = systemState_;
+	alertMetrics_.Add("cpu", s.cpuUsagePercent, &s.cpuHistory, &s.cpuQuantiles);
+	alertMetrics_.Add("mem.usage", s.memoryUsagePercent, &s.memoryHistory, &s.memoryQuantiles);
+	alertMetrics_.Add("mem.used", s.usedRAMBytes);
+	alertMetrics_.Add("mem.total", s.totalRAMBytes);
+	alertMetrics_.AddComputed("mem.available", &s, [](const void* state) {
+		const SystemState& s = *static_cast<const SystemState*>(state);
+		return static_cast<double>(s.totalRAMBytes > s.usedRAMBytes ? s.totalRAMBytes - s.usedRAMBytes : 0);
+	});
+	alertMetrics_.Add("gpu", s.gpuUsagePercent, &s.gpuHistory, &s.gpuQuantiles);
+	alertMetrics_.Add("gpu.mem.used", s.gpuMemoryUsed);
+	alertMetrics_.Add("disk", s.diskUsagePercent, &s.diskHistory, &s.diskQuantiles);
+	alertMetrics_.Add("disk.read", s.diskReadBytesPerSec);
+	alertMetrics_.Add("disk.write", s.diskWriteBytesPerSec);
+	alertMetrics_.Add("net", s.networkUsagePercent, &s.networkHistory, &s.networkQuantiles);
+	alertMetrics_.Add("net.up", s.uploadBytesPerSec, &s.uploadHistory, &s.uploadQuantiles);
+	alertMetrics_.Add("net.down", s.downloadBytesPerSec, &s.downloadHistory, &s.downloadQuantiles);
+	alertMetrics_.Add("procs", s.totalProcesses);
+	alertMetrics_.Add("threads", s.totalThreads);
+	alertMetrics_.Add("fd.usage", s.fds.maxUsagePercent);
+}
+
+bool DataCollector::AddAlertExpression(const std::string& source, const std::string& title, uint32_t durationSeconds, std::string& error)
+{
+	AlertRule rule;
+	rule.type = AlertRule::EXPRESSION;
+	if (!rule.expression.Compile(source, alertMetrics_, error)) return false;
+	// The rule's value is 1 while the expression holds, so it fires above 0.5 and clears once it is false again
+	rule.threshold = 0.5f;
+	rule.clearThreshold = 0.5f;
+	rule.durationSeconds = durationSeconds;
+	rule.message = title;
+
+	// The built-in rules are only added to an empty list, so they go first
+	if (systemState_.alertRules.empty()) InitializeDefaultAlertRules();
+	systemState_.alertRules.push_back(std::move(rule));
+	return true;
+}
+
 void DataCollector::InitializeDefaultAlertRules()
 {
 	AlertRule cpuRule;
 	cpuRule.type = AlertRule::CPU_USAGE;
 	cpuRule.threshold = 80.0f;
+	cpuRule.clearThreshold = 70.0f;
 	cpuRule.durationSeconds = 30;
 	cpuRule.isEnabled = true;
 	cpuRule.message = "CPU usage is consistently high";
@@ -200,6 +519,7 @@ void DataCollector::InitializeDefaultAlertRules()
 	AlertRule memoryRule;
 	memoryRule.type = AlertRule::MEMORY_USAGE;
 	memoryRule.threshold = 85.0f;
+	memoryRule.clearThreshold = 80.0f;
 	memoryRule.durationSeconds = 60;
 	memoryRule.isEnabled = true;
 	memoryRule.message = "Memory usage is critically high";
@@ -208,6 +528,7 @@ void DataCollector::InitializeDefaultAlertRules()
 	AlertRule diskRule;
 	diskRule.type = AlertRule::DISK_USAGE;
 	diskRule.threshold = 90.0f;
+	diskRule.clearThreshold = 75.0f;
 	diskRule.durationSeconds = 60;
 	diskRule.isEnabled = true;
 	diskRule.message = "Disk activity is very high";
@@ -216,8 +537,290 @@ void DataCollector::InitializeDefaultAlertRules()
 	AlertRule networkRule;
 	networkRule.type = AlertRule::NETWORK_USAGE;
 	networkRule.threshold = 75.0f;
+	networkRule.clearThreshold = 60.0f;
 	networkRule.durationSeconds = 45;
 	networkRule.isEnabled = true;
 	networkRule.message = "Network usage is unusually high";
 	systemState_.alertRules.push_back(networkRule);
-}
\ No newline at end of file
+	
+	AlertRule fdRule;
+	fdRule.type = AlertRule::FD_HEADROOM;
+	fdRule.threshold = 80.0f;
+	fdRule.clearThreshold = 70.0f;
+	fdRule.durationSeconds = 30;
+	fdRule.isEnabled = true;
+	fdRule.message = "A process is running out of file descriptors";
+	systemState_.alertRules.push_back(fdRule);
+}
+
+#ifdef __linux__
+void DataCollector::InitializeLinuxProviders()
+{
+	numaMonitor_ = std::make_unique<LinuxNumaMonitor>();
+	systemState_.numa.isAvailable = numaMonitor_->IsAvailable();
+	systemState_.numa.nodes = numaMonitor_->GetNodes();
+	if (systemState_.numa.isAvailable) {
+		std::cout << "NUMA nodes: " << systemState_.numa.nodes.size() << "\n";
+	}
+
+	// PULSE_FS_REFRESH_SECONDS overrides the filesystem capacity cadence
+	if (const char* refresh = std::getenv("PULSE_FS_REFRESH_SECONDS")) {
+		long seconds = std::strtol(refresh, nullptr, 10);
+		if (seconds > 0) filesystemRefreshInterval_ = std::chrono::seconds(seconds);
+	}
+	filesystemMonitor_ = std::make_unique<LinuxFilesystemMonitor>("/proc", filesystemRefreshInterval_);
+
+	netHealthMonitor_ = std::make_unique<LinuxNetHealthMonitor>();
+	systemState_.networkHealth.isAvailable = netHealthMonitor_->IsAvailable();
+
+	// Sensor discovery happens once here; later ticks only re-read the value files
+	sensorMonitor_ = std::make_unique<LinuxSensorMonitor>();
+	systemState_.sensors = sensorMonitor_->GetSensors();
+	if (!systemState_.sensors.isAvailable) {
+		std::cout << "No hardware sensors found\n";
+	}
+
+	powerMonitor_ = std::make_unique<LinuxPowerMonitor>();
+	systemState_.power = powerMonitor_->GetPower();
+
+	gpuMonitor_ = std::make_unique<LinuxGpuMonitor>();
+	systemState_.gpu = gpuMonitor_->GetGpu();
+	systemState_.gpuName = gpuMonitor_->IsAvailable()
+		? (systemState_.gpu.driver.empty() ? "DRM GPU" : systemState_.gpu.driver)
+		: "No GPU detected";
+	std::cout << "GPU: " << systemState_.gpuName << "\n";
+
+	processMonitor_ = std::make_unique<LinuxProcessMonitor>();
+	if (fdTrackingEnabled_) fdMonitor_ = std::make_unique<LinuxFdMonitor>();
+}
+
+void DataCollector::UpdateLinuxProviders()
+{
+	UpdateProcessMetrics();
+	UpdateNumaMetrics();
+	UpdateFilesystemMetrics();
+	UpdateNetworkHealthMetrics();
+	UpdateSensorMetrics();
+	UpdatePowerMetrics();
+	UpdateGpuMetrics();
+}
+
+void DataCollector::UpdateNumaMetrics()
+{
+	if (!numaMonitor_ || !numaMonitor_->IsAvailable()) return;
+
+	numaMonitor_->Update();
+
+	// The monitor supplies current values, histories live in the shared state
+	const auto& samples = numaMonitor_->GetNodes();
+	auto& nodes = systemState_.numa.nodes;
+	nodes.resize(samples.size());
+	for (size_t i = 0; i < samples.size(); ++i) {
+		const NumaNode& sample = samples[i];
+		NumaNode& node = nodes[i];
+
+		node.id = sample.id;
+		node.cpus = sample.cpus;
+		node.memoryTotal = sample.memoryTotal;
+		node.memoryUsed = sample.memoryUsed;
+		node.memoryUsagePercent = sample.memoryUsagePercent;
+		node.cpuUsagePercent = sample.cpuUsagePercent;
+		node.numaHit = sample.numaHit;
+		node.numaMiss = sample.numaMiss;
+		node.otherNode = sample.otherNode;
+		node.numaHitPerSec = sample.numaHitPerSec;
+		node.numaMissPerSec = sample.numaMissPerSec;
+		node.otherNodePerSec = sample.otherNodePerSec;
+
+		node.cpuHistory.push(node.cpuUsagePercent);
+		node.memoryHistory.push(node.memoryUsagePercent);
+		node.numaHitHistory.push(node.numaHitPerSec);
+		node.numaMissHistory.push(node.numaMissPerSec);
+		node.otherNodeHistory.push(node.otherNodePerSec);
+	}
+
+	// A read finished on the worker; it may be for a process that has been deselected since
+	if (auto placement = numaMonitor_->TakeProcessPlacement()) {
+		if (placement->pid == selectedPid_) {
+			placement->lastUpdateTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+				std::chrono::system_clock::now().time_since_epoch()).count();
+			systemState_.numa.selectedProcess = std::move(*placement);
+		}
+	}
+
+	// numa_maps is expensive for large processes, so refresh the selected one at a slower cadence
+	auto now = std::chrono::steady_clock::now();
+	if (selectedPid_ != 0 && now - lastPlacementUpdate_ >= std::chrono::seconds(5)) {
+		UpdateSelectedProcessPlacement();
+	}
+}
+
+void DataCollector::UpdateFilesystemMetrics()
+{
+	if (!filesystemMonitor_) return;
+
+	bool hasNewSample = filesystemMonitor_->Update();
+
+	// Mounts come and go, so rebuild the list and carry histories over by mount point
+	std::vector<FilesystemInfo> filesystems = filesystemMonitor_->GetFilesystems();
+	for (auto& fs : filesystems) {
+		auto previous = std::find_if(systemState_.filesystems.begin(), systemState_.filesystems.end(),
+			[&fs](const FilesystemInfo& old) { return old.mountPoint == fs.mountPoint; });
+		if (previous != systemState_.filesystems.end()) {
+			fs.usageHistory = previous->usageHistory;
+			fs.inodeHistory = previous->inodeHistory;
+		}
+		if (hasNewSample && fs.hasData && !fs.isStale) {
+			fs.usageHistory.push(fs.usagePercent);
+			fs.inodeHistory.push(fs.inodeUsagePercent);
+		}
+	}
+	systemState_.filesystems = std::move(filesystems);
+}
+
+void DataCollector::UpdateNetworkHealthMetrics()
+{
+	if (!netHealthMonitor_ || !netHealthMonitor_->IsAvailable()) return;
+
+	netHealthMonitor_->Update();
+
+	const NetworkHealth& sample = netHealthMonitor_->GetHealth();
+	NetworkHealth& health = systemState_.networkHealth;
+
+	health.tcpRetransPerSec = sample.tcpRetransPerSec;
+	health.tcpRetransPercent = sample.tcpRetransPercent;
+	health.tcpInErrorsPerSec = sample.tcpInErrorsPerSec;
+	health.listenOverflowsPerSec = sample.listenOverflowsPerSec;
+	health.listenDropsPerSec = sample.listenDropsPerSec;
+	health.synCookiesSentPerSec = sample.synCookiesSentPerSec;
+	health.outOfOrderPerSec = sample.outOfOrderPerSec;
+	health.udpRcvbufErrorsPerSec = sample.udpRcvbufErrorsPerSec;
+	health.udpInErrorsPerSec = sample.udpInErrorsPerSec;
+	health.tcpInUse = sample.tcpInUse;
+	health.tcpTimeWait = sample.tcpTimeWait;
+	health.tcpOrphans = sample.tcpOrphans;
+	health.udpInUse = sample.udpInUse;
+	health.tcpMemoryBytes = sample.tcpMemoryBytes;
+	health.udpMemoryBytes = sample.udpMemoryBytes;
+
+	health.retransHistory.push(health.tcpRetransPerSec);
+	health.listenOverflowHistory.push(health.listenOverflowsPerSec);
+	health.listenDropHistory.push(health.listenDropsPerSec);
+	health.synCookieHistory.push(health.synCookiesSentPerSec);
+	health.outOfOrderHistory.push(health.outOfOrderPerSec);
+	health.udpRcvbufErrorHistory.push(health.udpRcvbufErrorsPerSec);
+	health.socketMemoryHistory.push(static_cast<float>(health.tcpMemoryBytes + health.udpMemoryBytes));
+}
+
+void DataCollector::UpdateSensorMetrics()
+{
+	if (!sensorMonitor_ || !sensorMonitor_->IsAvailable()) return;
+
+	sensorMonitor_->Update();
+
+	// Discovery is fixed at startup, so samples and state line up index for index
+	const SensorStats& sample = sensorMonitor_->GetSensors();
+	SensorStats& sensors = systemState_.sensors;
+
+	auto copyReadings = [](const std::vector<SensorReading>& samples, std::vector<SensorReading>& readings) {
+		for (size_t i = 0; i < samples.size() && i < readings.size(); ++i) {
+			readings[i].value = samples[i].value;
+			readings[i].history.push(readings[i].value);
+		}
+	};
+	copyReadings(sample.temperatures, sensors.temperatures);
+	copyReadings(sample.fans, sensors.fans);
+
+	for (size_t i = 0; i < sample.cpuFrequencies.size() && i < sensors.cpuFrequencies.size(); ++i) {
+		CpuFrequency& cpu = sensors.cpuFrequencies[i];
+		cpu.currentMHz = sample.cpuFrequencies[i].currentMHz;
+		cpu.throttleCount = sample.cpuFrequencies[i].throttleCount;
+		cpu.throttlesPerSec = sample.cpuFrequencies[i].throttlesPerSec;
+		cpu.frequencyHistory.push(cpu.currentMHz);
+		cpu.throttleHistory.push(cpu.throttlesPerSec);
+	}
+}
+
+void DataCollector::UpdatePowerMetrics()
+{
+	if (!powerMonitor_ || !powerMonitor_->IsAvailable()) return;
+
+	powerMonitor_->Update();
+
+	const PowerStats& sample = powerMonitor_->GetPower();
+	PowerStats& power = systemState_.power;
+
+	power.domains = sample.domains;
+	power.packageWatts = sample.packageWatts;
+	power.coreWatts = sample.coreWatts;
+	power.dramWatts = sample.dramWatts;
+	power.joulesPerCpuSecond = sample.joulesPerCpuSecond;
+
+	power.packageHistory.push(power.packageWatts);
+	power.coreHistory.push(power.coreWatts);
+	power.dramHistory.push(power.dramWatts);
+	power.efficiencyHistory.push(power.joulesPerCpuSecond);
+}
+
+void DataCollector::UpdateGpuMetrics()
+{
+	if (!gpuMonitor_ || !gpuMonitor_->IsAvailable()) return;
+
+	gpuMonitor_->Update();
+
+	// Engines only ever get appended, so existing histories stay aligned by index
+	const GpuStats& sample = gpuMonitor_->GetGpu();
+	GpuStats& gpu = systemState_.gpu;
+	gpu.driver = sample.driver;
+	gpu.processes = sample.processes;
+	gpu.engines.resize(sample.engines.size());
+	for (size_t i = 0; i < sample.engines.size(); ++i) {
+		gpu.engines[i].name = sample.engines[i].name;
+		gpu.engines[i].utilizationPercent = sample.engines[i].utilizationPercent;
+		gpu.engines[i].history.push(gpu.engines[i].utilizationPercent);
+	}
+
+	if (!gpu.driver.empty()) systemState_.gpuName = gpu.driver;
+	systemState_.gpuUsagePercent = gpuMonitor_->GetUtilizationPercent();
+	uint64_t now = NowMilliseconds();
+	systemState_.gpuHistory.push(now, systemState_.gpuUsagePercent);
+	systemState_.gpuQuantiles.push(now, systemState_.gpuUsagePercent);
+	systemState_.gpuMemoryUsed = gpuMonitor_->GetMemoryUsed();
+}
+
+void DataCollector::UpdateProcessMetrics()
+{
+	if (!processMonitor_) return;
+
+	processMonitor_->UpdateProcesses();
+	std::vector<ProcessInfo> processes = processMonitor_->GetProcesses();
+	if (fdMonitor_) {
+		fdMonitor_->Update(processes);
+		systemState_.fds = fdMonitor_->GetStats();
+	}
+	systemState_.processes.assign(processes);
+	systemState_.totalProcesses = static_cast<uint32_t>(processMonitor_->GetProcessCount());
+	systemState_.totalThreads = processMonitor_->GetTotalThreads();
+}
+
+void DataCollector::RequestSearchMetadata()
+{
+	// Searching by path or command line needs them for every process; each one is still only read once
+	ProcessFilter::Field field = processFilter_.GetField();
+	if (!processFilter_.IsActive() || (field != ProcessFilter::Field::Any && field != ProcessFilter::Field::Path)) return;
+	for (uint32_t pid : systemState_.processes.pids()) RequestProcessMetadata(pid);
+}
+
+void DataCollector::UpdateSelectedProcessPlacement()
+{
+	auto& placement = systemState_.numa.selectedProcess;
+	if (selectedPid_ == 0 || !numaMonitor_ || !numaMonitor_->IsAvailable()) {
+		placement = NumaProcessPlacement{};
+		return;
+	}
+
+	// Queued on the worker; UpdateNumaMetrics picks the result up once it is read
+	numaMonitor_->RequestProcessPlacement(selectedPid_);
+	lastPlacementUpdate_ = std::chrono::steady_clock::now();
+}
+#endif
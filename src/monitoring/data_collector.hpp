@@ -1,9 +1,24 @@
 #pragma once
 #include "../core/system_state.hpp"
 #include "../core/interfaces/i_system_monitor.hpp"
+#include "anomaly_monitor.hpp"
+#include "process_filter.hpp"
+#include "process_ranking.hpp"
+#include "process_tree.hpp"
 #include <memory>
 #include <chrono>
 
+#ifdef __linux__
+class LinuxNumaMonitor;
+class LinuxFilesystemMonitor;
+class LinuxNetHealthMonitor;
+class LinuxSensorMonitor;
+class LinuxPowerMonitor;
+class LinuxGpuMonitor;
+class LinuxProcessMonitor;
+class LinuxFdMonitor;
+#endif
+
 class DataCollector
 {
 public:
@@ -14,14 +29,93 @@ public:
 	void Update();
 
 	const SystemState& GetSystemState() const { return systemState_; }
+	const ProcessTree& GetProcessTree() const { return processTree_; }
+	const ProcessRanking& GetProcessRanking() const { return processRanking_; }
+
+	// Type-to-filter for the process list; the visible ranking covers only the matches while a query is set
+	void SetProcessFilter(const std::string& query);
+	const ProcessFilter& GetProcessFilter() const { return processFilter_; }
+	const ProcessRanking& GetVisibleProcessRanking() const { return processFilter_.IsActive() ? filteredRanking_ : processRanking_; }
+	// Called by a scrolled table before it reads rows past the default top K
+	void EnsureVisibleRankDepth(ProcessSortKey key, size_t depth);
+
+	// Process the UI is focused on; drives on-demand per-process detail such as NUMA placement
+	void SetSelectedProcess(uint32_t pid);
+	uint32_t GetSelectedProcess() const { return selectedPid_; }
+
+	// Command line, executable, cwd and cgroup are only read for processes that are shown, searched or selected.
+	// Requests are cheap once a process is cached; GetProcessMetadata is nullptr until the background read finishes.
+	void RequestProcessMetadata(uint32_t pid);
+	const ProcessMetadata* GetProcessMetadata(uint32_t pid) const;
+
+	// How often filesystem capacity is re-read; statvfs is comparatively slow and capacity changes slowly
+	void SetFilesystemRefreshInterval(std::chrono::seconds interval);
+
+	// Per-process open-fd counts against RLIMIT_NOFILE; one stat per process per tick, so it can be turned off
+	void SetFdTrackingEnabled(bool enabled);
+	bool IsFdTrackingEnabled() const { return fdTrackingEnabled_; }
+
+	// Raw samples kept per metric history. Histories move to a fresh arena keeping their rollups, percentile
+	// windows and the newest raw samples that still fit; PULSE_HISTORY_SECONDS sets every metric at once.
+	void SetHistoryRetention(const HistoryRetention& retention);
+	const HistoryRetention& GetHistoryRetention() const { return historyRetention_; }
+
+	// Adds an EXPRESSION alert rule such as "avg(cpu, 30s) > 80 and mem.available < 2GiB", raised with title once
+	// the condition has held for durationSeconds. Metric names are listed in GetAlertMetrics(); on a parse error
+	// returns false and describes it in error. PULSE_ALERT_RULES adds ';'-separated expressions at startup.
+	bool AddAlertExpression(const std::string& source, const std::string& title, uint32_t durationSeconds, std::string& error);
+	const MetricTable& GetAlertMetrics() const { return alertMetrics_; }
 
 private:
+	// Declared before systemState_ so the histories that point into it are destroyed first
+	std::unique_ptr<SeriesArena> historyArena_;
+	HistoryRetention historyRetention_;
 	SystemState systemState_;
+	AnomalyMonitor anomalyMonitor_;
+	MetricTable alertMetrics_; // Names alert expressions can use, pointing into systemState_
+	ProcessTree processTree_;
+	ProcessRanking processRanking_;
+	ProcessFilter processFilter_;
+	ProcessRanking filteredRanking_;
 	std::unique_ptr<ISystemMonitor> systemMonitor_;
 
 	std::chrono::steady_clock::time_point lastUpdate_;
+	uint32_t selectedPid_ = 0;
+	std::chrono::seconds filesystemRefreshInterval_{ 30 };
+	bool fdTrackingEnabled_ = true;
+
+#ifdef __linux__
+	std::unique_ptr<LinuxNumaMonitor> numaMonitor_;
+	std::unique_ptr<LinuxFilesystemMonitor> filesystemMonitor_;
+	std::unique_ptr<LinuxNetHealthMonitor> netHealthMonitor_;
+	std::unique_ptr<LinuxSensorMonitor> sensorMonitor_;
+	std::unique_ptr<LinuxPowerMonitor> powerMonitor_;
+	std::unique_ptr<LinuxGpuMonitor> gpuMonitor_;
+	std::unique_ptr<LinuxProcessMonitor> processMonitor_;
+	std::unique_ptr<LinuxFdMonitor> fdMonitor_;
+	std::chrono::steady_clock::time_point lastPlacementUpdate_;
+
+	void InitializeLinuxProviders();
+	void UpdateLinuxProviders();
+	void UpdateNumaMetrics();
+	void UpdateFilesystemMetrics();
+	void UpdateNetworkHealthMetrics();
+	void UpdateSensorMetrics();
+	void UpdatePowerMetrics();
+	void UpdateGpuMetrics();
+	void UpdateProcessMetrics();
+	void UpdateSelectedProcessPlacement();
+	void RequestSearchMetadata();
+#endif
 
 	void UpdateSystemMetrics();
 	void UpdateAlerts();
+	void UpdateAnomalies();
+	void UpdateUserUsage();
+	void UpdateSelectedProcessHistory();
+	void UpdateFilteredRanking();
 	void InitializeDefaultAlertRules();
+	void AllocateHistories();
+	void InitializeAnomalyDetection();
+	void InitializeAlertMetrics();
 };
\ No newline at end of file
@@ -0,0 +1,418 @@
+#include "process_filter.hpp"
+#include "../core/cpu_features.hpp"
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cstring>
+
+namespace
+{
+	inline unsigned LowestBit(unsigned mask)
+	{
+#ifdef _MSC_VER
+		unsigned long index = 0;
+		_BitScanForward(&index, mask);
+		return static_cast<unsigned>(index);
+#else
+		return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+	}
+
+	template<typename T>
+	inline T Load(const char* data)
+	{
+		T value;
+		std::memcpy(&value, data, sizeof(T));
+		return value;
+	}
+
+	// Candidate positions are where the first, second and last needle bytes all match (the SIMD-friendly
+	// variant of strstr), which already settles needles of up to three bytes. Up to 16 bytes, two overlapping
+	// word compares check the rest without a call to memcmp; the scans only test candidates with the whole
+	// needle inside the buffer, so the loads stay in bounds.
+	inline bool Matches(const char* candidate, std::string_view needle)
+	{
+		const size_t k = needle.size();
+		const char* bytes = needle.data();
+		if (k <= 3) return true;
+		if (k <= 8) return Load<uint32_t>(candidate) == Load<uint32_t>(bytes) && Load<uint32_t>(candidate + k - 4) == Load<uint32_t>(bytes + k - 4);
+		if (k <= 16) return Load<uint64_t>(candidate) == Load<uint64_t>(bytes) && Load<uint64_t>(candidate + k - 8) == Load<uint64_t>(bytes + k - 8);
+		return std::memcmp(candidate, bytes, k) == 0;
+	}
+
+	size_t FindScalar(const char* data, size_t length, size_t from, std::string_view needle)
+	{
+		size_t pos = std::string_view(data, length).find(needle, from);
+		return pos == std::string_view::npos ? ProcessStore::npos : pos;
+	}
+
+#ifdef PULSE_X86
+	size_t FindSse2(const char* data, size_t length, size_t from, std::string_view needle)
+	{
+		const size_t k = needle.size();
+		const size_t second = k > 2 ? 1 : 0;
+		const __m128i first = _mm_set1_epi8(needle.front());
+		const __m128i next = _mm_set1_epi8(needle[second]);
+		const __m128i last = _mm_set1_epi8(needle.back());
+
+		size_t i = from;
+		for (; i + 16 + k - 1 <= length; i += 16) {
+			__m128i blockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+			__m128i blockNext = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + second));
+			__m128i blockLast = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + k - 1));
+			__m128i hits = _mm_and_si128(_mm_cmpeq_epi8(blockFirst, first), _mm_cmpeq_epi8(blockLast, last));
+			unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_and_si128(hits, _mm_cmpeq_epi8(blockNext, next))));
+			while (mask != 0) {
+				unsigned bit = LowestBit(mask);
+				if (Matches(data + i + bit, needle)) return i + bit;
+				mask &= mask - 1;
+			}
+		}
+		return FindScalar(data, length, i, needle);
+	}
+
+	PULSE_TARGET_AVX2 size_t FindAvx2(const char* data, size_t length, size_t from, std::string_view needle)
+	{
+		const size_t k = needle.size();
+		const size_t second = k > 2 ? 1 : 0;
+		const __m256i first = _mm256_set1_epi8(needle.front());
+		const __m256i next = _mm256_set1_epi8(needle[second]);
+		const __m256i last = _mm256_set1_epi8(needle.back());
+
+		size_t i = from;
+		for (; i + 32 + k - 1 <= length; i += 32) {
+			__m256i blockFirst = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+			__m256i blockNext = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + second));
+			__m256i blockLast = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + k - 1));
+			__m256i hits = _mm256_and_si256(_mm256_cmpeq_epi8(blockFirst, first), _mm256_cmpeq_epi8(blockLast, last));
+			unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_and_si256(hits, _mm256_cmpeq_epi8(blockNext, next))));
+			while (mask != 0) {
+				unsigned bit = LowestBit(mask);
+				if (Matches(data + i + bit, needle)) return i + bit;
+				mask &= mask - 1;
+			}
+		}
+		return FindSse2(data, length, i, needle);
+	}
+#endif
+
+	// Marking kernels: set hits[id] for every string of the index that contains needle, scanning from byte `from`
+	// of string `id`. Strings are '\n'-terminated and the needle never contains '\n', so a match lies inside the
+	// string it starts in, and its id is the number of '\n' before it, counted a block at a time.
+	void MarkScalar(const char* text, size_t length, size_t from, uint32_t id, std::string_view needle, uint8_t* hits)
+	{
+		std::string_view table(text, length);
+		size_t pos = from;
+		while ((pos = table.find(needle, pos)) != std::string_view::npos) {
+			id += static_cast<uint32_t>(std::count(text + from, text + pos, '\n'));
+			hits[id] = 1;
+			from = pos++;
+		}
+	}
+
+#ifdef PULSE_X86
+	// A block with at least one candidate, set aside during the scan. Testing candidates as the scan meets them
+	// costs a misprediction or two per hit, which is most of the time for a broad query like "c" or "renderer";
+	// the scan itself stays branch-free and the candidates are tested in a batch afterwards.
+	struct Candidates
+	{
+		uint32_t offset;   // First byte of the block
+		uint32_t mask;     // Candidate positions in the block
+		uint32_t newlines; // '\n' positions in the block
+		uint32_t id;       // String id at the first byte
+	};
+
+	constexpr size_t CandidateBatch = 128;
+
+	void MarkCandidates(const char* text, std::string_view needle, const Candidates* batch, size_t count, uint8_t* hits)
+	{
+		for (size_t i = 0; i < count; ++i) {
+			Candidates block = batch[i];
+			do {
+				unsigned bit = LowestBit(block.mask);
+				if (Matches(text + block.offset + bit, needle)) hits[block.id + std::popcount(block.newlines & ((1u << bit) - 1))] = 1;
+				block.mask &= block.mask - 1;
+			} while (block.mask != 0);
+		}
+	}
+
+	void MarkSse2(const char* text, size_t length, size_t from, uint32_t id, std::string_view needle, uint8_t* hits)
+	{
+		const size_t k = needle.size();
+		const size_t second = k > 2 ? 1 : 0;
+		const __m128i first = _mm_set1_epi8(needle.front());
+		const __m128i next = _mm_set1_epi8(needle[second]);
+		const __m128i last = _mm_set1_epi8(needle.back());
+		const __m128i newline = _mm_set1_epi8('\n');
+
+		Candidates batch[CandidateBatch];
+		size_t i = from;
+		while (i + 16 + k - 1 <= length) {
+			size_t count = 0;
+			for (size_t block = 0; block < CandidateBatch && i + 16 + k - 1 <= length; ++block, i += 16) {
+				__m128i blockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i));
+				__m128i blockNext = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i + second));
+				__m128i blockLast = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i + k - 1));
+				__m128i candidates = _mm_and_si128(_mm_cmpeq_epi8(blockFirst, first), _mm_cmpeq_epi8(blockLast, last));
+				unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_and_si128(candidates, _mm_cmpeq_epi8(blockNext, next))));
+				unsigned newlines = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(blockFirst, newline)));
+				batch[count] = { static_cast<uint32_t>(i), mask, newlines, id };
+				count += mask != 0;
+				id += std::popcount(newlines);
+			}
+			MarkCandidates(text, needle, batch, count, hits);
+		}
+		MarkScalar(text, length, i, id, needle, hits);
+	}
+
+	PULSE_TARGET_AVX2 void MarkAvx2(const char* text, size_t length, size_t from, uint32_t id, std::string_view needle, uint8_t* hits)
+	{
+		const size_t k = needle.size();
+		const size_t second = k > 2 ? 1 : 0;
+		const __m256i first = _mm256_set1_epi8(needle.front());
+		const __m256i next = _mm256_set1_epi8(needle[second]);
+		const __m256i last = _mm256_set1_epi8(needle.back());
+		const __m256i newline = _mm256_set1_epi8('\n');
+
+		Candidates batch[CandidateBatch];
+		size_t i = from;
+		while (i + 32 + k - 1 <= length) {
+			size_t count = 0;
+			for (size_t block = 0; block < CandidateBatch && i + 32 + k - 1 <= length; ++block, i += 32) {
+				__m256i blockFirst = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + i));
+				__m256i blockNext = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + i + second));
+				__m256i blockLast = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + i + k - 1));
+				__m256i candidates = _mm256_and_si256(_mm256_cmpeq_epi8(blockFirst, first), _mm256_cmpeq_epi8(blockLast, last));
+				unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_and_si256(candidates, _mm256_cmpeq_epi8(blockNext, next))));
+				unsigned newlines = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(blockFirst, newline)));
+				batch[count] = { static_cast<uint32_t>(i), mask, newlines, id };
+				count += mask != 0;
+				id += std::popcount(newlines);
+			}
+			MarkCandidates(text, needle, batch, count, hits);
+		}
+		MarkSse2(text, length, i, id, needle, hits);
+	}
+#endif
+
+	using FindFunction = size_t (*)(const char*, size_t, size_t, std::string_view);
+
+	FindFunction SelectFind()
+	{
+#ifdef PULSE_X86
+		return CpuFeatures::HasAvx2() ? FindAvx2 : FindSse2;
+#else
+		return FindScalar;
+#endif
+	}
+
+	using MarkFunction = void (*)(const char*, size_t, size_t, uint32_t, std::string_view, uint8_t*);
+
+	MarkFunction SelectMark()
+	{
+#ifdef PULSE_X86
+		return CpuFeatures::HasAvx2() ? MarkAvx2 : MarkSse2;
+#else
+		return MarkScalar;
+#endif
+	}
+
+	void MarkStrings(const std::string& text, std::string_view needle, uint8_t* hits)
+	{
+		static const MarkFunction mark = SelectMark();
+		mark(text.data(), text.size(), 0, 0, needle, hits);
+	}
+
+	bool IsDigits(const std::string& text)
+	{
+		return !text.empty() && std::all_of(text.begin(), text.end(), [](char c) { return c >= '0' && c <= '9'; });
+	}
+}
+
+size_t ProcessFilter::FindNext(const char* data, size_t length, size_t from, std::string_view needle)
+{
+	static const FindFunction find = SelectFind();
+	if (needle.empty() || from >= length || length - from < needle.size()) return ProcessStore::npos;
+	return find(data, length, from, needle);
+}
+
+void ProcessFilter::Update(const ProcessStore& processes)
+{
+	IndexStrings(processes);
+	IndexPids(processes);
+	++snapshot_;
+	Apply(processes, false);
+}
+
+void ProcessFilter::SetQuery(const ProcessStore& processes, const std::string& query)
+{
+	if (query == query_ && snapshot_ != 0) return;
+
+	std::string needle;
+	Field field = ParseQuery(query, needle);
+
+	// Every string containing "chrom" also contains "chr", so a longer query only has to look at the old hits
+	bool refine = !needle_.empty() && field == field_ && matchedSnapshot_ == snapshot_ && snapshot_ != 0
+		&& needle.find(needle_) != std::string::npos;
+
+	query_ = query;
+	needle_ = std::move(needle);
+	field_ = field;
+
+	if (snapshot_ == 0) {
+		Update(processes);
+	} else {
+		Apply(processes, refine);
+	}
+}
+
+void ProcessFilter::IndexStrings(const ProcessStore& processes)
+{
+	const StringInterner& strings = processes.strings();
+
+	// Ids only ever grow until a compaction renumbers them, so normally only new strings are appended
+	if (offsets_.empty() || processes.stringGeneration() != indexedGeneration_ || strings.size() + 1 < offsets_.size()) {
+		text_.clear();
+		offsets_.assign(1, 0);
+		indexedGeneration_ = processes.stringGeneration();
+	}
+
+	for (size_t id = offsets_.size() - 1; id < strings.size(); ++id) {
+		for (char c : strings.get(static_cast<uint32_t>(id))) {
+			if (c == '\n') c = ' ';
+			text_ += (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+		}
+		text_ += '\n';
+		offsets_.push_back(static_cast<uint32_t>(text_.size()));
+	}
+}
+
+void ProcessFilter::IndexPids(const ProcessStore& processes)
+{
+	pidText_.assign(processes.size() * PidSlot, '\n');
+	for (size_t row = 0; row < processes.size(); ++row) {
+		char* slot = pidText_.data() + row * PidSlot;
+		std::to_chars(slot, slot + PidSlot - 1, processes.pid(row));
+	}
+}
+
+void ProcessFilter::Apply(const ProcessStore& processes, bool refine)
+{
+	matchedSnapshot_ = snapshot_;
+	if (needle_.empty()) {
+		matches_.clear();
+		return;
+	}
+
+	bool anyStringHit = refine;
+	size_t stringCount = offsets_.size() - 1;
+	if (field_ == Field::Pid) {
+		stringHits_.assign(stringCount, 0);
+	} else if (refine && static_cast<size_t>(std::count(stringHits_.begin(), stringHits_.end(), 1)) * 8 < stringCount) {
+		// Re-checking each old hit on its own only pays while they are few; after a broad first keystroke like "c",
+		// one more pass over the whole table is cheaper than a search per string
+		for (size_t id = 0; id < stringCount; ++id) {
+			if (stringHits_[id] && FindNext(text_.data(), offsets_[id + 1], offsets_[id], needle_) == ProcessStore::npos) {
+				stringHits_[id] = 0;
+			}
+		}
+	} else {
+		stringHits_.assign(stringCount, 0);
+		MarkStrings(text_, needle_, stringHits_.data());
+		anyStringHit = refine || std::memchr(stringHits_.data(), 1, stringCount) != nullptr;
+	}
+
+	bool checkPid = (field_ == Field::Any || field_ == Field::Pid) && IsDigits(needle_);
+	if (checkPid && refine && pidHits_.size() == processes.size()) {
+		for (uint32_t row : matches_) pidHits_[row] = PidMatches(row);
+	} else if (checkPid) {
+		// Fixed-width slots, so a hit maps straight to its row
+		pidHits_.assign(processes.size(), 0);
+		size_t pos = 0;
+		while ((pos = FindNext(pidText_.data(), pidText_.size(), pos, needle_)) != ProcessStore::npos) {
+			size_t row = pos / PidSlot;
+			pidHits_[row] = 1;
+			pos = (row + 1) * PidSlot;
+		}
+	}
+
+	if (refine) {
+		matches_.erase(std::remove_if(matches_.begin(), matches_.end(),
+			[this, &processes, checkPid](uint32_t row) { return !RowMatches(processes, row, checkPid); }), matches_.end());
+		return;
+	}
+
+	matches_.clear();
+	if (!anyStringHit && !checkPid) return;
+
+	// One branch-free pass over the dense id columns: every column is read and masked by whether its field is
+	// searched, and each row is stored and kept only if it matched, so scattered hits cost no mispredictions
+	const uint8_t* hits = stringHits_.data();
+	const uint32_t* names = processes.nameIds().data();
+	const uint32_t* paths = processes.filePathIds().data();
+	const uint32_t* commands = processes.commandLineIds().data();
+	const uint32_t* users = processes.userNameIds().data();
+	const uint8_t nameMask = anyStringHit && (field_ == Field::Any || field_ == Field::Name) ? 1 : 0;
+	const uint8_t pathMask = anyStringHit && (field_ == Field::Any || field_ == Field::Path) ? 1 : 0;
+	const uint8_t userMask = anyStringHit && (field_ == Field::Any || field_ == Field::User) ? 1 : 0;
+	if (!checkPid) pidHits_.assign(processes.size(), 0);
+	const uint8_t* pids = pidHits_.data();
+
+	matches_.resize(processes.size());
+	size_t count = 0;
+	for (size_t row = 0; row < processes.size(); ++row) {
+		uint8_t match = (hits[names[row]] & nameMask) | ((hits[paths[row]] | hits[commands[row]]) & pathMask)
+			| (hits[users[row]] & userMask) | pids[row];
+		matches_[count] = static_cast<uint32_t>(row);
+		count += match;
+	}
+	matches_.resize(count);
+}
+
+bool ProcessFilter::RowMatches(const ProcessStore& processes, size_t row, bool checkPid) const
+{
+	auto hit = [this](uint32_t id) { return id < stringHits_.size() && stringHits_[id]; };
+
+	if ((field_ == Field::Any || field_ == Field::Name) && hit(processes.nameId(row))) return true;
+	if ((field_ == Field::Any || field_ == Field::Path) && (hit(processes.filePathId(row)) || hit(processes.commandLineId(row)))) return true;
+	if ((field_ == Field::Any || field_ == Field::User) && hit(processes.userNameId(row))) return true;
+	return checkPid && row < pidHits_.size() && pidHits_[row];
+}
+
+bool ProcessFilter::PidMatches(size_t row) const
+{
+	if (row * PidSlot >= pidText_.size()) return false;
+	const char* slot = pidText_.data() + row * PidSlot;
+	return std::string_view(slot, PidSlot).find(needle_) != std::string_view::npos;
+}
+
+ProcessFilter::Field ProcessFilter::ParseQuery(const std::string& query, std::string& needle)
+{
+	static const std::pair<const char*, Field> prefixes[] = {
+		{ "name:", Field::Name }, { "path:", Field::Path }, { "cmd:", Field::Path },
+		{ "user:", Field::User }, { "pid:", Field::Pid }
+	};
+
+	std::string lowered;
+	lowered.reserve(query.size());
+	for (char c : query) {
+		if (c == '\n') continue;
+		lowered += (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+	}
+
+	Field field = Field::Any;
+	for (const auto& [prefix, prefixField] : prefixes) {
+		size_t length = std::strlen(prefix);
+		if (lowered.compare(0, length, prefix) == 0) {
+			lowered.erase(0, length);
+			field = prefixField;
+			break;
+		}
+	}
+
+	// Surrounding spaces are almost always accidental in a search box
+	size_t begin = lowered.find_first_not_of(' ');
+	size_t end = lowered.find_last_not_of(' ');
+	needle = begin == std::string::npos ? std::string() : lowered.substr(begin, end - begin + 1);
+	return field;
+}
@@ -0,0 +1,64 @@
+// ProcessFilter: Type-to-filter over the process list by name, path, user or PID.
+// Matching runs over one contiguous lowercase copy of the intern table, so each distinct string is searched
+// once no matter how many processes share it; a query that extends the previous one only re-checks its matches.
+#pragma once
+#include "../core/process_store.hpp"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class ProcessFilter
+{
+public:
+	enum class Field
+	{
+		Any,
+		Name,
+		Path, // Executable path or command line
+		User,
+		Pid
+	};
+
+	// Brings the index up to date with a new snapshot and re-applies the current query to it
+	void Update(const ProcessStore& processes);
+
+	// Accepts an optional "name:", "path:"/"cmd:", "user:" or "pid:" prefix; matching is case-insensitive
+	void SetQuery(const ProcessStore& processes, const std::string& query);
+	const std::string& GetQuery() const { return query_; }
+	Field GetField() const { return field_; }
+
+	bool IsActive() const { return !needle_.empty(); }
+
+	// Matching rows of the last snapshot, ascending
+	const std::vector<uint32_t>& GetMatches() const { return matches_; }
+
+	// First occurrence of needle in [data + from, data + length), or npos; SSE2/AVX2 where available
+	static size_t FindNext(const char* data, size_t length, size_t from, std::string_view needle);
+
+private:
+	static constexpr size_t PidSlot = 12;   // Up to 10 digits plus padding, so a needle never spans two pids
+
+	std::string query_;
+	std::string needle_;   // Lowercased query without its field prefix
+	Field field_ = Field::Any;
+	std::vector<uint32_t> matches_;
+
+	// Index over the intern table: text_ holds every string lowercased and '\n'-terminated,
+	// string id i spanning [offsets_[i], offsets_[i + 1])
+	std::string text_;
+	std::vector<uint32_t> offsets_;
+	uint64_t indexedGeneration_ = 0;
+	std::string pidText_;           // One PidSlot per row
+	std::vector<uint8_t> stringHits_;  // Per string id
+	std::vector<uint8_t> pidHits_;     // Per row
+	uint64_t snapshot_ = 0;         // Bumped by Update; refinement is only valid within one snapshot
+	uint64_t matchedSnapshot_ = 0;
+
+	void IndexStrings(const ProcessStore& processes);
+	void IndexPids(const ProcessStore& processes);
+	void Apply(const ProcessStore& processes, bool refine);
+	bool RowMatches(const ProcessStore& processes, size_t row, bool checkPid) const;
+	bool PidMatches(size_t row) const;
+	static Field ParseQuery(const std::string& query, std::string& needle);
+};
@@ -0,0 +1,117 @@
+#include "process_ranking.hpp"
+#include <algorithm>
+#include <cctype>
+#include <numeric>
+
+void ProcessRanking::Rebuild(const ProcessStore& processes)
+{
+	scratch_.resize(processes.size());
+	std::iota(scratch_.begin(), scratch_.end(), 0u);
+	RankScratch(processes);
+}
+
+void ProcessRanking::Rebuild(const ProcessStore& processes, const std::vector<uint32_t>& rows)
+{
+	scratch_.assign(rows.begin(), rows.end());
+	RankScratch(processes);
+}
+
+void ProcessRanking::RankScratch(const ProcessStore& processes)
+{
+	for (size_t k = 0; k < orders_.size(); ++k) {
+		Order& order = orders_[k];
+		order.rows.assign(scratch_.begin(), scratch_.end());
+		order.sorted = 0;
+		SortPrefix(processes, static_cast<ProcessSortKey>(k), std::max(topCount_, order.depth));
+	}
+}
+
+void ProcessRanking::EnsureDepth(const ProcessStore& processes, ProcessSortKey key, size_t depth)
+{
+	Order& order = orders_[static_cast<size_t>(key)];
+	order.depth = depth;
+	if (depth > order.sorted) SortPrefix(processes, key, depth);
+}
+
+void ProcessRanking::SortPrefix(const ProcessStore& processes, ProcessSortKey key, size_t depth)
+{
+	Order& order = orders_[static_cast<size_t>(key)];
+	size_t keep = std::min(depth, order.rows.size());
+	if (keep <= order.sorted) return;
+
+	// partial_sort is O(n log K): only the rows that get shown are ever fully ordered. Everything past
+	// the sorted prefix already ranks below it, so extending only has to sort the remainder.
+	auto before = [&processes, key](uint32_t a, uint32_t b) { return Before(processes, a, b, key); };
+	std::partial_sort(order.rows.begin() + order.sorted, order.rows.begin() + keep, order.rows.end(), before);
+	order.sorted = keep;
+}
+
+size_t ProcessRanking::GetFirst(ProcessSortKey key) const
+{
+	auto top = GetTop(key);
+	return top.empty() ? ProcessStore::npos : top.front();
+}
+
+int ProcessRanking::CompareNoCase(const std::string& a, const std::string& b)
+{
+	size_t length = std::min(a.size(), b.size());
+	for (size_t i = 0; i < length; ++i) {
+		int x = std::tolower(static_cast<unsigned char>(a[i]));
+		int y = std::tolower(static_cast<unsigned char>(b[i]));
+		if (x != y) return x - y;
+	}
+	return a.size() < b.size() ? -1 : (a.size() > b.size() ? 1 : 0);
+}
+
+const char* ProcessRanking::GetKeyName(ProcessSortKey key)
+{
+	switch (key) {
+	case ProcessSortKey::Cpu: return "CPU";
+	case ProcessSortKey::Memory: return "Memory";
+	case ProcessSortKey::Io: return "I/O";
+	case ProcessSortKey::Pid: return "PID";
+	case ProcessSortKey::Name: return "Name";
+	case ProcessSortKey::FdUsage: return "FD %";
+	default: return "";
+	}
+}
+
+bool ProcessRanking::Before(const ProcessStore& processes, uint32_t a, uint32_t b, ProcessSortKey key)
+{
+	// Ties fall back to PID so rows don't swap places between updates
+	switch (key) {
+	case ProcessSortKey::Cpu: {
+		const auto& cpu = processes.cpuColumn();
+		if (cpu[a] != cpu[b]) return cpu[a] > cpu[b];
+		break;
+	}
+	case ProcessSortKey::Memory: {
+		const auto& memory = processes.memoryColumn();
+		if (memory[a] != memory[b]) return memory[a] > memory[b];
+		break;
+	}
+	case ProcessSortKey::Io: {
+		uint64_t ioA = processes.ioReadBytesPerSec(a) + processes.ioWriteBytesPerSec(a);
+		uint64_t ioB = processes.ioReadBytesPerSec(b) + processes.ioWriteBytesPerSec(b);
+		if (ioA != ioB) return ioA > ioB;
+		break;
+	}
+	case ProcessSortKey::FdUsage: {
+		// Processes without a known limit report a negative share and sink to the bottom
+		float usageA = processes.fdUsagePercent(a);
+		float usageB = processes.fdUsagePercent(b);
+		if (usageA != usageB) return usageA > usageB;
+		break;
+	}
+	case ProcessSortKey::Name:
+		// Same interned id means same name, so most comparisons skip the string walk.
+		// Case-insensitive so "chrome" and "Code.exe" sort the way people read them
+		if (processes.nameId(a) != processes.nameId(b)) {
+			if (int cmp = CompareNoCase(processes.name(a), processes.name(b)); cmp != 0) return cmp < 0;
+		}
+		break;
+	default:
+		break;
+	}
+	return processes.pid(a) < processes.pid(b);
+}
@@ -0,0 +1,70 @@
+// ProcessRanking: Top-K process order per sortable column, rebuilt once per collector update.
+// Frames read the rankings as indices into SystemState::processes, so rendering never copies or sorts.
+// Scrolling past the top K extends that one column's sorted prefix on demand, and later rebuilds keep the depth.
+#pragma once
+#include "../core/system_state.hpp"
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+enum class ProcessSortKey
+{
+	Cpu,
+	Memory,
+	Io,
+	Pid,
+	Name,
+	FdUsage,
+	Count
+};
+
+class ProcessRanking
+{
+public:
+	explicit ProcessRanking(size_t topCount = 50) : topCount_(topCount) {}
+
+	void SetTopCount(size_t topCount) { topCount_ = topCount; }
+	size_t GetTopCount() const { return topCount_; }
+
+	// Must be called whenever the process list changes; indices refer to rows of that exact store
+	void Rebuild(const ProcessStore& processes);
+	// Ranks only the given rows, e.g. the matches of a filter
+	void Rebuild(const ProcessStore& processes, const std::vector<uint32_t>& rows);
+
+	// Indices into the process list, best first: highest CPU/memory/I/O/fd-limit share, lowest PID, name A-Z
+	std::span<const uint32_t> GetTop(ProcessSortKey key) const
+	{
+		const Order& order = orders_[static_cast<size_t>(key)];
+		return { order.rows.data(), order.sorted };
+	}
+
+	// Rows ranked for this column in total (GetTop only covers the sorted prefix)
+	size_t GetCandidateCount() const { return orders_[0].rows.size(); }
+
+	// Makes GetTop(key) cover at least `depth` rows; processes must be the store of the last rebuild
+	void EnsureDepth(const ProcessStore& processes, ProcessSortKey key, size_t depth);
+
+	// Row of the leader for a column (summary cards); ProcessStore::npos when there are no processes
+	size_t GetFirst(ProcessSortKey key) const;
+
+	static const char* GetKeyName(ProcessSortKey key);
+
+private:
+	struct Order
+	{
+		std::vector<uint32_t> rows; // All candidates; [0, sorted) is in final order, the rest ranks below it
+		size_t sorted = 0;
+		size_t depth = 0;           // Prefix the view last asked for, re-sorted on every rebuild
+	};
+
+	size_t topCount_;
+	std::array<Order, static_cast<size_t>(ProcessSortKey::Count)> orders_;
+	std::vector<uint32_t> scratch_; // Reused between rebuilds so steady state doesn't allocate
+
+	void RankScratch(const ProcessStore& processes);
+	void SortPrefix(const ProcessStore& processes, ProcessSortKey key, size_t depth);
+	static bool Before(const ProcessStore& processes, uint32_t a, uint32_t b, ProcessSortKey key);
+	static int CompareNoCase(const std::string& a, const std::string& b);
+};
@@ -0,0 +1,237 @@
+#include "process_tree.hpp"
+#include <algorithm>
+#include <cctype>
+#include <unordered_set>
+
+ProcessTotals& ProcessTotals::operator+=(const ProcessTotals& other)
+{
+	cpuUsagePercent += other.cpuUsagePercent;
+	memoryBytes += other.memoryBytes;
+	ioReadBytesPerSec += other.ioReadBytesPerSec;
+	ioWriteBytesPerSec += other.ioWriteBytesPerSec;
+	threadCount += other.threadCount;
+	processCount += other.processCount;
+	return *this;
+}
+
+ProcessTotals& ProcessTotals::operator-=(const ProcessTotals& other)
+{
+	cpuUsagePercent -= other.cpuUsagePercent;
+	memoryBytes -= other.memoryBytes;
+	ioReadBytesPerSec -= other.ioReadBytesPerSec;
+	ioWriteBytesPerSec -= other.ioWriteBytesPerSec;
+	threadCount -= other.threadCount;
+	processCount -= other.processCount;
+	return *this;
+}
+
+void ProcessTree::Update(const ProcessStore& processes)
+{
+	std::unordered_map<uint32_t, size_t> current;
+	current.reserve(processes.size());
+	for (size_t i = 0; i < processes.size(); ++i) current.emplace(processes.pid(i), i);
+
+	size_t changes = 0;
+	bool shapeChanged = false;
+	std::vector<uint32_t> toAttach;
+
+	// 1. Exited processes leave the tree; their children are detached and re-attached in step 4,
+	//    which is where the OS has reparented them to (init, a subreaper, or nothing on Windows)
+	std::vector<uint32_t> exited;
+	for (const auto& [pid, node] : nodes_) {
+		if (current.count(pid) == 0) exited.push_back(pid);
+	}
+	for (uint32_t pid : exited) {
+		Node& node = nodes_[pid];
+		Detach(node);
+		for (uint32_t childPid : node.children) {
+			Node& child = nodes_[childPid];
+			child.isAttached = false;
+			toAttach.push_back(childPid);
+		}
+		nodes_.erase(pid);
+		++changes;
+		shapeChanged = true;
+	}
+
+	// 2. Existing processes: a moved process carries its whole subtree to the new parent,
+	//    a changed one only pushes the difference up its ancestors
+	for (auto& [pid, node] : nodes_) {
+		size_t row = current[pid];
+		ProcessTotals totals = TotalsOf(processes, row);
+		bool moved = processes.parentPid(row) != node.parentPid;
+		bool changed = !(totals == node.self);
+		node.status = processes.status(row);
+		bool renamed = node.name != processes.name(row); // exec() into another program
+		if (!moved && !changed && !renamed) continue;
+		++changes;
+		shapeChanged = shapeChanged || moved || renamed;
+
+		if (moved && node.isAttached) {
+			Detach(node);
+			toAttach.push_back(pid);
+		}
+		node.parentPid = processes.parentPid(row);
+		node.name = processes.name(row);
+
+		if (changed) {
+			ProcessTotals delta = totals;
+			delta -= node.self;
+			node.self = totals;
+			node.subtree += delta;
+			if (node.isAttached) AddToAncestors(node.parentPid, delta, false);
+		}
+	}
+
+	// 3. New processes
+	for (size_t row = 0; row < processes.size(); ++row) {
+		uint32_t pid = processes.pid(row);
+		if (nodes_.count(pid)) continue;
+		Node& node = nodes_[pid];
+		node.pid = pid;
+		node.parentPid = processes.parentPid(row);
+		node.name = processes.name(row);
+		node.status = processes.status(row);
+		node.self = TotalsOf(processes, row);
+		node.subtree = node.self;
+		toAttach.push_back(pid);
+		++changes;
+		shapeChanged = true;
+	}
+
+	// 4. Link everything that is waiting for a parent. A new parent may itself be new this tick,
+	//    which is fine since its own totals were already set in step 3.
+	for (uint32_t pid : toAttach) {
+		auto it = nodes_.find(pid);
+		if (it != nodes_.end() && !it->second.isAttached) Attach(it->second);
+	}
+
+	// Roots and family markers only need rebuilding when the shape changed
+	if (shapeChanged) {
+		roots_.clear();
+		for (auto& [pid, node] : nodes_) {
+			if (!node.isAttached) roots_.push_back(pid);
+			UpdateFamilyRoot(node);
+		}
+	}
+	if (changes > 0) SortByWeight();
+	lastChangeCount_ = changes;
+}
+
+void ProcessTree::SortByWeight()
+{
+	// Heaviest subtrees first at every level, so the view can walk the tree without sorting per frame
+	auto heavier = [this](uint32_t a, uint32_t b) {
+		const ProcessTotals& x = nodes_.at(a).subtree;
+		const ProcessTotals& y = nodes_.at(b).subtree;
+		if (x.cpuUsagePercent != y.cpuUsagePercent) return x.cpuUsagePercent > y.cpuUsagePercent;
+		if (x.memoryBytes != y.memoryBytes) return x.memoryBytes > y.memoryBytes;
+		return a < b;
+	};
+	std::sort(roots_.begin(), roots_.end(), heavier);
+	for (auto& [pid, node] : nodes_) {
+		if (node.children.size() > 1) std::sort(node.children.begin(), node.children.end(), heavier);
+	}
+}
+
+const ProcessTree::Node* ProcessTree::Find(uint32_t pid) const
+{
+	auto it = nodes_.find(pid);
+	return it != nodes_.end() ? &it->second : nullptr;
+}
+
+void ProcessTree::Attach(Node& node)
+{
+	auto parent = nodes_.find(node.parentPid);
+	if (node.parentPid == 0 || node.parentPid == node.pid || parent == nodes_.end() || WouldCycle(node.pid, node.parentPid)) {
+		node.isAttached = false;
+		return;
+	}
+	parent->second.children.push_back(node.pid);
+	node.isAttached = true;
+	AddToAncestors(node.parentPid, node.subtree, false);
+}
+
+void ProcessTree::Detach(Node& node)
+{
+	if (!node.isAttached) return;
+	auto parent = nodes_.find(node.parentPid);
+	if (parent != nodes_.end()) {
+		auto& siblings = parent->second.children;
+		siblings.erase(std::remove(siblings.begin(), siblings.end(), node.pid), siblings.end());
+	}
+	AddToAncestors(node.parentPid, node.subtree, true);
+	node.isAttached = false;
+}
+
+void ProcessTree::AddToAncestors(uint32_t parentPid, const ProcessTotals& delta, bool subtract)
+{
+	uint32_t pid = parentPid;
+	while (true) {
+		auto it = nodes_.find(pid);
+		if (it == nodes_.end()) return;
+		Node& ancestor = it->second;
+		if (subtract) ancestor.subtree -= delta;
+		else ancestor.subtree += delta;
+		if (!ancestor.isAttached) return;
+		pid = ancestor.parentPid;
+	}
+}
+
+bool ProcessTree::WouldCycle(uint32_t pid, uint32_t parentPid) const
+{
+	// Windows keeps the parent pid of a dead parent, which can be reused by one of our own descendants
+	uint32_t ancestor = parentPid;
+	while (true) {
+		if (ancestor == pid) return true;
+		auto it = nodes_.find(ancestor);
+		if (it == nodes_.end() || !it->second.isAttached) return false;
+		ancestor = it->second.parentPid;
+	}
+}
+
+void ProcessTree::UpdateFamilyRoot(Node& node)
+{
+	std::string family;
+	if (!IsFamilyName(node.name, &family)) {
+		node.isFamilyRoot = false;
+		return;
+	}
+
+	// Only the topmost member of a family is its root; nested make/chrome children roll up into it
+	std::string parentFamily;
+	auto parent = node.isAttached ? nodes_.find(node.parentPid) : nodes_.end();
+	node.isFamilyRoot = parent == nodes_.end() || !IsFamilyName(parent->second.name, &parentFamily) || parentFamily != family;
+}
+
+bool ProcessTree::IsFamilyName(const std::string& name, std::string* family)
+{
+	static const std::unordered_map<std::string, std::string> families = {
+		{ "make", "make" }, { "gmake", "make" }, { "mingw32-make", "make" },
+		{ "bazel", "bazel" }, { "bazelisk", "bazel" },
+		{ "chrome", "browser" }, { "chromium", "browser" }, { "chromium-browse", "browser" },
+		{ "firefox", "browser" }, { "msedge", "browser" }, { "brave", "browser" }
+	};
+
+	// Windows image names carry ".exe"
+	std::string key = name;
+	if (key.size() > 4 && key.compare(key.size() - 4, 4, ".exe") == 0) key.resize(key.size() - 4);
+	std::transform(key.begin(), key.end(), key.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+	auto it = families.find(key);
+	if (it == families.end()) return false;
+	if (family) *family = it->second;
+	return true;
+}
+
+ProcessTotals ProcessTree::TotalsOf(const ProcessStore& processes, size_t row)
+{
+	ProcessTotals totals;
+	totals.cpuUsagePercent = processes.cpuUsagePercent(row);
+	totals.memoryBytes = static_cast<int64_t>(processes.memoryUsage(row));
+	totals.ioReadBytesPerSec = static_cast<int64_t>(processes.ioReadBytesPerSec(row));
+	totals.ioWriteBytesPerSec = static_cast<int64_t>(processes.ioWriteBytesPerSec(row));
+	totals.threadCount = processes.threadCount(row);
+	totals.processCount = 1;
+	return totals;
+}
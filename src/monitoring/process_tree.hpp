@@ -0,0 +1,64 @@
+// ProcessTree: Parent/child view of the process list with subtree totals kept up to date incrementally.
+// Each tick only processes whose values or parent changed push a delta up their ancestor chain.
+#pragma once
+#include "../core/system_state.hpp"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct ProcessTotals
+{
+	double cpuUsagePercent = 0.0; // double so repeated +/- deltas don't drift
+	int64_t memoryBytes = 0;
+	int64_t ioReadBytesPerSec = 0;
+	int64_t ioWriteBytesPerSec = 0;
+	int64_t threadCount = 0;
+	int64_t processCount = 0;
+
+	ProcessTotals& operator+=(const ProcessTotals& other);
+	ProcessTotals& operator-=(const ProcessTotals& other);
+	bool operator==(const ProcessTotals& other) const = default;
+};
+
+class ProcessTree
+{
+public:
+	struct Node
+	{
+		uint32_t pid = 0;
+		uint32_t parentPid = 0;   // As reported; 0 or a pid not in the tree makes this node a root
+		bool isAttached = false;  // Linked under parentPid (false for roots)
+		std::string name;
+		std::string status;
+		ProcessTotals self;
+		ProcessTotals subtree;    // self + all descendants
+		std::vector<uint32_t> children;
+		bool isFamilyRoot = false; // Top of a make/bazel/browser family, shown collapsed by default
+	};
+
+	void Update(const ProcessStore& processes);
+
+	const Node* Find(uint32_t pid) const;
+	// Roots and every children list are ordered heaviest subtree first (CPU, then memory)
+	const std::vector<uint32_t>& GetRoots() const { return roots_; }
+	size_t GetNodeCount() const { return nodes_.size(); }
+
+	// Processes touched by the last Update (inserted, removed, changed or moved); 0 means nothing moved
+	size_t GetLastChangeCount() const { return lastChangeCount_; }
+
+	static bool IsFamilyName(const std::string& name, std::string* family = nullptr);
+
+private:
+	std::unordered_map<uint32_t, Node> nodes_;
+	std::vector<uint32_t> roots_;
+	size_t lastChangeCount_ = 0;
+
+	void Attach(Node& node);
+	void Detach(Node& node);
+	void AddToAncestors(uint32_t parentPid, const ProcessTotals& delta, bool subtract);
+	bool WouldCycle(uint32_t pid, uint32_t parentPid) const;
+	void UpdateFamilyRoot(Node& node);
+	void SortByWeight();
+	static ProcessTotals TotalsOf(const ProcessStore& processes, size_t row);
+};
@@ -0,0 +1,165 @@
+#include "linux_fd_monitor.hpp"
+#include "linux_proc_utils.hpp"
+#include <algorithm>
+#include <climits>
+#include <sstream>
+#include <string_view>
+#include <sys/stat.h>
+
+LinuxFdMonitor::LinuxFdMonitor(const std::string& procRoot, size_t breakdownCount, std::chrono::seconds breakdownInterval)
+	: procRoot_(procRoot), breakdownCount_(breakdownCount), breakdownInterval_(breakdownInterval)
+{
+}
+
+void LinuxFdMonitor::Update(std::vector<ProcessInfo>& processes)
+{
+	std::unordered_map<uint32_t, uint64_t> limits;
+	limits.reserve(processes.size());
+	size_t limitReads = 0;
+
+	FdStats stats;
+	std::vector<size_t> candidates; // Processes with a known limit, for picking the breakdown set
+	for (size_t i = 0; i < processes.size(); ++i) {
+		ProcessInfo& process = processes[i];
+		std::string pidDir = procRoot_ + "/" + std::to_string(process.pid);
+		process.fdCount = CountDescriptors(pidDir + "/fd");
+
+		// A budget per tick keeps the first scan of a busy machine from reading thousands of limits files at once
+		auto known = softLimits_.find(process.pid);
+		if (known != softLimits_.end()) {
+			process.fdLimit = known->second;
+		} else if (limitReads < LimitReadsPerTick) {
+			process.fdLimit = ReadSoftLimit(process.pid);
+			++limitReads;
+		} else {
+			continue;
+		}
+		limits.emplace(process.pid, process.fdLimit);
+
+		if (process.fdLimit == 0 || process.fdCount == 0) continue;
+		stats.isAvailable = true;
+		candidates.push_back(i);
+		float usage = static_cast<float>(process.fdCount) / static_cast<float>(process.fdLimit) * 100.0f;
+		if (usage > stats.maxUsagePercent) {
+			stats.maxUsagePercent = usage;
+			stats.maxUsagePid = process.pid;
+			stats.maxUsageName = process.name;
+		}
+	}
+	softLimits_ = std::move(limits); // Also forgets processes that exited
+
+	stats.top = std::move(stats_.top);
+	stats.lastBreakdownTime = stats_.lastBreakdownTime;
+	stats_ = std::move(stats);
+
+	auto now = std::chrono::steady_clock::now();
+	if (!hasBreakdown_ || now - lastBreakdown_ >= breakdownInterval_) {
+		UpdateBreakdown(processes, candidates);
+		lastBreakdown_ = now;
+		hasBreakdown_ = true;
+	}
+}
+
+void LinuxFdMonitor::UpdateBreakdown(std::vector<ProcessInfo>& processes, const std::vector<size_t>& candidates)
+{
+	// Closest to the limit first; equal shares go to the process holding more descriptors
+	auto headroomBefore = [&processes](size_t a, size_t b) {
+		uint64_t lhs = static_cast<uint64_t>(processes[a].fdCount) * processes[b].fdLimit;
+		uint64_t rhs = static_cast<uint64_t>(processes[b].fdCount) * processes[a].fdLimit;
+		if (lhs != rhs) return lhs > rhs;
+		return processes[a].fdCount > processes[b].fdCount;
+	};
+	std::vector<size_t> order = candidates;
+	size_t keep = std::min(breakdownCount_, order.size());
+	std::partial_sort(order.begin(), order.begin() + keep, order.end(), headroomBefore);
+
+	stats_.top.clear();
+	for (size_t k = 0; k < keep; ++k) {
+		ProcessInfo& process = processes[order[k]];
+
+		// prlimit can raise or lower a running service's limit, so the ones that matter are re-checked here
+		uint64_t limit = ReadSoftLimit(process.pid);
+		if (limit != 0) {
+			process.fdLimit = limit;
+			softLimits_[process.pid] = limit;
+		}
+
+		ProcessFdBreakdown breakdown;
+		breakdown.pid = process.pid;
+		breakdown.name = process.name;
+		breakdown.softLimit = process.fdLimit;
+		Classify(procRoot_ + "/" + std::to_string(process.pid) + "/fd", breakdown);
+		stats_.top.push_back(std::move(breakdown));
+	}
+	stats_.lastBreakdownTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+		std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+uint64_t LinuxFdMonitor::ReadSoftLimit(uint32_t pid) const
+{
+	std::string text;
+	if (!LinuxProc::ReadFile(procRoot_ + "/" + std::to_string(pid) + "/limits", text)) return 0;
+	return ParseSoftLimit(text);
+}
+
+uint32_t LinuxFdMonitor::CountDescriptors(const std::string& fdDir)
+{
+	// Since Linux 6.2 the directory's st_size is its entry count, which saves listing it; older kernels report 0
+	struct stat info = {};
+	if (::stat(fdDir.c_str(), &info) != 0) return 0;
+	if (info.st_size > 0) return static_cast<uint32_t>(info.st_size);
+
+	DIR* dir = opendir(fdDir.c_str());
+	if (!dir) return 0;
+	uint32_t count = 0;
+	while (dirent* entry = readdir(dir)) {
+		if (entry->d_name[0] != '.') ++count;
+	}
+	closedir(dir);
+	return count;
+}
+
+uint64_t LinuxFdMonitor::ParseSoftLimit(const std::string& limitsText)
+{
+	// "Max open files            1024                 524288               files"
+	std::istringstream lines(limitsText);
+	std::string line;
+	while (std::getline(lines, line)) {
+		if (line.compare(0, 14, "Max open files") != 0) continue;
+		std::istringstream fields(line.substr(14));
+		std::string soft;
+		if (!(fields >> soft) || soft == "unlimited") return 0;
+		return std::strtoull(soft.c_str(), nullptr, 10);
+	}
+	return 0;
+}
+
+void LinuxFdMonitor::Classify(const std::string& fdDir, ProcessFdBreakdown& breakdown)
+{
+	DIR* dir = opendir(fdDir.c_str());
+	if (!dir) return;
+
+	std::string path = fdDir + "/";
+	size_t prefixLength = path.size();
+	char target[PATH_MAX];
+	while (dirent* entry = readdir(dir)) {
+		if (entry->d_name[0] == '.') continue;
+		path.resize(prefixLength);
+		path += entry->d_name;
+		ssize_t length = readlink(path.c_str(), target, sizeof(target) - 1);
+		if (length <= 0) continue; // Closed between readdir and readlink
+
+		++breakdown.total;
+		std::string_view link(target, static_cast<size_t>(length));
+		if (link.compare(0, 7, "socket:") == 0) {
+			++breakdown.sockets;
+		} else if (link.compare(0, 5, "pipe:") == 0) {
+			++breakdown.pipes;
+		} else if (link.front() == '/') {
+			++breakdown.files;
+		} else {
+			++breakdown.other; // anon_inode:[eventfd], [eventpoll] and friends
+		}
+	}
+	closedir(dir);
+}
@@ -0,0 +1,42 @@
+// LinuxFdMonitor: Open file descriptors per process against its soft RLIMIT_NOFILE.
+// Counting is one stat() of /proc/[pid]/fd per process per tick; the per-descriptor breakdown into sockets,
+// pipes and files costs a readlink per fd, so it only runs for the processes nearest their limit, and rarely.
+#pragma once
+#include "../../core/system_state.hpp"
+#include <chrono>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class LinuxFdMonitor
+{
+public:
+	explicit LinuxFdMonitor(const std::string& procRoot = "/proc", size_t breakdownCount = 10,
+		std::chrono::seconds breakdownInterval = std::chrono::seconds(10));
+
+	// Fills fdCount and fdLimit of every process in the scan and refreshes the breakdown when it is due
+	void Update(std::vector<ProcessInfo>& processes);
+
+	const FdStats& GetStats() const { return stats_; }
+
+	// Number of entries in an fd directory; 0 if it can't be read (another user's process without privileges)
+	static uint32_t CountDescriptors(const std::string& fdDir);
+	// Soft limit from the "Max open files" line of /proc/[pid]/limits; 0 if missing or "unlimited"
+	static uint64_t ParseSoftLimit(const std::string& limitsText);
+	static void Classify(const std::string& fdDir, ProcessFdBreakdown& breakdown);
+
+private:
+	// Limits are read once per process and then only re-read for the breakdown set, where a change matters
+	static constexpr size_t LimitReadsPerTick = 1000;
+
+	std::string procRoot_;
+	size_t breakdownCount_;
+	std::chrono::seconds breakdownInterval_;
+	std::unordered_map<uint32_t, uint64_t> softLimits_;
+	std::chrono::steady_clock::time_point lastBreakdown_;
+	bool hasBreakdown_ = false;
+	FdStats stats_;
+
+	void UpdateBreakdown(std::vector<ProcessInfo>& processes, const std::vector<size_t>& candidates);
+	uint64_t ReadSoftLimit(uint32_t pid) const;
+};
@@ -0,0 +1,184 @@
+#include "linux_filesystem_monitor.hpp"
+#include "linux_proc_utils.hpp"
+#include <algorithm>
+#include <sstream>
+#include <unordered_set>
+#include <sys/statvfs.h>
+
+LinuxFilesystemMonitor::LinuxFilesystemMonitor(const std::string& procRoot, std::chrono::seconds refreshInterval, std::chrono::milliseconds statTimeout)
+	: procRoot_(procRoot), refreshInterval_(refreshInterval), worker_(statTimeout), results_(std::make_shared<Results>())
+{
+}
+
+bool LinuxFilesystemMonitor::Update()
+{
+	// Mounts whose statvfs hung keep their last value but are flagged as stale
+	for (const auto& mountPoint : worker_.CheckTimeouts()) {
+		for (auto& fs : filesystems_) {
+			if (fs.mountPoint == mountPoint) fs.isStale = true;
+		}
+	}
+
+	auto now = std::chrono::steady_clock::now();
+	if (!hasRefreshed_ || now - lastRefresh_ >= refreshInterval_) {
+		RefreshMounts();
+		lastRefresh_ = now;
+		hasRefreshed_ = true;
+	}
+
+	bool dirty = false;
+	{
+		std::lock_guard<std::mutex> lock(results_->mutex);
+		dirty = results_->dirty;
+		results_->dirty = false;
+	}
+	if (dirty) PublishResults();
+	return dirty;
+}
+
+void LinuxFilesystemMonitor::RefreshMounts()
+{
+	std::string text;
+	if (!LinuxProc::ReadFile(procRoot_ + "/self/mountinfo", text)) return;
+
+	std::vector<FilesystemInfo> mounts;
+	std::unordered_set<std::string> seenDevices;
+	for (const auto& entry : ParseMountInfo(text)) {
+		if (IsPseudoFilesystem(entry.fsType)) continue;
+		if (!seenDevices.insert(entry.deviceId).second) continue;
+
+		// Keep previous values until the new statvfs comes back
+		FilesystemInfo fs;
+		auto previous = std::find_if(filesystems_.begin(), filesystems_.end(),
+			[&entry](const FilesystemInfo& old) { return old.mountPoint == entry.mountPoint; });
+		if (previous != filesystems_.end()) fs = *previous;
+
+		fs.mountPoint = entry.mountPoint;
+		fs.device = entry.device;
+		fs.fsType = entry.fsType;
+		fs.isNetwork = IsNetworkFilesystem(entry.fsType);
+		mounts.push_back(fs);
+
+		// A mount that is still stuck in statvfs stays pending and is simply not queued again
+		std::shared_ptr<Results> results = results_;
+		std::string mountPoint = entry.mountPoint;
+		worker_.Submit(mountPoint, [results, mountPoint]() {
+			StatResult result;
+			struct statvfs info = {};
+			if (statvfs(mountPoint.c_str(), &info) == 0) {
+				uint64_t blockSize = info.f_frsize ? info.f_frsize : info.f_bsize;
+				result.ok = true;
+				result.totalBytes = static_cast<uint64_t>(info.f_blocks) * blockSize;
+				result.freeBytes = static_cast<uint64_t>(info.f_bfree) * blockSize;
+				result.availableBytes = static_cast<uint64_t>(info.f_bavail) * blockSize;
+				result.totalInodes = info.f_files;
+				result.freeInodes = info.f_ffree;
+			}
+			result.completedTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+				std::chrono::system_clock::now().time_since_epoch()).count();
+
+			std::lock_guard<std::mutex> lock(results->mutex);
+			results->byMount[mountPoint] = result;
+			results->dirty = true;
+		});
+	}
+
+	filesystems_ = std::move(mounts);
+}
+
+void LinuxFilesystemMonitor::PublishResults()
+{
+	std::lock_guard<std::mutex> lock(results_->mutex);
+	for (auto& fs : filesystems_) {
+		auto it = results_->byMount.find(fs.mountPoint);
+		if (it == results_->byMount.end() || !it->second.ok) continue;
+		if (it->second.completedTime == fs.lastUpdateTime) continue;
+
+		const StatResult& result = it->second;
+		fs.hasData = true;
+		fs.isStale = false;
+		fs.lastUpdateTime = result.completedTime;
+		fs.totalBytes = result.totalBytes;
+		fs.freeBytes = result.availableBytes;
+		fs.usedBytes = result.totalBytes - result.freeBytes;
+		fs.totalInodes = result.totalInodes;
+		fs.freeInodes = result.freeInodes;
+		fs.usedInodes = result.totalInodes - result.freeInodes;
+
+		// Same definition as df: used / (used + available), since root-reserved blocks aren't usable
+		uint64_t usable = fs.usedBytes + fs.freeBytes;
+		fs.usagePercent = usable > 0 ? (static_cast<float>(fs.usedBytes) / static_cast<float>(usable)) * 100.0f : 0.0f;
+		fs.inodeUsagePercent = fs.totalInodes > 0
+			? (static_cast<float>(fs.usedInodes) / static_cast<float>(fs.totalInodes)) * 100.0f
+			: 0.0f;
+	}
+}
+
+std::vector<LinuxFilesystemMonitor::MountEntry> LinuxFilesystemMonitor::ParseMountInfo(const std::string& text)
+{
+	// "36 35 98:0 /mnt1 /mnt/parent rw,noatime master:1 - ext3 /dev/root rw,errors=continue"
+	std::vector<MountEntry> entries;
+	std::istringstream lines(text);
+	std::string line;
+	while (std::getline(lines, line)) {
+		std::istringstream fields(line);
+		std::string mountId, parentId, deviceId, root, mountPoint, field;
+		if (!(fields >> mountId >> parentId >> deviceId >> root >> mountPoint)) continue;
+
+		// Skip mount options and the variable-length optional fields up to the "-" separator
+		bool foundSeparator = false;
+		while (fields >> field) {
+			if (field == "-") {
+				foundSeparator = true;
+				break;
+			}
+		}
+		if (!foundSeparator) continue;
+
+		MountEntry entry;
+		if (!(fields >> entry.fsType >> entry.device)) continue;
+		entry.mountPoint = UnescapeMountPath(mountPoint);
+		entry.deviceId = deviceId;
+		entries.push_back(entry);
+	}
+	return entries;
+}
+
+bool LinuxFilesystemMonitor::IsPseudoFilesystem(const std::string& fsType)
+{
+	static const std::unordered_set<std::string> pseudoTypes = {
+		"proc", "sysfs", "devtmpfs", "devpts", "tmpfs", "ramfs", "cgroup", "cgroup2", "securityfs",
+		"debugfs", "tracefs", "configfs", "fusectl", "mqueue", "hugetlbfs", "pstore", "bpf",
+		"binfmt_misc", "autofs", "nsfs", "rpc_pipefs", "efivarfs", "selinuxfs", "squashfs", "nfsd",
+		"fuse.gvfsd-fuse", "fuse.portal", "devfs"
+	};
+	return pseudoTypes.count(fsType) > 0;
+}
+
+bool LinuxFilesystemMonitor::IsNetworkFilesystem(const std::string& fsType)
+{
+	static const std::unordered_set<std::string> networkTypes = {
+		"nfs", "nfs4", "cifs", "smb3", "smbfs", "ceph", "glusterfs", "fuse.glusterfs", "fuse.sshfs",
+		"fuse.s3fs", "9p", "afs", "lustre", "gpfs", "beegfs"
+	};
+	return networkTypes.count(fsType) > 0;
+}
+
+std::string LinuxFilesystemMonitor::UnescapeMountPath(const std::string& path)
+{
+	// The kernel escapes space, tab, newline and backslash as 3-digit octal ("\040")
+	std::string result;
+	result.reserve(path.size());
+	for (size_t i = 0; i < path.size(); ++i) {
+		if (path[i] == '\\' && i + 3 < path.size()) {
+			const char* digits = path.c_str() + i + 1;
+			if (digits[0] >= '0' && digits[0] <= '7' && digits[1] >= '0' && digits[1] <= '7' && digits[2] >= '0' && digits[2] <= '7') {
+				result += static_cast<char>((digits[0] - '0') * 64 + (digits[1] - '0') * 8 + (digits[2] - '0'));
+				i += 3;
+				continue;
+			}
+		}
+		result += path[i];
+	}
+	return result;
+}
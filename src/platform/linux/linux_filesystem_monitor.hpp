@@ -0,0 +1,70 @@
+// LinuxFilesystemMonitor: Reports capacity and inode usage for real mounts listed in /proc/self/mountinfo.
+// statvfs runs on a TimeoutWorker so a stale network mount never blocks the collector; the last good value is kept.
+#pragma once
+#include "../../core/system_state.hpp"
+#include "timeout_worker.hpp"
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class LinuxFilesystemMonitor
+{
+public:
+	explicit LinuxFilesystemMonitor(const std::string& procRoot = "/proc",
+		std::chrono::seconds refreshInterval = std::chrono::seconds(30),
+		std::chrono::milliseconds statTimeout = std::chrono::milliseconds(2000));
+
+	void SetRefreshInterval(std::chrono::seconds interval) { refreshInterval_ = interval; }
+	std::chrono::seconds GetRefreshInterval() const { return refreshInterval_; }
+
+	// Cheap to call every tick; returns true when new statvfs results were published
+	bool Update();
+
+	const std::vector<FilesystemInfo>& GetFilesystems() const { return filesystems_; }
+
+	struct MountEntry
+	{
+		std::string mountPoint;
+		std::string device;
+		std::string fsType;
+		std::string deviceId; // major:minor, used to skip bind mounts of the same filesystem
+	};
+	static std::vector<MountEntry> ParseMountInfo(const std::string& text);
+	static bool IsPseudoFilesystem(const std::string& fsType);
+	static bool IsNetworkFilesystem(const std::string& fsType);
+
+private:
+	struct StatResult
+	{
+		bool ok = false;
+		uint64_t totalBytes = 0;
+		uint64_t freeBytes = 0;
+		uint64_t availableBytes = 0;
+		uint64_t totalInodes = 0;
+		uint64_t freeInodes = 0;
+		uint64_t completedTime = 0;
+	};
+
+	// Shared with worker jobs, which may outlive this monitor if they hang
+	struct Results
+	{
+		std::mutex mutex;
+		std::unordered_map<std::string, StatResult> byMount;
+		bool dirty = false;
+	};
+
+	std::string procRoot_;
+	std::chrono::seconds refreshInterval_;
+	TimeoutWorker worker_;
+	std::shared_ptr<Results> results_;
+	std::vector<FilesystemInfo> filesystems_;
+	std::chrono::steady_clock::time_point lastRefresh_;
+	bool hasRefreshed_ = false;
+
+	void RefreshMounts();
+	void PublishResults();
+	static std::string UnescapeMountPath(const std::string& path);
+};
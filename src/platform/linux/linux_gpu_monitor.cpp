@@ -0,0 +1,222 @@
+#include "linux_gpu_monitor.hpp"
+#include "linux_proc_utils.hpp"
+#include <algorithm>
+#include <sstream>
+#include <unistd.h>
+
+LinuxGpuMonitor::LinuxGpuMonitor(const std::string& procRoot, const std::string& sysRoot, std::chrono::seconds rescanInterval)
+	: procRoot_(procRoot), sysRoot_(sysRoot), rescanInterval_(rescanInterval)
+{
+	DiscoverDevices();
+}
+
+void LinuxGpuMonitor::DiscoverDevices()
+{
+	// card0, card1, ... (connector entries like "card0-DP-1" aren't devices)
+	std::string drmRoot = sysRoot_ + "/class/drm";
+	std::vector<uint32_t> cards = LinuxProc::ListNumberedEntries(drmRoot, "card");
+	gpu_.isAvailable = !cards.empty();
+	if (!gpu_.isAvailable) return;
+
+	std::sort(cards.begin(), cards.end());
+	char target[256];
+	std::string driverLink = drmRoot + "/card" + std::to_string(cards.front()) + "/device/driver";
+	ssize_t n = readlink(driverLink.c_str(), target, sizeof(target) - 1);
+	if (n > 0) {
+		std::string path(target, static_cast<size_t>(n));
+		gpu_.driver = path.substr(path.find_last_of('/') + 1);
+	}
+}
+
+void LinuxGpuMonitor::Update()
+{
+	if (!gpu_.isAvailable) return;
+
+	auto now = std::chrono::steady_clock::now();
+	bool rescanAll = !hasFullScan_ || now - lastFullScan_ >= rescanInterval_;
+	ScanProcesses(rescanAll);
+	if (rescanAll) {
+		lastFullScan_ = now;
+		hasFullScan_ = true;
+	}
+
+	SampleClients();
+}
+
+void LinuxGpuMonitor::ScanProcesses(bool rescanAll)
+{
+	// Between full rescans only processes not seen before are inspected. The periodic rescan
+	// catches processes that open a GPU device late and pids that were reused.
+	std::vector<uint32_t> pids = LinuxProc::ListNumberedEntries(procRoot_, "");
+	std::unordered_set<uint32_t> current(pids.begin(), pids.end());
+
+	for (uint32_t pid : pids) {
+		if (rescanAll || scannedPids_.count(pid) == 0) ScanProcess(pid);
+	}
+
+	for (auto it = holders_.begin(); it != holders_.end(); ) {
+		it = current.count(it->first) ? std::next(it) : holders_.erase(it);
+	}
+	scannedPids_ = std::move(current);
+}
+
+void LinuxGpuMonitor::ScanProcess(uint32_t pid)
+{
+	std::string fdDir = procRoot_ + "/" + std::to_string(pid) + "/fd";
+	std::vector<std::string> drmFds;
+	char target[256];
+	for (const auto& fd : LinuxProc::ListEntries(fdDir)) {
+		std::string link = fdDir + "/" + fd;
+		ssize_t n = readlink(link.c_str(), target, sizeof(target) - 1);
+		if (n <= 0) continue;
+		if (std::string(target, static_cast<size_t>(n)).compare(0, 9, "/dev/dri/") == 0) drmFds.push_back(fd);
+	}
+
+	if (drmFds.empty()) {
+		holders_.erase(pid);
+	} else {
+		holders_[pid] = std::move(drmFds);
+	}
+}
+
+void LinuxGpuMonitor::SampleClients()
+{
+	auto now = std::chrono::steady_clock::now();
+	std::unordered_map<std::string, float> engineTotals;
+	std::unordered_set<std::string> seenClients;
+	std::vector<GpuProcess> processes;
+
+	for (auto it = holders_.begin(); it != holders_.end(); ) {
+		uint32_t pid = it->first;
+		std::string pidDir = procRoot_ + "/" + std::to_string(pid);
+		std::unordered_map<std::string, float> processEngines;
+		GpuProcess process;
+		process.pid = pid;
+		bool anyOpen = false;
+
+		for (const auto& fd : it->second) {
+			std::string text;
+			FdInfo info;
+			if (!LinuxProc::ReadFile(pidDir + "/fdinfo/" + fd, text)) continue;
+			anyOpen = true;
+			if (!ParseFdInfo(text, info)) continue;
+			if (gpu_.driver.empty()) gpu_.driver = info.driver;
+
+			// Several fds (dup, fork, render + card node) can share one DRM client; count it once
+			std::string key = info.pdev + "/" + info.clientId;
+			if (!seenClients.insert(key).second) continue;
+
+			auto previous = clients_.find(key);
+			if (previous != clients_.end()) {
+				float elapsedNs = std::chrono::duration<float, std::nano>(now - previous->second.time).count();
+				for (const auto& [engine, busyNs] : info.engineNs) {
+					auto before = previous->second.engineNs.find(engine);
+					if (before == previous->second.engineNs.end() || busyNs < before->second || elapsedNs <= 0.0f) continue;
+
+					auto capacity = info.engineCapacity.find(engine);
+					float instances = capacity != info.engineCapacity.end() ? static_cast<float>(capacity->second) : 1.0f;
+					float percent = static_cast<float>(busyNs - before->second) / (elapsedNs * instances) * 100.0f;
+					processEngines[engine] += percent;
+					engineTotals[engine] += percent;
+				}
+			}
+			clients_[key] = { info.engineNs, now };
+			for (const auto& engine : info.engineNs) engineTotals.emplace(engine.first, 0.0f);
+			process.memoryBytes += info.memoryBytes;
+		}
+
+		// The process exited or closed its GPU fds; the next scan will find it again if it reopens them
+		if (!anyOpen) {
+			it = holders_.erase(it);
+			continue;
+		}
+		++it;
+
+		for (const auto& engine : processEngines) {
+			process.utilizationPercent = std::max(process.utilizationPercent, std::min(100.0f, engine.second));
+		}
+		if (process.utilizationPercent > 0.0f || process.memoryBytes > 0) {
+			LinuxProc::ReadFile(pidDir + "/comm", process.name);
+			process.name.erase(process.name.find_last_not_of(" \n") + 1);
+			processes.push_back(process);
+		}
+	}
+
+	for (auto it = clients_.begin(); it != clients_.end(); ) {
+		it = seenClients.count(it->first) ? std::next(it) : clients_.erase(it);
+	}
+
+	// Engines keep a stable order once seen, so the collector can keep their histories by index
+	for (auto& engine : gpu_.engines) engine.utilizationPercent = 0.0f;
+	for (const auto& [name, percent] : engineTotals) {
+		auto engine = std::find_if(gpu_.engines.begin(), gpu_.engines.end(),
+			[&name = name](const GpuEngine& existing) { return existing.name == name; });
+		if (engine == gpu_.engines.end()) {
+			gpu_.engines.push_back({});
+			engine = gpu_.engines.end() - 1;
+			engine->name = name;
+		}
+		engine->utilizationPercent = std::min(100.0f, percent);
+	}
+
+	std::sort(processes.begin(), processes.end(), [](const GpuProcess& a, const GpuProcess& b) {
+		return a.utilizationPercent != b.utilizationPercent ? a.utilizationPercent > b.utilizationPercent : a.memoryBytes > b.memoryBytes;
+	});
+	gpu_.processes = std::move(processes);
+}
+
+float LinuxGpuMonitor::GetUtilizationPercent() const
+{
+	float busiest = 0.0f;
+	for (const auto& engine : gpu_.engines) busiest = std::max(busiest, engine.utilizationPercent);
+	return busiest;
+}
+
+uint64_t LinuxGpuMonitor::GetMemoryUsed() const
+{
+	uint64_t total = 0;
+	for (const auto& process : gpu_.processes) total += process.memoryBytes;
+	return total;
+}
+
+bool LinuxGpuMonitor::ParseFdInfo(const std::string& text, FdInfo& info)
+{
+	// Keys per Documentation/gpu/drm-usage-stats.rst:
+	//   drm-engine-<name>: <ns> ns, drm-engine-capacity-<name>: <n>,
+	//   drm-memory-<region>: <n> [KiB|MiB] (legacy) or drm-resident-<region> (preferred)
+	uint64_t legacyMemory = 0, residentMemory = 0;
+	bool hasResident = false;
+
+	auto parseSize = [](std::istringstream& value) {
+		uint64_t amount = 0;
+		std::string unit;
+		value >> amount >> unit;
+		if (unit == "KiB") return amount * 1024;
+		if (unit == "MiB") return amount * 1024 * 1024;
+		if (unit == "GiB") return amount * 1024 * 1024 * 1024;
+		return amount;
+	};
+
+	std::istringstream lines(text);
+	std::string line;
+	while (std::getline(lines, line)) {
+		size_t colon = line.find(':');
+		if (colon == std::string::npos || line.compare(0, 4, "drm-") != 0) continue;
+		std::string key = line.substr(4, colon - 4);
+		std::istringstream value(line.substr(colon + 1));
+
+		if (key == "driver") value >> info.driver;
+		else if (key == "pdev") value >> info.pdev;
+		else if (key == "client-id") value >> info.clientId;
+		else if (key.compare(0, 16, "engine-capacity-") == 0) value >> info.engineCapacity[key.substr(16)];
+		else if (key.compare(0, 7, "engine-") == 0) value >> info.engineNs[key.substr(7)];
+		else if (key.compare(0, 7, "memory-") == 0) legacyMemory += parseSize(value);
+		else if (key.compare(0, 9, "resident-") == 0) {
+			residentMemory += parseSize(value);
+			hasResident = true;
+		}
+	}
+
+	info.memoryBytes = hasResident ? residentMemory : legacyMemory;
+	return !info.clientId.empty();
+}
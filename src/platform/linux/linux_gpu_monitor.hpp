@@ -0,0 +1,63 @@
+// LinuxGpuMonitor: GPU utilization and memory per engine and per process from DRM fdinfo
+// (/proc/[pid]/fdinfo/[fd], drm-engine-* and drm-memory-* keys). Only processes known to hold
+// /dev/dri fds are sampled each tick; new processes are picked up incrementally.
+#pragma once
+#include "../../core/system_state.hpp"
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+class LinuxGpuMonitor
+{
+public:
+	explicit LinuxGpuMonitor(const std::string& procRoot = "/proc", const std::string& sysRoot = "/sys",
+		std::chrono::seconds rescanInterval = std::chrono::seconds(30));
+
+	void Update();
+
+	bool IsAvailable() const { return gpu_.isAvailable; }
+
+	// Current values only; histories are kept by the collector
+	const GpuStats& GetGpu() const { return gpu_; }
+
+	// Busiest engine across all clients, which is how Task Manager and intel_gpu_top report overall load
+	float GetUtilizationPercent() const;
+	uint64_t GetMemoryUsed() const;
+
+	struct FdInfo
+	{
+		std::string driver;
+		std::string pdev;
+		std::string clientId;
+		std::unordered_map<std::string, uint64_t> engineNs;
+		std::unordered_map<std::string, uint32_t> engineCapacity;
+		uint64_t memoryBytes = 0;
+	};
+	static bool ParseFdInfo(const std::string& text, FdInfo& info);
+
+private:
+	struct ClientSample
+	{
+		std::unordered_map<std::string, uint64_t> engineNs;
+		std::chrono::steady_clock::time_point time;
+	};
+
+	std::string procRoot_;
+	std::string sysRoot_;
+	std::chrono::seconds rescanInterval_;
+	GpuStats gpu_;
+
+	std::unordered_map<uint32_t, std::vector<std::string>> holders_; // pid -> fds pointing at /dev/dri
+	std::unordered_set<uint32_t> scannedPids_;
+	std::unordered_map<std::string, ClientSample> clients_;          // "pdev/client-id" -> last sample
+	std::chrono::steady_clock::time_point lastFullScan_;
+	bool hasFullScan_ = false;
+
+	void DiscoverDevices();
+	void ScanProcesses(bool rescanAll);
+	void ScanProcess(uint32_t pid);
+	void SampleClients();
+};
@@ -0,0 +1,105 @@
+#include "linux_net_health_monitor.hpp"
+#include "linux_proc_utils.hpp"
+#include <sstream>
+#include <unistd.h>
+
+LinuxNetHealthMonitor::LinuxNetHealthMonitor(const std::string& procRoot)
+	: procRoot_(procRoot)
+{
+	std::string text;
+	health_.isAvailable = LinuxProc::ReadFile(procRoot_ + "/net/snmp", text);
+}
+
+void LinuxNetHealthMonitor::Update()
+{
+	if (!health_.isAvailable) return;
+
+	std::unordered_map<std::string, int64_t> counters;
+	std::string text;
+	if (LinuxProc::ReadFile(procRoot_ + "/net/snmp", text)) counters = ParseCounterTable(text);
+	if (LinuxProc::ReadFile(procRoot_ + "/net/netstat", text)) counters.merge(ParseCounterTable(text));
+
+	auto now = std::chrono::steady_clock::now();
+	float elapsedSeconds = hasSample_ ? std::chrono::duration<float>(now - lastSample_).count() : 0.0f;
+
+	auto delta = [this, &counters](const char* key) -> int64_t {
+		auto current = counters.find(key);
+		auto previous = lastCounters_.find(key);
+		if (current == counters.end() || previous == lastCounters_.end()) return 0;
+		return current->second >= previous->second ? current->second - previous->second : 0; // Reset on netns teardown
+	};
+	auto rate = [elapsedSeconds, &delta](const char* key) {
+		return elapsedSeconds > 0.0f ? static_cast<float>(delta(key)) / elapsedSeconds : 0.0f;
+	};
+
+	health_.tcpRetransPerSec = rate("Tcp.RetransSegs");
+	health_.tcpInErrorsPerSec = rate("Tcp.InErrs");
+	health_.listenOverflowsPerSec = rate("TcpExt.ListenOverflows");
+	health_.listenDropsPerSec = rate("TcpExt.ListenDrops");
+	health_.synCookiesSentPerSec = rate("TcpExt.SyncookiesSent");
+	health_.outOfOrderPerSec = rate("TcpExt.TCPOFOQueue");
+	health_.udpRcvbufErrorsPerSec = rate("Udp.RcvbufErrors");
+	health_.udpInErrorsPerSec = rate("Udp.InErrors");
+
+	int64_t outSegs = delta("Tcp.OutSegs");
+	health_.tcpRetransPercent = outSegs > 0
+		? (static_cast<float>(delta("Tcp.RetransSegs")) / static_cast<float>(outSegs)) * 100.0f
+		: 0.0f;
+
+	UpdateSocketStats();
+
+	lastCounters_ = std::move(counters);
+	lastSample_ = now;
+	hasSample_ = true;
+}
+
+void LinuxNetHealthMonitor::UpdateSocketStats()
+{
+	std::string text;
+	if (!LinuxProc::ReadFile(procRoot_ + "/net/sockstat", text)) return;
+
+	// "TCP: inuse 6 orphan 0 tw 0 alloc 6 mem 0" - mem is in pages
+	static const uint64_t pageSize = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+
+	std::istringstream lines(text);
+	std::string line;
+	while (std::getline(lines, line)) {
+		std::istringstream fields(line);
+		std::string protocol, key;
+		uint64_t value = 0;
+		fields >> protocol;
+		while (fields >> key >> value) {
+			if (protocol == "TCP:") {
+				if (key == "inuse") health_.tcpInUse = static_cast<uint32_t>(value);
+				else if (key == "orphan") health_.tcpOrphans = static_cast<uint32_t>(value);
+				else if (key == "tw") health_.tcpTimeWait = static_cast<uint32_t>(value);
+				else if (key == "mem") health_.tcpMemoryBytes = value * pageSize;
+			} else if (protocol == "UDP:") {
+				if (key == "inuse") health_.udpInUse = static_cast<uint32_t>(value);
+				else if (key == "mem") health_.udpMemoryBytes = value * pageSize;
+			}
+		}
+	}
+}
+
+std::unordered_map<std::string, int64_t> LinuxNetHealthMonitor::ParseCounterTable(const std::string& text)
+{
+	std::unordered_map<std::string, int64_t> counters;
+	std::istringstream lines(text);
+	std::string header, values;
+	while (std::getline(lines, header) && std::getline(lines, values)) {
+		std::istringstream names(header), numbers(values);
+		std::string prefix, valuePrefix;
+		names >> prefix;
+		numbers >> valuePrefix;
+		if (prefix != valuePrefix || prefix.empty()) continue;
+		prefix.pop_back(); // Trailing ':'
+
+		std::string name;
+		int64_t value = 0;
+		while (names >> name && numbers >> value) {
+			counters[prefix + "." + name] = value;
+		}
+	}
+	return counters;
+}
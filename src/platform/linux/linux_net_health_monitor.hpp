@@ -0,0 +1,31 @@
+// LinuxNetHealthMonitor: Turns the kernel's TCP/UDP counters (snmp, netstat, sockstat) into per-second rates.
+#pragma once
+#include "../../core/system_state.hpp"
+#include <chrono>
+#include <string>
+#include <unordered_map>
+
+class LinuxNetHealthMonitor
+{
+public:
+	explicit LinuxNetHealthMonitor(const std::string& procRoot = "/proc");
+
+	void Update();
+
+	bool IsAvailable() const { return health_.isAvailable; }
+
+	// Current values only; histories are kept by the collector
+	const NetworkHealth& GetHealth() const { return health_; }
+
+	// Parses the paired "Prefix: names" / "Prefix: values" layout of snmp and netstat into "Prefix.Name" keys
+	static std::unordered_map<std::string, int64_t> ParseCounterTable(const std::string& text);
+
+private:
+	std::string procRoot_;
+	NetworkHealth health_;
+	std::unordered_map<std::string, int64_t> lastCounters_;
+	std::chrono::steady_clock::time_point lastSample_;
+	bool hasSample_ = false;
+
+	void UpdateSocketStats();
+};
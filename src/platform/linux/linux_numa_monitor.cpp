@@ -0,0 +1,219 @@
+#include "linux_numa_monitor.hpp"
+#include "linux_proc_utils.hpp"
+#include <algorithm>
+#include <sstream>
+#include <utility>
+
+LinuxNumaMonitor::LinuxNumaMonitor(const std::string& sysRoot, const std::string& procRoot)
+	: sysRoot_(sysRoot), procRoot_(procRoot), placementWorker_(std::chrono::milliseconds(2000)),
+	placementResult_(std::make_shared<PlacementResult>())
+{
+	DiscoverNodes();
+}
+
+void LinuxNumaMonitor::DiscoverNodes()
+{
+	std::vector<uint32_t> ids = LinuxProc::ListNumberedEntries(sysRoot_ + "/devices/system/node", "node");
+	std::sort(ids.begin(), ids.end());
+
+	nodes_.clear();
+	for (uint32_t id : ids) {
+		NumaNode node;
+		node.id = id;
+
+		std::string cpuList;
+		if (LinuxProc::ReadFile(NodePath(id) + "/cpulist", cpuList)) {
+			node.cpus = LinuxProc::ParseCpuList(cpuList);
+		}
+		nodes_.push_back(node);
+	}
+}
+
+void LinuxNumaMonitor::Update()
+{
+	if (nodes_.empty()) return;
+
+	auto now = std::chrono::steady_clock::now();
+	float elapsedSeconds = hasSample_ ? std::chrono::duration<float>(now - lastSample_).count() : 0.0f;
+
+	for (auto& node : nodes_) {
+		UpdateNodeMemory(node);
+		UpdateNodeCounters(node, elapsedSeconds);
+	}
+	UpdateNodeCpuUsage();
+
+	lastSample_ = now;
+	hasSample_ = true;
+}
+
+void LinuxNumaMonitor::UpdateNodeMemory(NumaNode& node)
+{
+	std::string text;
+	if (!LinuxProc::ReadFile(NodePath(node.id) + "/meminfo", text)) return;
+
+	// Lines look like "Node 0 MemTotal:        4161272 kB"
+	std::istringstream lines(text);
+	std::string line;
+	while (std::getline(lines, line)) {
+		std::istringstream fields(line);
+		std::string nodeWord, nodeId, key;
+		uint64_t valueKB = 0;
+		if (!(fields >> nodeWord >> nodeId >> key >> valueKB)) continue;
+
+		if (key == "MemTotal:") node.memoryTotal = valueKB * 1024;
+		else if (key == "MemUsed:") node.memoryUsed = valueKB * 1024;
+	}
+
+	node.memoryUsagePercent = node.memoryTotal > 0
+		? (static_cast<float>(node.memoryUsed) / static_cast<float>(node.memoryTotal)) * 100.0f
+		: 0.0f;
+}
+
+void LinuxNumaMonitor::UpdateNodeCounters(NumaNode& node, float elapsedSeconds)
+{
+	std::string text;
+	if (!LinuxProc::ReadFile(NodePath(node.id) + "/numastat", text)) return;
+
+	uint64_t hit = node.numaHit, miss = node.numaMiss, other = node.otherNode;
+
+	std::istringstream fields(text);
+	std::string key;
+	uint64_t value = 0;
+	while (fields >> key >> value) {
+		if (key == "numa_hit") hit = value;
+		else if (key == "numa_miss") miss = value;
+		else if (key == "other_node") other = value;
+	}
+
+	auto rate = [elapsedSeconds](uint64_t now, uint64_t before) {
+		if (elapsedSeconds <= 0.0f || now < before) return 0.0f;
+		return static_cast<float>(now - before) / elapsedSeconds;
+	};
+
+	node.numaHitPerSec = rate(hit, node.numaHit);
+	node.numaMissPerSec = rate(miss, node.numaMiss);
+	node.otherNodePerSec = rate(other, node.otherNode);
+
+	node.numaHit = hit;
+	node.numaMiss = miss;
+	node.otherNode = other;
+}
+
+void LinuxNumaMonitor::UpdateNodeCpuUsage()
+{
+	std::string text;
+	if (!LinuxProc::ReadFile(procRoot_ + "/stat", text)) return;
+
+	std::vector<CpuTimes> current(lastCpuTimes_.size());
+
+	// Per-CPU lines: "cpuN user nice system idle iowait irq softirq steal guest guest_nice"
+	std::istringstream lines(text);
+	std::string line;
+	while (std::getline(lines, line)) {
+		if (line.compare(0, 3, "cpu") != 0 || line.size() < 4 || line[3] < '0' || line[3] > '9') continue;
+
+		std::istringstream fields(line.substr(3));
+		uint32_t cpu = 0;
+		uint64_t user = 0, nice = 0, system = 0, idle = 0, iowait = 0, irq = 0, softirq = 0, steal = 0;
+		fields >> cpu >> user >> nice >> system >> idle >> iowait >> irq >> softirq >> steal;
+
+		if (cpu >= current.size()) current.resize(cpu + 1);
+		current[cpu].total = user + nice + system + idle + iowait + irq + softirq + steal;
+		current[cpu].busy = current[cpu].total - idle - iowait;
+	}
+
+	for (auto& node : nodes_) {
+		uint64_t busyDelta = 0, totalDelta = 0;
+		for (uint32_t cpu : node.cpus) {
+			if (cpu >= current.size() || cpu >= lastCpuTimes_.size()) continue;
+			if (current[cpu].total < lastCpuTimes_[cpu].total) continue; // CPU went offline and back
+			busyDelta += current[cpu].busy - lastCpuTimes_[cpu].busy;
+			totalDelta += current[cpu].total - lastCpuTimes_[cpu].total;
+		}
+		node.cpuUsagePercent = totalDelta > 0
+			? (static_cast<float>(busyDelta) / static_cast<float>(totalDelta)) * 100.0f
+			: 0.0f;
+	}
+
+	lastCpuTimes_ = std::move(current);
+}
+
+NumaProcessPlacement LinuxNumaMonitor::ReadProcessPlacement(uint32_t pid) const
+{
+	std::vector<uint32_t> nodeIds;
+	for (const auto& node : nodes_) nodeIds.push_back(node.id);
+	return ReadPlacementFile(procRoot_ + "/" + std::to_string(pid) + "/numa_maps", pid, nodeIds);
+}
+
+void LinuxNumaMonitor::RequestProcessPlacement(uint32_t pid)
+{
+	std::vector<uint32_t> nodeIds;
+	for (const auto& node : nodes_) nodeIds.push_back(node.id);
+	std::string path = procRoot_ + "/" + std::to_string(pid) + "/numa_maps";
+	std::shared_ptr<PlacementResult> result = placementResult_;
+	placementWorker_.Submit("numa_maps/" + std::to_string(pid), [result, path, pid, nodeIds]() {
+		NumaProcessPlacement placement = ReadPlacementFile(path, pid, nodeIds);
+		std::lock_guard<std::mutex> lock(result->mutex);
+		result->placement = std::move(placement);
+	});
+}
+
+std::optional<NumaProcessPlacement> LinuxNumaMonitor::TakeProcessPlacement()
+{
+	// A hung read leaves no result; the next request for that pid starts a fresh one
+	placementWorker_.CheckTimeouts();
+	std::lock_guard<std::mutex> lock(placementResult_->mutex);
+	return std::exchange(placementResult_->placement, std::nullopt);
+}
+
+NumaProcessPlacement LinuxNumaMonitor::ReadPlacementFile(const std::string& path, uint32_t pid, const std::vector<uint32_t>& nodeIds)
+{
+	NumaProcessPlacement placement;
+	placement.pid = pid;
+	placement.nodeBytes.assign(nodeIds.size(), 0);
+
+	std::string text;
+	if (!LinuxProc::ReadFile(path, text)) {
+		return placement;
+	}
+
+	// Each mapping line carries "N<node>=<pages>" tokens and its page size as "kernelpagesize_kB=<n>"
+	std::istringstream lines(text);
+	std::string line;
+	std::vector<std::pair<uint32_t, uint64_t>> linePages;
+	while (std::getline(lines, line)) {
+		uint64_t pageSizeKB = 4;
+		linePages.clear();
+
+		std::istringstream tokens(line);
+		std::string token;
+		while (tokens >> token) {
+			if (token.size() > 2 && token[0] == 'N' && token[1] >= '0' && token[1] <= '9') {
+				size_t eq = token.find('=');
+				if (eq == std::string::npos) continue;
+				uint32_t nodeId = static_cast<uint32_t>(std::strtoul(token.c_str() + 1, nullptr, 10));
+				uint64_t pages = std::strtoull(token.c_str() + eq + 1, nullptr, 10);
+				linePages.emplace_back(nodeId, pages);
+			} else if (token.compare(0, 18, "kernelpagesize_kB=") == 0) {
+				pageSizeKB = std::strtoull(token.c_str() + 18, nullptr, 10);
+			}
+		}
+
+		for (const auto& [nodeId, pages] : linePages) {
+			auto it = std::find(nodeIds.begin(), nodeIds.end(), nodeId);
+			if (it == nodeIds.end()) continue;
+
+			uint64_t bytes = pages * pageSizeKB * 1024;
+			placement.nodeBytes[it - nodeIds.begin()] += bytes;
+			placement.totalBytes += bytes;
+		}
+	}
+
+	placement.isValid = true;
+	return placement;
+}
+
+std::string LinuxNumaMonitor::NodePath(uint32_t nodeId) const
+{
+	return sysRoot_ + "/devices/system/node/node" + std::to_string(nodeId);
+}
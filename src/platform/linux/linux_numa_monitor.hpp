@@ -0,0 +1,63 @@
+// LinuxNumaMonitor: Discovers NUMA nodes from sysfs and samples per-node memory, CPU and numastat counters.
+#pragma once
+#include "../../core/system_state.hpp"
+#include "timeout_worker.hpp"
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+class LinuxNumaMonitor
+{
+public:
+	explicit LinuxNumaMonitor(const std::string& sysRoot = "/sys", const std::string& procRoot = "/proc");
+
+	void Update();
+
+	bool IsAvailable() const { return !nodes_.empty(); }
+	const std::vector<NumaNode>& GetNodes() const { return nodes_; }
+
+	// Reads /proc/[pid]/numa_maps; this walks the page tables of the target and can block on its mmap lock, so
+	// only call it on demand and off the UI thread
+	NumaProcessPlacement ReadProcessPlacement(uint32_t pid) const;
+
+	// Queues ReadProcessPlacement on the worker; ignored while a read of the same pid is still in flight
+	void RequestProcessPlacement(uint32_t pid);
+
+	// The newest finished placement read, if one arrived since the last call; hung reads are given up here
+	std::optional<NumaProcessPlacement> TakeProcessPlacement();
+
+	// Blocking parse of one numa_maps file; nodeIds gives the order of NumaProcessPlacement::nodeBytes
+	static NumaProcessPlacement ReadPlacementFile(const std::string& path, uint32_t pid, const std::vector<uint32_t>& nodeIds);
+
+private:
+	struct CpuTimes
+	{
+		uint64_t busy = 0;
+		uint64_t total = 0;
+	};
+
+	// Shared with worker jobs, which may outlive this monitor if they hang
+	struct PlacementResult
+	{
+		std::mutex mutex;
+		std::optional<NumaProcessPlacement> placement;
+	};
+
+	std::string sysRoot_;
+	std::string procRoot_;
+	std::vector<NumaNode> nodes_;
+	std::vector<CpuTimes> lastCpuTimes_;
+	std::chrono::steady_clock::time_point lastSample_;
+	bool hasSample_ = false;
+	TimeoutWorker placementWorker_;
+	std::shared_ptr<PlacementResult> placementResult_;
+
+	void DiscoverNodes();
+	void UpdateNodeMemory(NumaNode& node);
+	void UpdateNodeCounters(NumaNode& node, float elapsedSeconds);
+	void UpdateNodeCpuUsage();
+	std::string NodePath(uint32_t nodeId) const;
+};
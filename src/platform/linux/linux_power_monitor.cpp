@@ -0,0 +1,123 @@
+#include "linux_power_monitor.hpp"
+#include <algorithm>
+#include <sstream>
+
+LinuxPowerMonitor::LinuxPowerMonitor(const std::string& sysRoot, const std::string& procRoot)
+	: sysRoot_(sysRoot), procRoot_(procRoot)
+{
+	DiscoverDomains();
+	power_.isAvailable = !counters_.empty();
+}
+
+void LinuxPowerMonitor::DiscoverDomains()
+{
+	// Zones are "intel-rapl:<socket>" with subzones "intel-rapl:<socket>:<n>"; AMD exposes the same layout
+	std::string powercapRoot = sysRoot_ + "/class/powercap";
+	std::vector<std::string> zones;
+	for (const auto& name : LinuxProc::ListEntries(powercapRoot)) {
+		if (name.compare(0, 11, "intel-rapl:") == 0) zones.push_back(name);
+	}
+	std::sort(zones.begin(), zones.end());
+
+	for (const auto& zone : zones) {
+		std::string zoneDir = powercapRoot + "/" + zone;
+		DomainCounter counter;
+		counter.energy = LinuxProc::PolledFile(zoneDir + "/energy_uj");
+		if (!counter.energy.IsOpen()) continue;
+		LinuxProc::ReadUInt64(zoneDir + "/max_energy_range_uj", counter.maxRange);
+
+		PowerDomain domain;
+		if (LinuxProc::ReadFile(zoneDir + "/name", domain.name)) {
+			domain.name.erase(domain.name.find_last_not_of(" \n") + 1);
+		}
+		if (domain.name.empty()) domain.name = zone;
+
+		if (domain.name.compare(0, 7, "package") == 0) domain.type = PowerDomain::PACKAGE;
+		else if (domain.name == "core") domain.type = PowerDomain::CORE;
+		else if (domain.name == "uncore") domain.type = PowerDomain::UNCORE;
+		else if (domain.name == "dram") domain.type = PowerDomain::DRAM;
+		else if (domain.name == "psys") domain.type = PowerDomain::PLATFORM;
+
+		power_.domains.push_back(domain);
+		counters_.push_back(std::move(counter));
+	}
+}
+
+void LinuxPowerMonitor::Update()
+{
+	if (!power_.isAvailable) return;
+
+	auto now = std::chrono::steady_clock::now();
+	float elapsedSeconds = hasSample_ ? std::chrono::duration<float>(now - lastSample_).count() : 0.0f;
+
+	power_.packageWatts = 0.0f;
+	power_.coreWatts = 0.0f;
+	power_.dramWatts = 0.0f;
+	float packageJoules = 0.0f;
+
+	for (size_t i = 0; i < counters_.size(); ++i) {
+		DomainCounter& counter = counters_[i];
+		PowerDomain& domain = power_.domains[i];
+
+		int64_t value = 0;
+		if (!counter.energy.ReadInt64(value)) continue;
+		uint64_t energy = static_cast<uint64_t>(value);
+
+		float joules = 0.0f;
+		if (counter.hasEnergy && elapsedSeconds > 0.0f) {
+			joules = static_cast<float>(EnergyDelta(counter.lastEnergy, energy, counter.maxRange)) / 1e6f;
+		}
+		counter.lastEnergy = energy;
+		counter.hasEnergy = true;
+
+		domain.watts = elapsedSeconds > 0.0f ? joules / elapsedSeconds : 0.0f;
+		switch (domain.type) {
+		case PowerDomain::PACKAGE:
+			power_.packageWatts += domain.watts;
+			packageJoules += joules;
+			break;
+		case PowerDomain::CORE: power_.coreWatts += domain.watts; break;
+		case PowerDomain::DRAM: power_.dramWatts += domain.watts; break;
+		default: break;
+		}
+	}
+
+	// Busy CPU time comes from /proc/stat in USER_HZ ticks
+	uint64_t busyTicks = 0;
+	if (ReadCpuBusyTicks(busyTicks)) {
+		static const float ticksPerSecond = static_cast<float>(sysconf(_SC_CLK_TCK));
+		float cpuSeconds = (hasSample_ && busyTicks >= lastCpuBusyTicks_)
+			? static_cast<float>(busyTicks - lastCpuBusyTicks_) / ticksPerSecond
+			: 0.0f;
+		power_.joulesPerCpuSecond = cpuSeconds > 0.0f ? packageJoules / cpuSeconds : 0.0f;
+		lastCpuBusyTicks_ = busyTicks;
+	}
+
+	lastSample_ = now;
+	hasSample_ = true;
+}
+
+uint64_t LinuxPowerMonitor::EnergyDelta(uint64_t previous, uint64_t current, uint64_t maxRange)
+{
+	if (current >= previous) return current - previous;
+
+	// The counter wrapped; without a known range the interval can't be recovered, so report nothing
+	if (maxRange == 0 || previous > maxRange) return 0;
+	return (maxRange - previous) + current;
+}
+
+bool LinuxPowerMonitor::ReadCpuBusyTicks(uint64_t& busyTicks) const
+{
+	std::string text;
+	if (!LinuxProc::ReadFile(procRoot_ + "/stat", text)) return false;
+
+	// Aggregate line: "cpu  user nice system idle iowait irq softirq steal ..."
+	std::istringstream fields(text);
+	std::string label;
+	uint64_t user = 0, nice = 0, system = 0, idle = 0, iowait = 0, irq = 0, softirq = 0, steal = 0;
+	if (!(fields >> label >> user >> nice >> system >> idle >> iowait >> irq >> softirq >> steal) || label != "cpu") {
+		return false;
+	}
+	busyTicks = user + nice + system + irq + softirq;
+	return true;
+}
@@ -0,0 +1,45 @@
+// LinuxPowerMonitor: Package, core and DRAM power from the RAPL energy counters under /sys/class/powercap.
+// Counters are cumulative microjoules that wrap at max_energy_range_uj.
+#pragma once
+#include "../../core/system_state.hpp"
+#include "linux_proc_utils.hpp"
+#include <chrono>
+#include <string>
+#include <vector>
+
+class LinuxPowerMonitor
+{
+public:
+	explicit LinuxPowerMonitor(const std::string& sysRoot = "/sys", const std::string& procRoot = "/proc");
+
+	void Update();
+
+	// False without RAPL (VMs, non-x86) or when energy_uj is root-only, as it is on kernels since 5.10
+	bool IsAvailable() const { return power_.isAvailable; }
+
+	// Current values only; histories are kept by the collector
+	const PowerStats& GetPower() const { return power_; }
+
+	// Energy consumed between two readings of a counter that wraps at maxRange
+	static uint64_t EnergyDelta(uint64_t previous, uint64_t current, uint64_t maxRange);
+
+private:
+	struct DomainCounter
+	{
+		LinuxProc::PolledFile energy; // energy_uj
+		uint64_t maxRange = 0;
+		uint64_t lastEnergy = 0;
+		bool hasEnergy = false;
+	};
+
+	std::string sysRoot_;
+	std::string procRoot_;
+	PowerStats power_;
+	std::vector<DomainCounter> counters_; // Parallel to power_.domains
+	uint64_t lastCpuBusyTicks_ = 0;
+	std::chrono::steady_clock::time_point lastSample_;
+	bool hasSample_ = false;
+
+	void DiscoverDomains();
+	bool ReadCpuBusyTicks(uint64_t& busyTicks) const;
+};
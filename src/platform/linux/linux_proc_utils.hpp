@@ -0,0 +1,131 @@
+// Small helpers shared by the Linux providers for reading procfs/sysfs text files.
+#pragma once
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace LinuxProc
+{
+	inline bool ReadFile(const std::string& path, std::string& out)
+	{
+		std::ifstream file(path, std::ios::in | std::ios::binary);
+		if (!file) return false;
+		std::ostringstream ss;
+		ss << file.rdbuf();
+		out = ss.str();
+		return true;
+	}
+
+	inline bool ReadUInt64(const std::string& path, uint64_t& value)
+	{
+		std::string text;
+		if (!ReadFile(path, text) || text.empty()) return false;
+		char* end = nullptr;
+		value = std::strtoull(text.c_str(), &end, 10);
+		return end != text.c_str();
+	}
+
+	// Names of all entries in a directory, excluding "." and ".."
+	inline std::vector<std::string> ListEntries(const std::string& dir)
+	{
+		std::vector<std::string> names;
+		DIR* d = opendir(dir.c_str());
+		if (!d) return names;
+
+		while (dirent* entry = readdir(d)) {
+			std::string name = entry->d_name;
+			if (name != "." && name != "..") names.push_back(std::move(name));
+		}
+		closedir(d);
+		return names;
+	}
+
+	// Returns the numeric suffixes of entries named "<prefix><N>" in a directory (e.g. node0, node1)
+	inline std::vector<uint32_t> ListNumberedEntries(const std::string& dir, const std::string& prefix)
+	{
+		std::vector<uint32_t> ids;
+		DIR* d = opendir(dir.c_str());
+		if (!d) return ids;
+
+		while (dirent* entry = readdir(d)) {
+			const char* name = entry->d_name;
+			if (prefix.compare(0, prefix.size(), name, 0, prefix.size()) != 0) continue;
+			const char* digits = name + prefix.size();
+			if (*digits < '0' || *digits > '9') continue;
+			char* end = nullptr;
+			unsigned long id = std::strtoul(digits, &end, 10);
+			if (*end != '\0') continue;
+			ids.push_back(static_cast<uint32_t>(id));
+		}
+		closedir(d);
+		return ids;
+	}
+
+	// Parses kernel cpu list syntax such as "0-3,8-11,16"
+	inline std::vector<uint32_t> ParseCpuList(const std::string& text)
+	{
+		std::vector<uint32_t> cpus;
+		size_t pos = 0;
+		while (pos < text.size()) {
+			size_t comma = text.find(',', pos);
+			if (comma == std::string::npos) comma = text.size();
+			std::string range = text.substr(pos, comma - pos);
+			size_t dash = range.find('-');
+			char* end = nullptr;
+			unsigned long first = std::strtoul(range.c_str(), &end, 10);
+			if (end != range.c_str()) {
+				unsigned long last = first;
+				if (dash != std::string::npos) last = std::strtoul(range.c_str() + dash + 1, nullptr, 10);
+				for (unsigned long cpu = first; cpu <= last; ++cpu) cpus.push_back(static_cast<uint32_t>(cpu));
+			}
+			pos = comma + 1;
+		}
+		return cpus;
+	}
+
+	// A small sysfs attribute that stays open and is re-read with pread at offset 0, which makes the
+	// kernel regenerate its contents. Saves an open/close pair per value per tick.
+	class PolledFile
+	{
+	public:
+		PolledFile() = default;
+		explicit PolledFile(const std::string& path) : fd_(open(path.c_str(), O_RDONLY | O_CLOEXEC)) {}
+		~PolledFile() { if (fd_ >= 0) close(fd_); }
+
+		PolledFile(const PolledFile&) = delete;
+		PolledFile& operator=(const PolledFile&) = delete;
+		PolledFile(PolledFile&& other) noexcept : fd_(other.fd_) { other.fd_ = -1; }
+		PolledFile& operator=(PolledFile&& other) noexcept
+		{
+			if (this != &other) {
+				if (fd_ >= 0) close(fd_);
+				fd_ = other.fd_;
+				other.fd_ = -1;
+			}
+			return *this;
+		}
+
+		bool IsOpen() const { return fd_ >= 0; }
+
+		bool ReadInt64(int64_t& value) const
+		{
+			if (fd_ < 0) return false;
+			char buffer[32];
+			ssize_t n = pread(fd_, buffer, sizeof(buffer) - 1, 0);
+			if (n <= 0) return false;
+			buffer[n] = '\0';
+			char* end = nullptr;
+			value = std::strtoll(buffer, &end, 10);
+			return end != buffer;
+		}
+
+	private:
+		int fd_ = -1;
+	};
+}
\ No newline at end of file
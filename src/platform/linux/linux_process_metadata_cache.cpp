@@ -0,0 +1,141 @@
+#include "linux_process_metadata_cache.hpp"
+#include "linux_proc_utils.hpp"
+#include <charconv>
+#include <climits>
+#include <unistd.h>
+
+LinuxProcessMetadataCache::LinuxProcessMetadataCache(const std::string& procRoot, std::chrono::milliseconds readTimeout)
+	: procRoot_(procRoot), worker_(readTimeout), results_(std::make_shared<Results>())
+{
+}
+
+void LinuxProcessMetadataCache::Request(uint32_t pid, uint64_t startTime)
+{
+	auto it = entries_.find(pid);
+	if (it != entries_.end() && it->second.startTime == startTime) return; // Loaded or in flight
+
+	Entry& entry = entries_[pid];
+	entry = Entry{};
+	entry.startTime = startTime;
+
+	std::shared_ptr<Results> results = results_;
+	std::string pidDir = procRoot_ + "/" + std::to_string(pid);
+	worker_.Submit(JobKey(pid, startTime), [results, pidDir, pid, startTime]() {
+		Finished done;
+		done.pid = pid;
+		done.startTime = startTime;
+		done.metadata = Read(pidDir);
+
+		std::lock_guard<std::mutex> lock(results->mutex);
+		results->finished.push_back(std::move(done));
+	});
+}
+
+bool LinuxProcessMetadataCache::Update()
+{
+	bool added = false;
+
+	// A hung read is recorded as such and never retried; the process is most likely stuck for good
+	for (const auto& key : worker_.CheckTimeouts()) {
+		uint32_t pid = 0;
+		uint64_t startTime = 0;
+		if (!ParseJobKey(key, pid, startTime)) continue;
+		auto it = entries_.find(pid);
+		if (it == entries_.end() || it->second.startTime != startTime) continue;
+		it->second.loaded = true;
+		it->second.metadata.timedOut = true;
+		added = true;
+	}
+
+	std::vector<Finished> finished;
+	{
+		std::lock_guard<std::mutex> lock(results_->mutex);
+		finished.swap(results_->finished);
+	}
+	for (auto& done : finished) {
+		// Dropped by Prune or replaced by a newer process with the same pid while the read was running
+		auto it = entries_.find(done.pid);
+		if (it == entries_.end() || it->second.startTime != done.startTime) continue;
+		it->second.loaded = true;
+		it->second.metadata = std::move(done.metadata);
+		added = true;
+	}
+	return added;
+}
+
+const ProcessMetadata* LinuxProcessMetadataCache::Find(uint32_t pid, uint64_t startTime) const
+{
+	auto it = entries_.find(pid);
+	if (it == entries_.end() || it->second.startTime != startTime || !it->second.loaded) return nullptr;
+	return &it->second.metadata;
+}
+
+void LinuxProcessMetadataCache::Prune(const std::function<bool(uint32_t pid, uint64_t startTime)>& isAlive)
+{
+	for (auto it = entries_.begin(); it != entries_.end();) {
+		if (isAlive(it->first, it->second.startTime)) {
+			++it;
+		} else {
+			it = entries_.erase(it);
+		}
+	}
+}
+
+ProcessMetadata LinuxProcessMetadataCache::Read(const std::string& pidDir)
+{
+	ProcessMetadata metadata;
+
+	std::string text;
+	if (LinuxProc::ReadFile(pidDir + "/cmdline", text)) metadata.commandLine = ParseCommandLine(text);
+	if (LinuxProc::ReadFile(pidDir + "/cgroup", text)) metadata.cgroup = ParseCgroup(text);
+
+	// exe and cwd are only readable for our own processes unless running privileged
+	char target[PATH_MAX];
+	ssize_t length = readlink((pidDir + "/exe").c_str(), target, sizeof(target));
+	if (length > 0) metadata.executablePath.assign(target, static_cast<size_t>(length));
+	length = readlink((pidDir + "/cwd").c_str(), target, sizeof(target));
+	if (length > 0) metadata.workingDirectory.assign(target, static_cast<size_t>(length));
+	return metadata;
+}
+
+std::string LinuxProcessMetadataCache::ParseCommandLine(const std::string& raw)
+{
+	// Arguments are NUL-separated with a trailing NUL; kernel threads have an empty cmdline
+	std::string commandLine = raw;
+	while (!commandLine.empty() && commandLine.back() == '\0') commandLine.pop_back();
+	for (char& c : commandLine) {
+		if (c == '\0' || c == '\n') c = ' ';
+	}
+	return commandLine;
+}
+
+std::string LinuxProcessMetadataCache::ParseCgroup(const std::string& text)
+{
+	// "hierarchy-ID:controllers:path" per line; the unified (v2) hierarchy is "0::/path" and wins when present
+	std::string fallback;
+	std::istringstream lines(text);
+	std::string line;
+	while (std::getline(lines, line)) {
+		size_t first = line.find(':');
+		size_t second = first == std::string::npos ? std::string::npos : line.find(':', first + 1);
+		if (second == std::string::npos) continue;
+		std::string path = line.substr(second + 1);
+		if (line.compare(0, second + 1, "0::") == 0) return path;
+		if (fallback.empty()) fallback = path;
+	}
+	return fallback;
+}
+
+std::string LinuxProcessMetadataCache::JobKey(uint32_t pid, uint64_t startTime)
+{
+	return std::to_string(pid) + "/" + std::to_string(startTime);
+}
+
+bool LinuxProcessMetadataCache::ParseJobKey(const std::string& key, uint32_t& pid, uint64_t& startTime)
+{
+	const char* begin = key.data();
+	const char* end = key.data() + key.size();
+	auto parsedPid = std::from_chars(begin, end, pid);
+	if (parsedPid.ec != std::errc() || parsedPid.ptr == end || *parsedPid.ptr != '/') return false;
+	return std::from_chars(parsedPid.ptr + 1, end, startTime).ec == std::errc();
+}
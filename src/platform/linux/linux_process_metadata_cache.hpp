@@ -0,0 +1,70 @@
+// LinuxProcessMetadataCache: Command line, executable, working directory and cgroup per process, read once.
+// Entries are keyed by (pid, start time) so a reused pid never inherits another process's details. Reads run
+// on a TimeoutWorker because /proc/[pid]/cmdline blocks while the target holds its mmap lock (D state).
+#pragma once
+#include "../../core/process_store.hpp"
+#include "timeout_worker.hpp"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class LinuxProcessMetadataCache
+{
+public:
+	explicit LinuxProcessMetadataCache(const std::string& procRoot = "/proc",
+		std::chrono::milliseconds readTimeout = std::chrono::milliseconds(500));
+
+	// Queues a fetch unless this process is already loaded or in flight; cheap enough to call every frame
+	void Request(uint32_t pid, uint64_t startTime);
+
+	// Publishes finished fetches and gives up on hung ones; returns true if any entry was added
+	bool Update();
+
+	// nullptr until loaded, or if the pid now belongs to a different process
+	const ProcessMetadata* Find(uint32_t pid, uint64_t startTime) const;
+
+	// Forgets processes that exited; isAlive is asked once per cached or pending entry
+	void Prune(const std::function<bool(uint32_t pid, uint64_t startTime)>& isAlive);
+
+	size_t GetCachedCount() const { return entries_.size(); }
+
+	// Blocking reads of one /proc/[pid] directory; exposed for the worker and for testing against a fake procfs
+	static ProcessMetadata Read(const std::string& pidDir);
+	static std::string ParseCommandLine(const std::string& raw);
+	static std::string ParseCgroup(const std::string& text);
+
+private:
+	struct Entry
+	{
+		uint64_t startTime = 0;
+		bool loaded = false;
+		ProcessMetadata metadata;
+	};
+
+	struct Finished
+	{
+		uint32_t pid = 0;
+		uint64_t startTime = 0;
+		ProcessMetadata metadata;
+	};
+
+	// Shared with worker jobs, which may outlive this cache if they hang
+	struct Results
+	{
+		std::mutex mutex;
+		std::vector<Finished> finished;
+	};
+
+	std::string procRoot_;
+	TimeoutWorker worker_;
+	std::shared_ptr<Results> results_;
+	std::unordered_map<uint32_t, Entry> entries_;
+
+	static std::string JobKey(uint32_t pid, uint64_t startTime);
+	static bool ParseJobKey(const std::string& key, uint32_t& pid, uint64_t& startTime);
+};
@@ -0,0 +1,143 @@
+#include "linux_process_monitor.hpp"
+#include "linux_proc_utils.hpp"
+#include <algorithm>
+#include <sstream>
+#include <sys/stat.h>
+#include <unistd.h>
+
+LinuxProcessMonitor::LinuxProcessMonitor(const std::string& procRoot, const std::string& passwdPath)
+	: procRoot_(procRoot), userNames_(passwdPath), metadata_(procRoot)
+{
+}
+
+void LinuxProcessMonitor::UpdateProcesses()
+{
+	static const float ticksPerSecond = static_cast<float>(sysconf(_SC_CLK_TCK));
+	static const float cpuCount = static_cast<float>(std::max(1L, sysconf(_SC_NPROCESSORS_ONLN)));
+
+	auto now = std::chrono::steady_clock::now();
+	float elapsedSeconds = hasScan_ ? std::chrono::duration<float>(now - lastScan_).count() : 0.0f;
+	userNames_.Refresh();
+	metadata_.Update();
+
+	std::vector<ProcessInfo> processes;
+	std::unordered_map<uint32_t, ProcessSample> samples;
+	uint32_t totalThreads = 0;
+
+	for (uint32_t pid : LinuxProc::ListNumberedEntries(procRoot_, "")) {
+		ProcessInfo process;
+		ProcessSample sample;
+		if (!ReadProcess(pid, process, sample)) continue; // Exited mid-scan
+
+		process.userName = userNames_.Lookup(process.uid);
+		if (const ProcessMetadata* metadata = metadata_.Find(pid, sample.startTime)) {
+			process.filePath = metadata->executablePath;
+			process.commandLine = metadata->commandLine;
+		}
+
+		auto previous = lastSamples_.find(pid);
+		if (elapsedSeconds > 0.0f && previous != lastSamples_.end() && previous->second.startTime == sample.startTime) {
+			const ProcessSample& before = previous->second;
+			// Share of the whole machine, matching the system CPU figure, so per-user totals sum to at most 100%
+			if (sample.cpuTicks >= before.cpuTicks) {
+				process.cpuUsagePercent = static_cast<float>(sample.cpuTicks - before.cpuTicks) / (elapsedSeconds * ticksPerSecond * cpuCount) * 100.0f;
+			}
+			if (sample.readBytes >= before.readBytes) {
+				process.ioReadBytesPerSec = static_cast<uint64_t>(static_cast<float>(sample.readBytes - before.readBytes) / elapsedSeconds);
+			}
+			if (sample.writeBytes >= before.writeBytes) {
+				process.ioWriteBytesPerSec = static_cast<uint64_t>(static_cast<float>(sample.writeBytes - before.writeBytes) / elapsedSeconds);
+			}
+		}
+
+		totalThreads += process.threadCount;
+		samples.emplace(pid, sample);
+		processes.push_back(std::move(process));
+	}
+
+	processes_ = std::move(processes);
+	lastSamples_ = std::move(samples);
+	metadata_.Prune([this](uint32_t pid, uint64_t startTime) {
+		auto sample = lastSamples_.find(pid);
+		return sample != lastSamples_.end() && sample->second.startTime == startTime;
+	});
+	totalThreads_ = totalThreads;
+	lastScan_ = now;
+	hasScan_ = true;
+}
+
+void LinuxProcessMonitor::RequestMetadata(uint32_t pid)
+{
+	auto sample = lastSamples_.find(pid);
+	if (sample != lastSamples_.end()) metadata_.Request(pid, sample->second.startTime);
+}
+
+const ProcessMetadata* LinuxProcessMonitor::GetMetadata(uint32_t pid) const
+{
+	auto sample = lastSamples_.find(pid);
+	return sample == lastSamples_.end() ? nullptr : metadata_.Find(pid, sample->second.startTime);
+}
+
+bool LinuxProcessMonitor::ReadProcess(uint32_t pid, ProcessInfo& process, ProcessSample& sample) const
+{
+	static const uint64_t pageSize = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+	std::string pidDir = procRoot_ + "/" + std::to_string(pid);
+
+	std::string stat;
+	if (!LinuxProc::ReadFile(pidDir + "/stat", stat)) return false;
+
+	// "pid (comm) state ppid ..." - comm may itself contain spaces and parentheses, so split on the last ')'
+	size_t nameStart = stat.find('(');
+	size_t nameEnd = stat.rfind(')');
+	if (nameStart == std::string::npos || nameEnd == std::string::npos || nameEnd < nameStart) return false;
+
+	process.pid = pid;
+	process.name = stat.substr(nameStart + 1, nameEnd - nameStart - 1);
+
+	// Fields from 3 (state) onward; ppid is 4, utime/stime are 14/15, num_threads 20, starttime 22, rss 24
+	std::istringstream fields(stat.substr(nameEnd + 2));
+	std::string field;
+	std::vector<std::string> values;
+	values.reserve(22);
+	while (values.size() < 22 && fields >> field) values.push_back(field);
+	if (values.size() < 22) return false;
+
+	auto number = [&values](size_t fieldNumber) { return std::strtoull(values[fieldNumber - 3].c_str(), nullptr, 10); };
+	process.status = StatusName(values[0].empty() ? '?' : values[0][0]);
+	process.parentPid = static_cast<uint32_t>(number(4));
+	sample.cpuTicks = number(14) + number(15);
+	process.threadCount = static_cast<uint32_t>(number(20));
+	sample.startTime = number(22);
+	process.memoryUsage = number(24) * pageSize;
+
+	// The /proc/[pid] directory is owned by the process's effective uid
+	struct stat owner = {};
+	if (::stat(pidDir.c_str(), &owner) == 0) process.uid = owner.st_uid;
+
+	// Only readable for our own processes unless running privileged; rates stay 0 otherwise
+	std::string io;
+	if (LinuxProc::ReadFile(pidDir + "/io", io)) {
+		std::istringstream lines(io);
+		std::string key;
+		uint64_t value = 0;
+		while (lines >> key >> value) {
+			if (key == "read_bytes:") sample.readBytes = value;
+			else if (key == "write_bytes:") sample.writeBytes = value;
+		}
+	}
+	return true;
+}
+
+const char* LinuxProcessMonitor::StatusName(char state)
+{
+	switch (state) {
+	case 'R': return "Running";
+	case 'S': return "Sleeping";
+	case 'D': return "Disk Sleep";
+	case 'Z': return "Zombie";
+	case 'T':
+	case 't': return "Stopped";
+	case 'I': return "Idle";
+	default: return "Unknown";
+	}
+}
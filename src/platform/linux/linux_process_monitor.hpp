@@ -0,0 +1,49 @@
+// LinuxProcessMonitor: Scans /proc for per-process CPU, memory, threads, disk I/O and owning user.
+// Executable path and command line are filled in from a lazy cache once something asked for them.
+#pragma once
+#include "../../core/interfaces/i_process_monitor.hpp"
+#include "linux_process_metadata_cache.hpp"
+#include "user_name_cache.hpp"
+#include <chrono>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class LinuxProcessMonitor : public IProcessMonitor
+{
+public:
+	explicit LinuxProcessMonitor(const std::string& procRoot = "/proc", const std::string& passwdPath = "/etc/passwd");
+
+	void UpdateProcesses() override;
+	std::vector<ProcessInfo> GetProcesses() const override { return processes_; }
+	size_t GetProcessCount() const override { return processes_.size(); }
+
+	uint32_t GetTotalThreads() const { return totalThreads_; }
+
+	// Starts loading a process's metadata in the background; it shows up in GetProcesses from the next scan
+	void RequestMetadata(uint32_t pid);
+	// nullptr until loaded or for pids that weren't in the last scan
+	const ProcessMetadata* GetMetadata(uint32_t pid) const;
+
+private:
+	// Previous counters per pid; startTime guards against a reused pid inheriting another process's deltas
+	struct ProcessSample
+	{
+		uint64_t startTime = 0;
+		uint64_t cpuTicks = 0;
+		uint64_t readBytes = 0;
+		uint64_t writeBytes = 0;
+	};
+
+	std::string procRoot_;
+	UserNameCache userNames_;
+	LinuxProcessMetadataCache metadata_;
+	std::vector<ProcessInfo> processes_;
+	std::unordered_map<uint32_t, ProcessSample> lastSamples_;
+	uint32_t totalThreads_ = 0;
+	std::chrono::steady_clock::time_point lastScan_;
+	bool hasScan_ = false;
+
+	bool ReadProcess(uint32_t pid, ProcessInfo& process, ProcessSample& sample) const;
+	static const char* StatusName(char state);
+};
@@ -0,0 +1,122 @@
+#include "linux_sensor_monitor.hpp"
+#include <algorithm>
+
+LinuxSensorMonitor::LinuxSensorMonitor(const std::string& sysRoot)
+	: sysRoot_(sysRoot)
+{
+	DiscoverHwmon();
+	DiscoverCpuFrequency();
+	sensors_.isAvailable = !sensors_.temperatures.empty() || !sensors_.fans.empty() || !sensors_.cpuFrequencies.empty();
+}
+
+void LinuxSensorMonitor::DiscoverHwmon()
+{
+	std::string hwmonRoot = sysRoot_ + "/class/hwmon";
+	std::vector<uint32_t> ids = LinuxProc::ListNumberedEntries(hwmonRoot, "hwmon");
+	std::sort(ids.begin(), ids.end());
+
+	for (uint32_t id : ids) {
+		std::string chipDir = hwmonRoot + "/hwmon" + std::to_string(id);
+		std::string chip;
+		if (LinuxProc::ReadFile(chipDir + "/name", chip)) {
+			chip.erase(chip.find_last_not_of(" \n") + 1);
+		}
+		if (chip.empty()) chip = "hwmon" + std::to_string(id);
+
+		AddHwmonChannels(chipDir, chip, "temp", 0.001f, sensors_.temperatures, temperatureInputs_); // millidegrees
+		AddHwmonChannels(chipDir, chip, "fan", 1.0f, sensors_.fans, fanInputs_);
+	}
+}
+
+void LinuxSensorMonitor::AddHwmonChannels(const std::string& chipDir, const std::string& chip, const std::string& type,
+	float scale, std::vector<SensorReading>& readings, std::vector<LinuxProc::PolledFile>& inputs)
+{
+	// Channels are named "<type><N>_input" and aren't always numbered contiguously
+	std::vector<uint32_t> channels;
+	for (const auto& name : LinuxProc::ListEntries(chipDir)) {
+		if (name.compare(0, type.size(), type) != 0) continue;
+		char* end = nullptr;
+		unsigned long channel = std::strtoul(name.c_str() + type.size(), &end, 10);
+		if (end == name.c_str() + type.size() || std::string(end) != "_input") continue;
+		channels.push_back(static_cast<uint32_t>(channel));
+	}
+	std::sort(channels.begin(), channels.end());
+
+	for (uint32_t channel : channels) {
+		std::string base = chipDir + "/" + type + std::to_string(channel);
+		LinuxProc::PolledFile input(base + "_input");
+		if (!input.IsOpen()) continue;
+
+		SensorReading reading;
+		reading.chip = chip;
+		if (LinuxProc::ReadFile(base + "_label", reading.label)) {
+			reading.label.erase(reading.label.find_last_not_of(" \n") + 1);
+		}
+		if (reading.label.empty()) reading.label = type + std::to_string(channel);
+
+		int64_t critical = 0;
+		LinuxProc::PolledFile criticalFile(base + "_crit");
+		if (criticalFile.ReadInt64(critical)) reading.critical = static_cast<float>(critical) * scale;
+
+		readings.push_back(reading);
+		inputs.push_back(std::move(input));
+	}
+}
+
+void LinuxSensorMonitor::DiscoverCpuFrequency()
+{
+	std::string cpuRoot = sysRoot_ + "/devices/system/cpu";
+	std::vector<uint32_t> ids = LinuxProc::ListNumberedEntries(cpuRoot, "cpu");
+	std::sort(ids.begin(), ids.end());
+
+	for (uint32_t id : ids) {
+		std::string cpuDir = cpuRoot + "/cpu" + std::to_string(id);
+		CpuInputs inputs;
+		inputs.frequency = LinuxProc::PolledFile(cpuDir + "/cpufreq/scaling_cur_freq");
+		inputs.throttle = LinuxProc::PolledFile(cpuDir + "/thermal_throttle/core_throttle_count");
+		if (!inputs.frequency.IsOpen() && !inputs.throttle.IsOpen()) continue;
+
+		CpuFrequency frequency;
+		frequency.cpu = id;
+		uint64_t maxKHz = 0;
+		if (LinuxProc::ReadUInt64(cpuDir + "/cpufreq/cpuinfo_max_freq", maxKHz)) {
+			frequency.maxMHz = static_cast<float>(maxKHz) / 1000.0f;
+		}
+
+		sensors_.cpuFrequencies.push_back(frequency);
+		cpuInputs_.push_back(std::move(inputs));
+	}
+}
+
+void LinuxSensorMonitor::Update()
+{
+	if (!sensors_.isAvailable) return;
+
+	auto now = std::chrono::steady_clock::now();
+	float elapsedSeconds = hasSample_ ? std::chrono::duration<float>(now - lastSample_).count() : 0.0f;
+
+	// A read that fails (sensor went away, driver error) keeps the previous value
+	int64_t value = 0;
+	for (size_t i = 0; i < temperatureInputs_.size(); ++i) {
+		if (temperatureInputs_[i].ReadInt64(value)) sensors_.temperatures[i].value = static_cast<float>(value) * 0.001f;
+	}
+	for (size_t i = 0; i < fanInputs_.size(); ++i) {
+		if (fanInputs_[i].ReadInt64(value)) sensors_.fans[i].value = static_cast<float>(value);
+	}
+
+	for (size_t i = 0; i < cpuInputs_.size(); ++i) {
+		CpuFrequency& cpu = sensors_.cpuFrequencies[i];
+		if (cpuInputs_[i].frequency.ReadInt64(value)) cpu.currentMHz = static_cast<float>(value) / 1000.0f;
+
+		if (cpuInputs_[i].throttle.ReadInt64(value)) {
+			uint64_t count = static_cast<uint64_t>(value);
+			cpu.throttlesPerSec = (elapsedSeconds > 0.0f && count >= cpu.throttleCount)
+				? static_cast<float>(count - cpu.throttleCount) / elapsedSeconds
+				: 0.0f;
+			cpu.throttleCount = count;
+		}
+	}
+
+	lastSample_ = now;
+	hasSample_ = true;
+}
@@ -0,0 +1,41 @@
+// LinuxSensorMonitor: Temperatures and fan speeds from /sys/class/hwmon, per-core frequency and throttle counts
+// from /sys/devices/system/cpu. Inputs are discovered once and kept open, so a tick is one pread per value.
+#pragma once
+#include "../../core/system_state.hpp"
+#include "linux_proc_utils.hpp"
+#include <chrono>
+#include <string>
+#include <vector>
+
+class LinuxSensorMonitor
+{
+public:
+	explicit LinuxSensorMonitor(const std::string& sysRoot = "/sys");
+
+	void Update();
+
+	bool IsAvailable() const { return sensors_.isAvailable; }
+
+	// Current values only; histories are kept by the collector
+	const SensorStats& GetSensors() const { return sensors_; }
+
+private:
+	struct CpuInputs
+	{
+		LinuxProc::PolledFile frequency;  // scaling_cur_freq, kHz
+		LinuxProc::PolledFile throttle;   // thermal_throttle/core_throttle_count
+	};
+
+	std::string sysRoot_;
+	SensorStats sensors_;
+	std::vector<LinuxProc::PolledFile> temperatureInputs_; // Parallel to sensors_.temperatures
+	std::vector<LinuxProc::PolledFile> fanInputs_;         // Parallel to sensors_.fans
+	std::vector<CpuInputs> cpuInputs_;                     // Parallel to sensors_.cpuFrequencies
+	std::chrono::steady_clock::time_point lastSample_;
+	bool hasSample_ = false;
+
+	void DiscoverHwmon();
+	void DiscoverCpuFrequency();
+	void AddHwmonChannels(const std::string& chipDir, const std::string& chip, const std::string& type,
+		float scale, std::vector<SensorReading>& readings, std::vector<LinuxProc::PolledFile>& inputs);
+};
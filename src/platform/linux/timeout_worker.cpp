@@ -0,0 +1,103 @@
+#include "timeout_worker.hpp"
+
+TimeoutWorker::TimeoutWorker(std::chrono::milliseconds timeout)
+	: timeout_(timeout), queue_(std::make_shared<Queue>())
+{
+	StartWorker();
+}
+
+TimeoutWorker::~TimeoutWorker()
+{
+	{
+		std::lock_guard<std::mutex> lock(queue_->mutex);
+		queue_->stopping = true;
+		queue_->jobs.clear();
+	}
+	queue_->wake.notify_all();
+
+	// A thread stuck in a blocking call can't be joined without hanging shutdown
+	if (thread_.joinable()) {
+		if (current_->jobStartMs.load() != 0) {
+			thread_.detach();
+		} else {
+			thread_.join();
+		}
+	}
+}
+
+bool TimeoutWorker::Submit(const std::string& key, std::function<void()> job)
+{
+	{
+		std::lock_guard<std::mutex> lock(queue_->mutex);
+		if (!queue_->pendingKeys.insert(key).second) return false;
+		queue_->jobs.push_back({ key, std::move(job) });
+	}
+	queue_->wake.notify_one();
+	return true;
+}
+
+std::vector<std::string> TimeoutWorker::CheckTimeouts()
+{
+	std::vector<std::string> abandonedKeys;
+
+	int64_t startedMs = current_->jobStartMs.load();
+	if (startedMs == 0 || NowMs() - startedMs < timeout_.count()) return abandonedKeys;
+
+	{
+		std::lock_guard<std::mutex> lock(queue_->mutex);
+		if (current_->jobStartMs.load() != startedMs) return abandonedKeys; // Finished in the meantime
+
+		// The key stays pending until the stuck call returns, so it isn't queued again meanwhile
+		abandonedKeys.push_back(current_->runningKey);
+		current_->abandoned = true;
+	}
+	queue_->wake.notify_all();
+	thread_.detach();
+	++abandonedCount_;
+
+	StartWorker();
+	return abandonedKeys;
+}
+
+bool TimeoutWorker::IsPending(const std::string& key) const
+{
+	std::lock_guard<std::mutex> lock(queue_->mutex);
+	return queue_->pendingKeys.count(key) > 0;
+}
+
+void TimeoutWorker::StartWorker()
+{
+	current_ = std::make_shared<WorkerState>();
+	thread_ = std::thread(&TimeoutWorker::WorkerLoop, queue_, current_);
+}
+
+void TimeoutWorker::WorkerLoop(std::shared_ptr<Queue> queue, std::shared_ptr<WorkerState> state)
+{
+	std::unique_lock<std::mutex> lock(queue->mutex);
+	for (;;) {
+		queue->wake.wait(lock, [&queue, &state]() {
+			return queue->stopping || state->abandoned.load() || !queue->jobs.empty();
+		});
+		if (queue->stopping || state->abandoned.load()) return;
+
+		Job job = std::move(queue->jobs.front());
+		queue->jobs.pop_front();
+		state->runningKey = job.key;
+		state->jobStartMs = NowMs();
+		lock.unlock();
+
+		job.run();
+
+		lock.lock();
+		state->jobStartMs = 0;
+		queue->pendingKeys.erase(job.key);
+		if (state->abandoned.load()) return;
+	}
+}
+
+int64_t TimeoutWorker::NowMs()
+{
+	// Offset by one so a job started at the clock's epoch is never mistaken for "idle"
+	return std::chrono::duration_cast<std::chrono::milliseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count() + 1;
+}
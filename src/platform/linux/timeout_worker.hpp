@@ -0,0 +1,68 @@
+// TimeoutWorker: Runs potentially blocking calls (statvfs on network mounts, reads of /proc/[pid] files
+// of D-state processes) off the collector thread. A call that overruns its timeout is abandoned: its thread
+// is detached and a fresh thread takes over the queue, so one hung call can't stall everything behind it.
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+class TimeoutWorker
+{
+public:
+	explicit TimeoutWorker(std::chrono::milliseconds timeout);
+	~TimeoutWorker();
+
+	TimeoutWorker(const TimeoutWorker&) = delete;
+	TimeoutWorker& operator=(const TimeoutWorker&) = delete;
+
+	// Queues a job under a key; returns false if a job with that key is still queued or running.
+	// Jobs must only capture state they co-own (e.g. via shared_ptr), since an abandoned job can outlive this object.
+	bool Submit(const std::string& key, std::function<void()> job);
+
+	// Abandons the running job if it exceeded the timeout; returns the keys abandoned by this call
+	std::vector<std::string> CheckTimeouts();
+
+	bool IsPending(const std::string& key) const;
+	size_t GetAbandonedCount() const { return abandonedCount_; }
+
+private:
+	struct Job
+	{
+		std::string key;
+		std::function<void()> run;
+	};
+
+	struct Queue
+	{
+		std::mutex mutex;
+		std::condition_variable wake;
+		std::deque<Job> jobs;
+		std::unordered_set<std::string> pendingKeys; // Queued, running or stuck
+		bool stopping = false;
+	};
+
+	struct WorkerState
+	{
+		std::atomic<bool> abandoned{ false };
+		std::atomic<int64_t> jobStartMs{ 0 }; // 0 while idle
+		std::string runningKey;               // Guarded by Queue::mutex
+	};
+
+	std::chrono::milliseconds timeout_;
+	std::shared_ptr<Queue> queue_;
+	std::shared_ptr<WorkerState> current_;
+	std::thread thread_;
+	size_t abandonedCount_ = 0;
+
+	void StartWorker();
+	static void WorkerLoop(std::shared_ptr<Queue> queue, std::shared_ptr<WorkerState> state);
+	static int64_t NowMs();
+};
@@ -0,0 +1,66 @@
+#include "user_name_cache.hpp"
+#include "linux_proc_utils.hpp"
+#include <pwd.h>
+#include <sys/stat.h>
+#include <vector>
+
+UserNameCache::UserNameCache(const std::string& passwdPath)
+	: passwdPath_(passwdPath)
+{
+	Refresh();
+}
+
+void UserNameCache::Refresh()
+{
+	struct stat info = {};
+	if (stat(passwdPath_.c_str(), &info) != 0) return;
+
+	if (info.st_mtim.tv_sec == lastModified_.tv_sec && info.st_mtim.tv_nsec == lastModified_.tv_nsec &&
+		static_cast<long long>(info.st_size) == lastSize_) {
+		return;
+	}
+	lastModified_ = info.st_mtim;
+	lastSize_ = static_cast<long long>(info.st_size);
+	Load();
+}
+
+void UserNameCache::Load()
+{
+	names_.clear();
+
+	std::string text;
+	if (!LinuxProc::ReadFile(passwdPath_, text)) return;
+
+	// "name:password:uid:gid:gecos:home:shell"
+	size_t lineStart = 0;
+	while (lineStart < text.size()) {
+		size_t lineEnd = text.find('\n', lineStart);
+		if (lineEnd == std::string::npos) lineEnd = text.size();
+
+		size_t nameEnd = text.find(':', lineStart);
+		size_t passwordEnd = nameEnd < lineEnd ? text.find(':', nameEnd + 1) : std::string::npos;
+		if (passwordEnd < lineEnd && text[lineStart] != '#') {
+			char* end = nullptr;
+			unsigned long uid = std::strtoul(text.c_str() + passwordEnd + 1, &end, 10);
+			if (end != text.c_str() + passwordEnd + 1 && *end == ':') {
+				names_.emplace(static_cast<uint32_t>(uid), text.substr(lineStart, nameEnd - lineStart));
+			}
+		}
+		lineStart = lineEnd + 1;
+	}
+}
+
+const std::string& UserNameCache::Lookup(uint32_t uid)
+{
+	auto it = names_.find(uid);
+	if (it != names_.end()) return it->second;
+
+	std::string name = std::to_string(uid);
+	struct passwd entry = {};
+	struct passwd* result = nullptr;
+	std::vector<char> buffer(1024);
+	if (getpwuid_r(uid, &entry, buffer.data(), buffer.size(), &result) == 0 && result) {
+		name = result->pw_name;
+	}
+	return names_.emplace(uid, name).first->second;
+}
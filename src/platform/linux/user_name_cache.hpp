@@ -0,0 +1,26 @@
+// UserNameCache: uid -> user name from /etc/passwd, parsed once and re-parsed only when the file changes.
+#pragma once
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include <unordered_map>
+
+class UserNameCache
+{
+public:
+	explicit UserNameCache(const std::string& passwdPath = "/etc/passwd");
+
+	// One stat() per call; re-parses only if the file's mtime or size changed
+	void Refresh();
+
+	// uids missing from the file (LDAP, sssd) are resolved once through NSS and cached until the next change
+	const std::string& Lookup(uint32_t uid);
+
+private:
+	std::string passwdPath_;
+	std::unordered_map<uint32_t, std::string> names_;
+	struct timespec lastModified_ = {};
+	long long lastSize_ = -1;
+
+	void Load();
+};
@@ -5,12 +5,15 @@
 #include <algorithm>
 #include <tlhelp32.h>
 #include <psapi.h>
+#include <iphlpapi.h>
 #include <comdef.h>
-#include <cmath>  // Add this for sin function
+#include <cstring>
 
 #define NOMINMAX // Prevent Windows min/max macros from interfering
 
 #pragma comment(lib, "psapi.lib")
+#pragma comment(lib, "iphlpapi.lib")
+#pragma comment(lib, "advapi32.lib")
 
 WindowsSystemMonitor::WindowsSystemMonitor()
 {
@@ -43,11 +46,11 @@ void WindowsSystemMonitor::UpdateSystemMetrics()
 {
 	UpdateCPUUsage();
 	UpdateMemoryInfo();
+	UpdateDiskUsage(); // Collects the PDH query, so counter-based updates come after it
 	UpdateGPUUsage();
-	UpdateDiskUsage();
+	UpdateNetworkData(); // Reads the interface counters the usage figure is derived from
 	UpdateNetworkUsage();
 	UpdateProcessData();
-	UpdateNetworkData(); // Add this missing call
 }
 
 // CPU methods
@@ -224,10 +227,6 @@ void WindowsSystemMonitor::InitializePerformanceCounters()
 	PdhAddCounterA(pdhQuery_, "\\PhysicalDisk(_Total)\\Disk Read Bytes/sec", 0, &diskReadCounter_);
 	PdhAddCounterA(pdhQuery_, "\\PhysicalDisk(_Total)\\Disk Write Bytes/sec", 0, &diskWriteCounter_);
 
-	// Add network counters - Use interface-specific counters for better accuracy
-	PdhAddCounterA(pdhQuery_, "\\Network Interface(*)\\Bytes Sent/sec", 0, &networkSentCounter_);
-	PdhAddCounterA(pdhQuery_, "\\Network Interface(*)\\Bytes Received/sec", 0, &networkReceivedCounter_);
-
 	// Initial collection (need to collect twice for rate counters to work)
 	PdhCollectQueryData(pdhQuery_);
 	Sleep(100); // Wait a bit for initial data
@@ -297,12 +296,44 @@ void WindowsSystemMonitor::UpdateMemoryInfo()
 
 void WindowsSystemMonitor::UpdateGPUUsage()
 {
-	static float gpuOffset = 0.0f;
-	gpuOffset += 0.1f;
-	
-	float baseUsage = cpuUsage_ * 0.6f;
-	float variation = 10.0f * sin(gpuOffset);
-	gpuUsage_ = (std::max)(0.0f, (std::min)(100.0f, baseUsage + variation));
+	// No counters (no WDDM 2.0 driver, or no GPU) means no data, not an estimate
+	gpuUsage_ = 0.0f;
+	if (!gpuEngineCounter_) return;
+
+	// Instances are "pid_<n>_luid_<...>_phys_<n>_eng_<n>_engtype_<type>". Like Task Manager,
+	// sum each engine type across processes and report the busiest type.
+	DWORD bufferSize = 0, itemCount = 0;
+	if (PdhGetFormattedCounterArrayA(gpuEngineCounter_, PDH_FMT_DOUBLE, &bufferSize, &itemCount, nullptr) == PDH_MORE_DATA) {
+		std::vector<BYTE> buffer(bufferSize);
+		auto* items = reinterpret_cast<PDH_FMT_COUNTERVALUE_ITEM_A*>(buffer.data());
+		if (PdhGetFormattedCounterArrayA(gpuEngineCounter_, PDH_FMT_DOUBLE, &bufferSize, &itemCount, items) == ERROR_SUCCESS) {
+			std::unordered_map<std::string, double> engineTypes;
+			for (DWORD i = 0; i < itemCount; ++i) {
+				if (items[i].FmtValue.CStatus != ERROR_SUCCESS) continue;
+				const char* engineType = strstr(items[i].szName, "engtype_");
+				engineTypes[engineType ? engineType + 8 : ""] += items[i].FmtValue.doubleValue;
+			}
+			for (const auto& engine : engineTypes) {
+				gpuUsage_ = (std::max)(gpuUsage_, static_cast<float>(engine.second));
+			}
+			gpuUsage_ = (std::min)(100.0f, gpuUsage_);
+		}
+	}
+
+	if (!gpuDedicatedCounter_) return;
+	bufferSize = 0;
+	itemCount = 0;
+	if (PdhGetFormattedCounterArrayA(gpuDedicatedCounter_, PDH_FMT_LARGE, &bufferSize, &itemCount, nullptr) == PDH_MORE_DATA) {
+		std::vector<BYTE> buffer(bufferSize);
+		auto* items = reinterpret_cast<PDH_FMT_COUNTERVALUE_ITEM_A*>(buffer.data());
+		if (PdhGetFormattedCounterArrayA(gpuDedicatedCounter_, PDH_FMT_LARGE, &bufferSize, &itemCount, items) == ERROR_SUCCESS) {
+			uint64_t dedicated = 0;
+			for (DWORD i = 0; i < itemCount; ++i) {
+				if (items[i].FmtValue.CStatus == ERROR_SUCCESS) dedicated += static_cast<uint64_t>((std::max)(0LL, items[i].FmtValue.largeValue));
+			}
+			gpuMemoryUsed_ = dedicated;
+		}
+	}
 }
 
 void WindowsSystemMonitor::UpdateDiskUsage()
@@ -332,18 +363,6 @@ void WindowsSystemMonitor::UpdateDiskUsage()
 
 void WindowsSystemMonitor::UpdateNetworkUsage()
 {
-	if (!pdhQuery_) return;
-
-	PDH_FMT_COUNTERVALUE sentValue, receivedValue;
-	
-	if (networkSentCounter_ && PdhGetFormattedCounterValue(networkSentCounter_, PDH_FMT_LARGE, NULL, &sentValue) == ERROR_SUCCESS) {
-		networkUploadBytesPerSec_ = static_cast<uint64_t>((std::max)(0LL, sentValue.largeValue));
-	}
-	
-	if (networkReceivedCounter_ && PdhGetFormattedCounterValue(networkReceivedCounter_, PDH_FMT_LARGE, NULL, &receivedValue) == ERROR_SUCCESS) {
-		networkDownloadBytesPerSec_ = static_cast<uint64_t>((std::max)(0LL, receivedValue.largeValue));
-	}
-
 	uint64_t totalNetworkActivity = networkUploadBytesPerSec_ + networkDownloadBytesPerSec_;
 	
 	// Assume a typical 100 Mbps connection (12.5 MB/s) for percentage calculation
@@ -370,6 +389,7 @@ void WindowsSystemMonitor::UpdateProcessData()
 		do {
 			ProcessInfo process;
 			process.pid = pe32.th32ProcessID;
+			process.parentPid = pe32.th32ParentProcessID;
 			process.name = std::string(pe32.szExeFile);
 			process.threadCount = pe32.cntThreads;
 			process.status = "Running";
@@ -387,6 +407,12 @@ void WindowsSystemMonitor::UpdateProcessData()
 			// Estimate CPU usage (simplified)
 			process.cpuUsagePercent = 0.0f; // Would need more complex tracking for real CPU usage per process
 			
+			// Protected and other users' processes may refuse the token query; those stay without an owner
+			if (const ProcessOwner* owner = LookupProcessOwner(pe32.th32ProcessID)) {
+				process.uid = owner->uid;
+				process.userName = owner->name;
+			}
+			
 			processes_.push_back(process);
 			totalProcesses_++;
 			totalThreads_ += pe32.cntThreads;
@@ -403,35 +429,103 @@ void WindowsSystemMonitor::UpdateProcessData()
 		});
 }
 
-void WindowsSystemMonitor::UpdateNetworkData()
+const WindowsSystemMonitor::ProcessOwner* WindowsSystemMonitor::LookupProcessOwner(DWORD pid)
 {
-	// Update network stats
-	networkStats_.totalBytesReceived += networkDownloadBytesPerSec_;
-	networkStats_.totalBytesSent += networkUploadBytesPerSec_;
-	networkStats_.primaryInterface = primaryNetworkInterface_;
+	HANDLE hProcess = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, pid);
+	if (!hProcess) return nullptr;
 	
-	// Simple connection count estimation
-	networkStats_.activeConnections = 50; // Placeholder - would need WinSock or similar for real data
+	HANDLE hToken = nullptr;
+	BOOL hasToken = OpenProcessToken(hProcess, TOKEN_QUERY, &hToken);
+	CloseHandle(hProcess);
+	if (!hasToken) return nullptr;
 	
-	// Update network interfaces (simplified)
-	if (networkStats_.interfaces.empty()) {
-		// Add a default interface for now
-		NetworkInterface defaultInterface;
-		defaultInterface.name = "Ethernet";
-		defaultInterface.type = "Ethernet";
-		defaultInterface.isConnected = true;
-		defaultInterface.ipAddress = "192.168.1.100"; // Placeholder
-		defaultInterface.macAddress = "00:11:22:33:44:55"; // Placeholder
-		defaultInterface.speed = 1000; // 1 Gbps
-		defaultInterface.bytesReceived = networkStats_.totalBytesReceived;
-		defaultInterface.bytesSent = networkStats_.totalBytesSent;
-		
-		networkStats_.interfaces.push_back(defaultInterface);
+	// TOKEN_USER is followed by the SID it points at, so size the buffer from the first call
+	DWORD size = 0;
+	GetTokenInformation(hToken, TokenUser, nullptr, 0, &size);
+	std::vector<BYTE> buffer(size);
+	BOOL hasUser = size > 0 && GetTokenInformation(hToken, TokenUser, buffer.data(), size, &size);
+	CloseHandle(hToken);
+	if (!hasUser) return nullptr;
+	
+	PSID sid = reinterpret_cast<TOKEN_USER*>(buffer.data())->User.Sid;
+	std::string key(static_cast<const char*>(sid), GetLengthSid(sid));
+	auto it = ownersBySid_.find(key);
+	if (it != ownersBySid_.end()) return &it->second;
+	
+	ProcessOwner owner;
+	owner.uid = static_cast<uint32_t>(ownersBySid_.size()) + 1;
+	char name[256];
+	char domain[256];
+	DWORD nameLength = sizeof(name);
+	DWORD domainLength = sizeof(domain);
+	SID_NAME_USE use;
+	if (LookupAccountSidA(nullptr, sid, name, &nameLength, domain, &domainLength, &use)) {
+		owner.name = name;
 	} else {
-		// Update existing interface
-		networkStats_.interfaces[0].bytesReceived = networkStats_.totalBytesReceived;
-		networkStats_.interfaces[0].bytesSent = networkStats_.totalBytesSent;
+		owner.name = "SID-" + std::to_string(owner.uid); // Deleted account or unreachable domain
 	}
+	return &ownersBySid_.emplace(std::move(key), std::move(owner)).first->second;
+}
+
+void WindowsSystemMonitor::UpdateNetworkData()
+{
+	// Rates are taken from the adapters' cumulative octet counters over the time that actually passed, so a late
+	// tick neither inflates nor shrinks them, and the totals are the counters themselves rather than summed rates
+	MIB_IF_TABLE2* table = nullptr;
+	if (GetIfTable2(&table) != NO_ERROR) return;
+	auto now = CounterRate::Clock::now();
+
+	double receivedPerSec = 0.0;
+	double sentPerSec = 0.0;
+	std::unordered_map<uint64_t, InterfaceCounters> counters;
+	networkStats_.interfaces.clear();
+	networkStats_.totalBytesReceived = 0;
+	networkStats_.totalBytesSent = 0;
+
+	for (ULONG i = 0; i < table->NumEntries; ++i) {
+		const MIB_IF_ROW2& row = table->Table[i];
+		// Filter drivers, virtual switches and loopback repeat the traffic of the adapters underneath them
+		if (!row.InterfaceAndOperStatusFlags.HardwareInterface || row.InterfaceAndOperStatusFlags.FilterInterface) continue;
+
+		InterfaceCounters& counter = counters[row.InterfaceLuid.Value];
+		auto previous = interfaceCounters_.find(row.InterfaceLuid.Value);
+		if (previous != interfaceCounters_.end()) counter = previous->second;
+		double rate = 0.0;
+		if (counter.received.update(row.InOctets, now, rate)) receivedPerSec += rate;
+		if (counter.sent.update(row.OutOctets, now, rate)) sentPerSec += rate;
+
+		NetworkInterface networkInterface;
+		int length = WideCharToMultiByte(CP_UTF8, 0, row.Alias, -1, nullptr, 0, nullptr, nullptr);
+		if (length > 1) {
+			networkInterface.name.resize(static_cast<size_t>(length - 1));
+			WideCharToMultiByte(CP_UTF8, 0, row.Alias, -1, networkInterface.name.data(), length, nullptr, nullptr);
+		}
+		networkInterface.type = row.Type == IF_TYPE_IEEE80211 ? "Wi-Fi" : row.Type == IF_TYPE_ETHERNET_CSMACD ? "Ethernet" : "Other";
+		networkInterface.isConnected = row.OperStatus == IfOperStatusUp;
+		networkInterface.bytesReceived = row.InOctets;
+		networkInterface.bytesSent = row.OutOctets;
+		networkInterface.packetsReceived = row.InUcastPkts + row.InNUcastPkts;
+		networkInterface.packetsSent = row.OutUcastPkts + row.OutNUcastPkts;
+		std::ostringstream mac;
+		for (ULONG b = 0; b < row.PhysicalAddressLength; ++b) {
+			mac << (b ? ":" : "") << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(row.PhysicalAddress[b]);
+		}
+		networkInterface.macAddress = mac.str();
+		networkInterface.speed = static_cast<uint32_t>(row.ReceiveLinkSpeed / 1000000); // bits/s to Mbps
+
+		networkStats_.totalBytesReceived += row.InOctets;
+		networkStats_.totalBytesSent += row.OutOctets;
+		networkStats_.interfaces.push_back(std::move(networkInterface));
+	}
+	FreeMibTable(table);
+
+	interfaceCounters_ = std::move(counters); // Also forgets interfaces that went away
+	networkDownloadBytesPerSec_ = static_cast<uint64_t>(receivedPerSec);
+	networkUploadBytesPerSec_ = static_cast<uint64_t>(sentPerSec);
+	networkStats_.primaryInterface = primaryNetworkInterface_;
+
+	// Simple connection count estimation
+	networkStats_.activeConnections = 50; // Placeholder - would need WinSock or similar for real data
 }
 
 void WindowsSystemMonitor::InitializeGPU()
@@ -525,7 +619,16 @@ bool WindowsSystemMonitor::InitializeDXGI()
 
 bool WindowsSystemMonitor::InitializeGPUPerformanceCounters()
 {
-	// This is a simplified implementation
-	// Real GPU performance monitoring would require more complex setup
+	if (!pdhQuery_) return false;
+
+	// Available since Windows 10 1709 with WDDM 2.0+ drivers
+	if (PdhAddCounterA(pdhQuery_, "\\GPU Engine(*)\\Utilization Percentage", 0, &gpuEngineCounter_) != ERROR_SUCCESS) {
+		gpuEngineCounter_ = nullptr;
+		return false;
+	}
+	if (PdhAddCounterA(pdhQuery_, "\\GPU Adapter Memory(*)\\Dedicated Usage", 0, &gpuDedicatedCounter_) != ERROR_SUCCESS) {
+		gpuDedicatedCounter_ = nullptr;
+	}
+	PdhCollectQueryData(pdhQuery_);
 	return true;
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 #include "../../core/interfaces/i_system_monitor.hpp"
+#include "../../core/counter_rate.hpp"
 #include <Windows.h>
 #include <pdh.h>
 #include <dxgi1_4.h>
@@ -9,6 +10,7 @@
 #include <string>
 #include <cstdint>
 #include <vector>
+#include <unordered_map>
 
 #pragma comment(lib, "pdh.lib")
 #pragma comment(lib, "dxgi.lib")
@@ -103,18 +105,35 @@ private:
 	std::string primaryNetworkInterface_ = "Ethernet";
 	NetworkStats networkStats_;
 
+	// Octet counters of each physical interface, keyed by LUID; a new or re-created interface gets a fresh baseline
+	struct InterfaceCounters
+	{
+		CounterRate received;
+		CounterRate sent;
+	};
+	std::unordered_map<uint64_t, InterfaceCounters> interfaceCounters_;
+
 	// Process tracking
 	std::vector<ProcessInfo> processes_;
 	uint32_t totalProcesses_ = 0;
 	uint32_t totalThreads_ = 0;
 
+	// Owner of each SID seen so far, keyed by the SID's bytes. LookupAccountSid can go to a domain controller, so
+	// each SID is resolved once; uid is a small id handed out per SID, since Windows has no numeric uid.
+	struct ProcessOwner
+	{
+		uint32_t uid = 0;
+		std::string name;
+	};
+	std::unordered_map<std::string, ProcessOwner> ownersBySid_;
+
 	// Performance counters
 	PDH_HQUERY pdhQuery_ = nullptr;
 	PDH_HCOUNTER diskUsageCounter_ = nullptr;
 	PDH_HCOUNTER diskReadCounter_ = nullptr;
 	PDH_HCOUNTER diskWriteCounter_ = nullptr;
-	PDH_HCOUNTER networkSentCounter_ = nullptr;
-	PDH_HCOUNTER networkReceivedCounter_ = nullptr;
+	PDH_HCOUNTER gpuEngineCounter_ = nullptr;    // \GPU Engine(*)\Utilization Percentage
+	PDH_HCOUNTER gpuDedicatedCounter_ = nullptr; // \GPU Adapter Memory(*)\Dedicated Usage
 
 	// System info
 	std::string systemName_ = "Windows";
@@ -131,6 +150,7 @@ private:
 	void UpdateDiskUsage();
 	void UpdateNetworkUsage();
 	void UpdateProcessData();
+	const ProcessOwner* LookupProcessOwner(DWORD pid);
 	void UpdateNetworkData();
 	
 	// GPU helper methods
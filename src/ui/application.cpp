@@ -9,7 +9,9 @@
 #include <sstream>
 #include <iomanip>
 #include "clay.h"
+#ifdef _WIN32
 #include <windows.h>
+#endif
 
 // Clay SDL2 renderer function - defined in external file
 extern "C" {
@@ -100,7 +102,7 @@ bool Application::Initialize()
 
     // Initialize modular screens
     screens_[Screen::Performance] = std::make_unique<PerformanceScreen>();
-    screens_[Screen::Processes] = std::make_unique<ProcessesScreen>();
+    screens_[Screen::Processes] = std::make_unique<ProcessesScreen>(dataCollector_.get());
     screens_[Screen::Network] = std::make_unique<NetworkScreen>();
     screens_[Screen::Alerts] = std::make_unique<AlertsScreen>();
 
@@ -140,6 +142,19 @@ void Application::Run()
             {
                 mousePressed = true;
             }
+            else if (event.type == SDL_TEXTINPUT)
+            {
+                // Typed text goes to the visible screen (e.g. the process filter)
+                auto screen = screens_.find(currentScreen_);
+                if (screen != screens_.end()) screen->second->OnTextInput(event.text.text);
+            }
+            else if (event.type == SDL_KEYDOWN && (event.key.keysym.sym == SDLK_BACKSPACE || event.key.keysym.sym == SDLK_ESCAPE))
+            {
+                auto screen = screens_.find(currentScreen_);
+                if (screen != screens_.end()) {
+                    screen->second->OnEditKey(event.key.keysym.sym == SDLK_BACKSPACE ? BaseScreen::EditKey::Backspace : BaseScreen::EditKey::Clear);
+                }
+            }
             else if (event.type == SDL_MOUSEWHEEL)
             {
                 // Improved scroll handling for vertical scrolling
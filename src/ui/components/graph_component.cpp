@@ -1,5 +1,6 @@
 #include "graph_component.hpp"
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <iostream>
 #include <sstream>
@@ -12,7 +13,19 @@ std::vector<GraphRenderInfo>& GraphComponent::GetGraphQueue()
     return graphQueue;
 }
 
-void GraphComponent::RenderTimeSeriesGraph(ClayMan* clayMan, const RingBuffer<float, 300>& data, Clay_Color lineColor, uint32_t height)
+void GraphComponent::RenderTimeSeriesGraph(ClayMan* clayMan, const GraphSeries& data, Clay_Color lineColor, uint32_t height)
+{
+    RenderGraph(clayMan, data, {}, lineColor, height, {});
+}
+
+void GraphComponent::RenderTimeSeriesGraph(ClayMan* clayMan, const GraphSeries& data, SeriesView<uint64_t> times, Clay_Color lineColor, uint32_t height, GraphTimeAxis axis)
+{
+    axis.slotCount = std::clamp<size_t>(axis.slotCount, 1, MaxSlots);
+    axis.slotMs = std::max<uint64_t>(axis.slotMs, 1);
+    RenderGraph(clayMan, data, times, lineColor, height, axis);
+}
+
+void GraphComponent::RenderGraph(ClayMan* clayMan, const GraphSeries& data, SeriesView<uint64_t> times, Clay_Color lineColor, uint32_t height, GraphTimeAxis axis)
 {
     // Calculate responsive sizes based on container height
     uint32_t headerHeight = std::max(30u, static_cast<uint32_t>(height * 0.15f));
@@ -28,7 +41,7 @@ void GraphComponent::RenderTimeSeriesGraph(ClayMan* clayMan, const RingBuffer<fl
     graphContainer.cornerRadius = { 12, 12, 12, 12 }; // More rounded corners
     graphContainer.layout.padding = clayMan->padAll(padding);
     
-    clayMan->element(graphContainer, [clayMan, &data, lineColor, height, headerHeight, graphAreaHeight, bottomLabelHeight, sideLabelsWidth]() {
+    clayMan->element(graphContainer, [clayMan, &data, times, lineColor, height, axis, headerHeight, graphAreaHeight, bottomLabelHeight, sideLabelsWidth]() {
         
         // Header with title and current value
         Clay_ElementDeclaration headerArea = {};
@@ -75,7 +88,7 @@ void GraphComponent::RenderTimeSeriesGraph(ClayMan* clayMan, const RingBuffer<fl
         graphArea.layout.sizing = clayMan->expandXfixedY(graphAreaHeight);
         graphArea.layout.layoutDirection = CLAY_LEFT_TO_RIGHT;
         
-        clayMan->element(graphArea, [clayMan, &data, lineColor, graphAreaHeight, sideLabelsWidth]() {
+        clayMan->element(graphArea, [clayMan, &data, times, lineColor, axis, graphAreaHeight, sideLabelsWidth]() {
             
             // Y-axis labels
             Clay_ElementDeclaration yAxisLabels = {};
@@ -115,8 +128,8 @@ void GraphComponent::RenderTimeSeriesGraph(ClayMan* clayMan, const RingBuffer<fl
             // Clip overflowing bars to the graph content area
             graphContentArea.clip.horizontal = true;
             graphContentArea.clip.vertical = false;
-            clayMan->element(graphContentArea, [clayMan, &data, lineColor, graphAreaHeight]() {
-                RenderGridAndBars(clayMan, data, lineColor, graphAreaHeight - 8);
+            clayMan->element(graphContentArea, [clayMan, &data, times, lineColor, axis, graphAreaHeight]() {
+                RenderGridAndBars(clayMan, data, times, lineColor, graphAreaHeight - 8, axis);
             });
         });
         
@@ -127,9 +140,12 @@ void GraphComponent::RenderTimeSeriesGraph(ClayMan* clayMan, const RingBuffer<fl
         bottomLabels.layout.childAlignment = { CLAY_ALIGN_X_CENTER, CLAY_ALIGN_Y_CENTER };
         bottomLabels.layout.padding = clayMan->padXY(sideLabelsWidth, 4);
         
-        clayMan->element(bottomLabels, [clayMan, bottomLabelHeight]() {
-            // Time range labels (seconds)
-            std::vector<std::string> timeLabels = {"5s", "4s", "3s", "2s", "1s", "Now"};
+        clayMan->element(bottomLabels, [clayMan, axis, bottomLabelHeight]() {
+            // Five ages spread over the axis, oldest first ("5s" ... "1s" for the live view)
+            uint64_t spanMs = axis.slotMs * axis.slotCount;
+            std::vector<std::string> timeLabels;
+            for (uint64_t step = 5; step > 0; --step) timeLabels.push_back(FormatAge(spanMs * step / 5));
+            timeLabels.push_back("Now");
             
             for (const auto& timeLabel : timeLabels) {
                 Clay_ElementDeclaration timeContainer = {};
@@ -148,7 +164,7 @@ void GraphComponent::RenderTimeSeriesGraph(ClayMan* clayMan, const RingBuffer<fl
     });
 }
 
-void GraphComponent::RenderGridAndBars(ClayMan* clayMan, const RingBuffer<float, 300>& data, Clay_Color lineColor, uint32_t height)
+void GraphComponent::RenderGridAndBars(ClayMan* clayMan, const GraphSeries& data, SeriesView<uint64_t> times, Clay_Color lineColor, uint32_t height, GraphTimeAxis axis)
 {
     if (data.size() < 1) {
         // Render "No Data" indicator
@@ -170,13 +186,13 @@ void GraphComponent::RenderGridAndBars(ClayMan* clayMan, const RingBuffer<float,
     Clay_ElementDeclaration layeredContainer = {};
     layeredContainer.layout.sizing = clayMan->expandXY();
     
-    clayMan->element(layeredContainer, [clayMan, &data, lineColor, height]() {
+    clayMan->element(layeredContainer, [clayMan, &data, times, lineColor, height, axis]() {
         
         // Background grid lines
         RenderGridLines(clayMan, height);
         
         // Data visualization with thick bars
-        RenderThickBars(clayMan, data, lineColor, height);
+        RenderThickBars(clayMan, data, times, lineColor, height, axis);
     });
 }
 
@@ -208,14 +224,10 @@ void GraphComponent::RenderGridLines(ClayMan* clayMan, uint32_t height)
     });
 }
 
-void GraphComponent::RenderThickBars(ClayMan* clayMan, const RingBuffer<float, 300>& data, Clay_Color lineColor, uint32_t height)
+void GraphComponent::RenderThickBars(ClayMan* clayMan, const GraphSeries& data, SeriesView<uint64_t> times, Clay_Color lineColor, uint32_t height, GraphTimeAxis axis)
 {
     // Find max value for dynamic scaling
-    float maxValue = 1.0f;
-    for (size_t i = 0; i < data.size(); ++i) {
-        maxValue = std::max(maxValue, data.get(i));
-    }
-    maxValue = std::max(maxValue, 100.0f); // Ensure minimum scale
+    float maxValue = std::max(data.max(), 100.0f); // Ensure minimum scale
     
     // Create container for thick bars
     Clay_ElementDeclaration barsContainer = {};
@@ -224,7 +236,7 @@ void GraphComponent::RenderThickBars(ClayMan* clayMan, const RingBuffer<float, 3
     barsContainer.layout.childGap = 1; // Minimal gap between bars
     barsContainer.layout.childAlignment = { CLAY_ALIGN_X_LEFT, CLAY_ALIGN_Y_BOTTOM };
     
-    clayMan->element(barsContainer, [clayMan, &data, lineColor, height, maxValue]() {
+    clayMan->element(barsContainer, [clayMan, &data, times, lineColor, height, maxValue, axis]() {
         
         // Calculate responsive bar dimensions
         uint32_t minBarWidth = 3; // Minimum bar width for visibility
@@ -235,14 +247,46 @@ void GraphComponent::RenderThickBars(ClayMan* clayMan, const RingBuffer<float, 3
             maxBarWidth
         );
         
-    // Limit number of bars to last 5 samples (~5 seconds)
-    size_t maxBars = 5;
+        // One slot per axis.slotMs for the last axis.slotCount slots. With sample times, each sample goes in the slot
+        // for its age relative to the newest one, so a late or missed tick leaves an empty slot rather than closing up.
+        const size_t maxBars = axis.slotCount;
+        const uint64_t slotMs = axis.slotMs;
+        constexpr size_t noSample = SIZE_MAX;
+        std::array<size_t, MaxSlots> slots;
+        slots.fill(noSample);
         size_t available = data.size();
-        size_t sampleCount = std::min(available, maxBars);
-        size_t startIdx = available > sampleCount ? available - sampleCount : 0;
+        size_t firstSlot = maxBars;
+        bool timed = !times.empty() && times.size() == available;
         
-        for (size_t idx = startIdx; idx < available; ++idx) {
-            float value = data.get(idx);
+        if (timed) {
+            uint64_t newest = times.latest();
+            bool hasOlder = false;
+            for (size_t idx = available; idx-- > 0;) {
+                size_t slotsBack = static_cast<size_t>((newest - times[idx] + slotMs / 2) / slotMs);
+                if (slotsBack >= maxBars) {
+                    hasOlder = true;
+                    break;
+                }
+                size_t& slot = slots[maxBars - 1 - slotsBack];
+                if (slot == noSample) slot = idx; // Two samples in one slot: the newer one wins
+                firstSlot = maxBars - 1 - slotsBack;
+            }
+            if (hasOlder) firstSlot = 0; // Empty leading slots are a gap, not the start of the history
+        } else {
+            size_t sampleCount = std::min(available, maxBars);
+            for (size_t k = 0; k < sampleCount; ++k) slots[k] = available - sampleCount + k;
+            firstSlot = 0;
+        }
+        
+        for (size_t s = firstSlot; s < maxBars; ++s) {
+            if (slots[s] == noSample) {
+                if (!timed) break;
+                Clay_ElementDeclaration gap = {};
+                gap.layout.sizing = clayMan->fixedSize(barWidth, 0);
+                clayMan->element(gap, []() {});
+                continue;
+            }
+            float value = data[slots[s]];
             float normalizedValue = std::clamp(value / maxValue, 0.0f, 1.0f);
             
             // Calculate bar height with minimum visibility
@@ -266,10 +310,18 @@ void GraphComponent::RenderThickBars(ClayMan* clayMan, const RingBuffer<float, 3
     });
 }
 
-void GraphComponent::RenderBarChart(ClayMan* clayMan, const RingBuffer<float, 300>& data, Clay_Color lineColor, uint32_t height)
+std::string GraphComponent::FormatAge(uint64_t ms)
+{
+    uint64_t seconds = ms / 1000;
+    if (seconds < 120) return std::to_string(seconds) + "s";
+    if (seconds < 2 * 3600) return std::to_string(seconds / 60) + "m";
+    return std::to_string(seconds / 3600) + "h";
+}
+
+void GraphComponent::RenderBarChart(ClayMan* clayMan, const GraphSeries& data, Clay_Color lineColor, uint32_t height)
 {
     // Use the new improved rendering method
-    RenderGridAndBars(clayMan, data, lineColor, height);
+    RenderGridAndBars(clayMan, data, {}, lineColor, height);
 }
 
 // Queue methods for future SDL2 integration
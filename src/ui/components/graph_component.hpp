@@ -1,12 +1,20 @@
 #pragma once
 #include "clayman.hpp"
-#include "../../core/ring_buffer.hpp"
+#include "graph_series.hpp"
+#include <cstdint>
 #include <vector>
 #include <SDL.h>
 
+// How a timed graph lays out time: slotCount bars of slotMs each, ending at the newest sample. The default is the
+// live view, one bar per second for the last 5 seconds.
+struct GraphTimeAxis {
+    uint64_t slotMs = 1000;
+    size_t slotCount = 5;
+};
+
 struct GraphRenderInfo {
     int x, y, width, height;
-    RingBuffer<float, 300> data;
+    GraphSeries data; // A view; the history must outlive the queued frame
     Clay_Color lineColor;
     std::string title;
     float maxValue;
@@ -14,8 +22,14 @@ struct GraphRenderInfo {
 
 class GraphComponent {
 public:
-    // Enhanced Clay-based graph rendering with grid, labels, and thick bars
-    static void RenderTimeSeriesGraph(ClayMan* clayMan, const RingBuffer<float, 300>& data, Clay_Color lineColor, uint32_t height = 200);
+    // Enhanced Clay-based graph rendering with grid, labels, and thick bars; data is any numeric history with an
+    // optional scale, read in place while drawing
+    static void RenderTimeSeriesGraph(ClayMan* clayMan, const GraphSeries& data, Clay_Color lineColor, uint32_t height = 200);
+    // Places each sample by its time (milliseconds, one per sample), so late or missed ticks show up as gaps
+    static void RenderTimeSeriesGraph(ClayMan* clayMan, const GraphSeries& data, SeriesView<uint64_t> times, Clay_Color lineColor, uint32_t height = 200, GraphTimeAxis axis = {});
+    
+    // Most bars a time axis can ask for
+    static constexpr size_t MaxSlots = 64;
     
     // SDL2 graph rendering methods (for future enhancement)
     static void QueueGraphForRendering(const GraphRenderInfo& info);
@@ -23,13 +37,17 @@ public:
     static void ClearGraphQueue();
 
 private:
-    // Enhanced Clay-based rendering methods
-    static void RenderGridAndBars(ClayMan* clayMan, const RingBuffer<float, 300>& data, Clay_Color lineColor, uint32_t height);
+    // Enhanced Clay-based rendering methods; an empty times view spaces samples evenly
+    static void RenderGraph(ClayMan* clayMan, const GraphSeries& data, SeriesView<uint64_t> times, Clay_Color lineColor, uint32_t height, GraphTimeAxis axis);
+    static void RenderGridAndBars(ClayMan* clayMan, const GraphSeries& data, SeriesView<uint64_t> times, Clay_Color lineColor, uint32_t height, GraphTimeAxis axis = {});
     static void RenderGridLines(ClayMan* clayMan, uint32_t height);
-    static void RenderThickBars(ClayMan* clayMan, const RingBuffer<float, 300>& data, Clay_Color lineColor, uint32_t height);
+    static void RenderThickBars(ClayMan* clayMan, const GraphSeries& data, SeriesView<uint64_t> times, Clay_Color lineColor, uint32_t height, GraphTimeAxis axis);
+    
+    // "5s", "12m", "6h" for the bottom axis labels
+    static std::string FormatAge(uint64_t ms);
     
     // Legacy method for compatibility
-    static void RenderBarChart(ClayMan* clayMan, const RingBuffer<float, 300>& data, Clay_Color lineColor, uint32_t height);
+    static void RenderBarChart(ClayMan* clayMan, const GraphSeries& data, Clay_Color lineColor, uint32_t height);
     
     // Graph queue for future SDL2 rendering
     static std::vector<GraphRenderInfo>& GetGraphQueue();
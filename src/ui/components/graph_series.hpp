@@ -0,0 +1,50 @@
+// GraphSeries: What a graph draws - a view onto a history of any numeric element type, plus a scale (bytes to
+// KB, say) applied to each value as it is read. Nothing is copied or converted ahead of drawing.
+#pragma once
+#include "../../core/series_stats.hpp"
+#include "../../core/series_view.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <variant>
+
+class GraphSeries {
+public:
+    GraphSeries() = default;
+
+    // scale must be positive so the scaled maximum is the maximum of the scaled values
+    template<typename T>
+    GraphSeries(SeriesView<T> values, float scale = 1.0f) : values_(values), scale_(scale) {}
+
+    // Anything that hands out a view of itself (RingBuffer, HistoryBuffer)
+    template<typename Series>
+        requires requires(const Series& series) { series.view(); }
+    GraphSeries(const Series& series, float scale = 1.0f) : GraphSeries(series.view(), scale) {}
+
+    size_t size() const { return std::visit([](const auto& values) { return values.size(); }, values_); }
+    bool empty() const { return size() == 0; }
+
+    // Scaled value, oldest first; unchecked like SeriesView::operator[]
+    float operator[](size_t index) const
+    {
+        return std::visit([this, index](const auto& values) { return static_cast<float>(values[index]) * scale_; }, values_);
+    }
+
+    float latest() const { return empty() ? 0.0f : (*this)[size() - 1]; }
+
+    // Largest scaled value, 0 when empty; float histories use the SIMD kernels
+    float max() const
+    {
+        return std::visit([this](const auto& values) -> float {
+            if (values.empty()) return 0.0f;
+            using T = typename std::decay_t<decltype(values)>::const_iterator::value_type;
+            if constexpr (std::is_same_v<T, float>) return SeriesStats::Max(values) * scale_;
+            else return static_cast<float>(*std::max_element(values.begin(), values.end())) * scale_;
+        }, values_);
+    }
+
+private:
+    std::variant<SeriesView<float>, SeriesView<double>, SeriesView<uint32_t>, SeriesView<uint64_t>> values_;
+    float scale_ = 1.0f;
+};
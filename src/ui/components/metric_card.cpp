@@ -14,7 +14,7 @@ static std::string FormatPercentage(float percentage)
     return oss.str();
 }
 
-void MetricCard::RenderHardwareMetric(ClayMan* clayMan, const char* title, const char* details, float currentValue, const RingBuffer<float, 300>& history, Clay_Color accentColor)
+void MetricCard::RenderHardwareMetric(ClayMan* clayMan, const char* title, const char* details, float currentValue, const GraphSeries& history, Clay_Color accentColor)
 {
     UICard::Render(clayMan, [clayMan, title, details, currentValue, &history, accentColor]()
         {
@@ -3,7 +3,7 @@
 #include "../application.hpp"
 #include <algorithm>
 
-void TableComponent::RenderProcessTable(ClayMan* clayMan, const std::vector<ProcessInfo>& processes, uint32_t maxRows)
+void TableComponent::RenderProcessTable(ClayMan* clayMan, const ProcessStore& processes, std::span<const uint32_t> order, uint32_t maxRows)
 {
     // Define table columns
     static const std::array<TableColumn, 5> columns = {{
@@ -14,26 +14,20 @@ void TableComponent::RenderProcessTable(ClayMan* clayMan, const std::vector<Proc
         {"Status", 100, {0, 255, 150, 255}, 12}
     }};
 
-    // Sort processes by CPU usage (descending)
-    std::vector<ProcessInfo> sortedProcesses = processes;
-    std::sort(sortedProcesses.begin(), sortedProcesses.end(),
-        [](const ProcessInfo& a, const ProcessInfo& b) {
-            return a.cpuUsagePercent > b.cpuUsagePercent;
-        });
-
-    // Limit the number of processes to display
-    size_t displayCount = std::min(static_cast<size_t>(maxRows), sortedProcesses.size());
+    // Rows come pre-ranked (see ProcessRanking), so the table only indexes into the list
+    size_t displayCount = std::min(static_cast<size_t>(maxRows), order.size());
 
     RenderFixedTable(clayMan, columns.data(), columns.size(),
-        [&sortedProcesses](ClayMan* clayMan, size_t rowIndex) {
-            if (rowIndex < sortedProcesses.size()) {
-                RenderProcessRow(clayMan, sortedProcesses[rowIndex], nullptr, rowIndex % 2 == 0);
+        [&processes, &order](ClayMan* clayMan, size_t rowIndex) {
+            if (rowIndex < order.size() && order[rowIndex] < processes.size()) {
+                RenderProcessRow(clayMan, processes.row(order[rowIndex]), nullptr, rowIndex % 2 == 0);
             }
-        }, displayCount, 600);
+        }, displayCount, 600, CLAY_ID("ProcessListBody"));
 }
 
 void TableComponent::RenderFixedTable(ClayMan* clayMan, const TableColumn* columns, size_t columnCount, 
-                                     std::function<void(ClayMan*, size_t)> renderRow, size_t rowCount, uint32_t maxHeight)
+                                     std::function<void(ClayMan*, size_t)> renderRow, size_t rowCount, uint32_t maxHeight,
+                                     Clay_ElementId bodyId)
 {
     Clay_ElementDeclaration tableContainer = {};
     tableContainer.layout.sizing = clayMan->expandXY();
@@ -41,17 +35,22 @@ void TableComponent::RenderFixedTable(ClayMan* clayMan, const TableColumn* colum
     tableContainer.backgroundColor = { 25, 25, 25, 255 };
     tableContainer.cornerRadius = { 8, 8, 8, 8 };
 
-    clayMan->element(tableContainer, [clayMan, columns, columnCount, renderRow, rowCount, maxHeight]() {
+    clayMan->element(tableContainer, [clayMan, columns, columnCount, &renderRow, rowCount, maxHeight, bodyId]() {
         // Render table header
         RenderTableHeader(clayMan, columns, columnCount);
 
+        if (bodyId.id != 0) {
+            RenderVirtualRows(clayMan, bodyId, rowCount, maxHeight, renderRow);
+            return;
+        }
+
         // Render table body
         Clay_ElementDeclaration tableBody = {};
         tableBody.layout.sizing = clayMan->expandXY();
         tableBody.layout.layoutDirection = CLAY_TOP_TO_BOTTOM;
-        tableBody.layout.childGap = 1;
+        tableBody.layout.childGap = RowGap;
 
-        clayMan->element(tableBody, [clayMan, renderRow, rowCount]() {
+        clayMan->element(tableBody, [clayMan, &renderRow, rowCount]() {
             for (size_t i = 0; i < rowCount; ++i) {
                 renderRow(clayMan, i);
             }
@@ -59,6 +58,59 @@ void TableComponent::RenderFixedTable(ClayMan* clayMan, const TableColumn* colum
     });
 }
 
+TableComponent::RowRange TableComponent::GetVisibleRows(Clay_ElementId bodyId, size_t rowCount, uint32_t maxHeight)
+{
+    // Last frame's scroll position and viewport; the first frame (or a brand-new table) starts at the top
+    const float pitch = static_cast<float>(RowHeight + RowGap);
+    float viewport = static_cast<float>(std::min<uint64_t>(maxHeight, static_cast<uint64_t>(rowCount) * (RowHeight + RowGap)));
+    float offset = 0.0f;
+
+    Clay_ScrollContainerData scroll = Clay_GetScrollContainerData(bodyId);
+    if (scroll.found && scroll.scrollPosition) {
+        offset = std::max(0.0f, -scroll.scrollPosition->y);
+        if (scroll.scrollContainerDimensions.height > 0.0f) viewport = scroll.scrollContainerDimensions.height;
+    }
+
+    // One spare row on each side so a fast wheel flick never shows a gap before the next frame catches up
+    RowRange range;
+    size_t first = static_cast<size_t>(offset / pitch);
+    range.first = std::min(rowCount, first > 0 ? first - 1 : 0);
+    range.last = std::min(rowCount, static_cast<size_t>((offset + viewport) / pitch) + 2);
+    return range;
+}
+
+void TableComponent::RenderVirtualRows(ClayMan* clayMan, Clay_ElementId bodyId, size_t rowCount, uint32_t maxHeight,
+                                       const std::function<void(ClayMan*, size_t)>& renderRow)
+{
+    const uint32_t pitch = RowHeight + RowGap;
+    uint64_t contentHeight = rowCount > 0 ? static_cast<uint64_t>(rowCount) * pitch - RowGap : 0;
+    RowRange range = GetVisibleRows(bodyId, rowCount, maxHeight);
+
+    // A clipped, scrollable viewport; only the rows in view become elements, spacers stand in for the rest
+    Clay_ElementDeclaration tableBody = {};
+    tableBody.id = bodyId;
+    tableBody.layout.sizing = clayMan->expandXfixedY(static_cast<uint32_t>(std::min<uint64_t>(maxHeight, contentHeight)));
+    tableBody.layout.layoutDirection = CLAY_TOP_TO_BOTTOM;
+    tableBody.layout.childGap = RowGap;
+    tableBody.clip.vertical = true;
+
+    clayMan->element(tableBody, [clayMan, &renderRow, rowCount, range, pitch]() {
+        auto spacer = [clayMan, pitch](size_t rows) {
+            if (rows == 0) return;
+            Clay_ElementDeclaration gap = {};
+            // The body's childGap follows the spacer, so it is one gap shorter than the rows it replaces
+            gap.layout.sizing = clayMan->expandXfixedY(static_cast<uint32_t>(rows * pitch - RowGap));
+            clayMan->element(gap, []() {});
+        };
+
+        spacer(range.first);
+        for (size_t i = range.first; i < range.last; ++i) {
+            renderRow(clayMan, i);
+        }
+        spacer(rowCount - range.last);
+    });
+}
+
 void TableComponent::RenderTableHeader(ClayMan* clayMan, const TableColumn* columns, size_t columnCount)
 {
     Clay_ElementDeclaration headerRow = {};
@@ -90,12 +142,12 @@ void TableComponent::RenderTableHeader(ClayMan* clayMan, const TableColumn* colu
     });
 }
 
-void TableComponent::RenderProcessRow(ClayMan* clayMan, const ProcessInfo& process, const TableColumn* columns, bool isAlternate)
+void TableComponent::RenderProcessRow(ClayMan* clayMan, const ProcessStore::Row& process, const TableColumn* columns, bool isAlternate)
 {
     Clay_Color rowColor = isAlternate ? Clay_Color{ 35, 35, 35, 255 } : Clay_Color{ 30, 30, 30, 255 };
 
     Clay_ElementDeclaration processRow = {};
-    processRow.layout.sizing = clayMan->expandXfixedY(36);
+    processRow.layout.sizing = clayMan->expandXfixedY(RowHeight);
     processRow.layout.layoutDirection = CLAY_LEFT_TO_RIGHT;
     processRow.layout.childGap = 1;
     processRow.backgroundColor = rowColor;
@@ -108,7 +160,7 @@ void TableComponent::RenderProcessRow(ClayMan* clayMan, const ProcessInfo& proce
         nameCell.layout.childAlignment = { CLAY_ALIGN_X_LEFT, CLAY_ALIGN_Y_CENTER };
 
         clayMan->element(nameCell, [clayMan, &process]() {
-            std::string displayName = process.name;
+            std::string displayName = *process.name;
             if (displayName.length() > 25) {
                 displayName = displayName.substr(0, 22) + "...";
             }
@@ -131,9 +183,25 @@ void TableComponent::RenderProcessRow(ClayMan* clayMan, const ProcessInfo& proce
         RenderTableCell(clayMan, Application::FormatBytes(process.memoryUsage), 120, { 180, 180, 180, 255 });
 
         // Status (with color coding)
-        Clay_Color statusColor = process.status == "Running" ? 
+        Clay_Color statusColor = *process.status == "Running" ? 
             Clay_Color{ 0, 255, 150, 255 } : Clay_Color{ 255, 255, 100, 255 };
-        RenderTableCell(clayMan, process.status, 100, statusColor);
+        RenderTableCell(clayMan, *process.status, 100, statusColor);
+    });
+}
+
+void TableComponent::RenderTextRow(ClayMan* clayMan, const TableColumn* columns, size_t columnCount, const std::string* cells, bool isAlternate)
+{
+    Clay_ElementDeclaration row = {};
+    row.layout.sizing = clayMan->expandXfixedY(RowHeight);
+    row.layout.layoutDirection = CLAY_LEFT_TO_RIGHT;
+    row.layout.childGap = 1;
+    row.backgroundColor = isAlternate ? Clay_Color{ 35, 35, 35, 255 } : Clay_Color{ 30, 30, 30, 255 };
+    row.layout.padding = clayMan->padXY(12, 6);
+
+    clayMan->element(row, [clayMan, columns, columnCount, cells]() {
+        for (size_t i = 0; i < columnCount; ++i) {
+            RenderTableCell(clayMan, cells[i], columns[i].width, columns[i].textColor, columns[i].fontSize);
+        }
     });
 }
 
@@ -4,6 +4,7 @@
 #include <string>
 #include <array>
 #include <functional>
+#include <span>
 
 struct TableColumn {
     const char* title;
@@ -14,11 +15,24 @@ struct TableColumn {
 
 class TableComponent {
 public:
-    static void RenderProcessTable(ClayMan* clayMan, const std::vector<ProcessInfo>& processes, uint32_t maxRows = 20);
-    static void RenderFixedTable(ClayMan* clayMan, const TableColumn* columns, size_t columnCount, std::function<void(ClayMan*, size_t)> renderRow, size_t rowCount, uint32_t maxHeight = 400);
+    // order holds indices into processes, best first (e.g. ProcessRanking::GetTop)
+    static void RenderProcessTable(ClayMan* clayMan, const ProcessStore& processes, std::span<const uint32_t> order, uint32_t maxRows = 20);
+    // With a bodyId the body becomes a scrollable viewport of at most maxHeight that only emits the visible rows
+    static void RenderFixedTable(ClayMan* clayMan, const TableColumn* columns, size_t columnCount, std::function<void(ClayMan*, size_t)> renderRow, size_t rowCount, uint32_t maxHeight = 400, Clay_ElementId bodyId = {});
+
+    // Every row is RowHeight tall with RowGap between rows; virtualization relies on that fixed pitch
+    static constexpr uint32_t RowHeight = 36;
+    static constexpr uint32_t RowGap = 1;
+
+    struct RowRange { size_t first = 0; size_t last = 0; };
+    // Rows [first, last) that the viewport bodyId shows this frame, from its last known scroll position
+    static RowRange GetVisibleRows(Clay_ElementId bodyId, size_t rowCount, uint32_t maxHeight);
+    static void RenderVirtualRows(ClayMan* clayMan, Clay_ElementId bodyId, size_t rowCount, uint32_t maxHeight, const std::function<void(ClayMan*, size_t)>& renderRow);
+    // Plain text row laid out to match the columns; cells[i] uses columns[i]'s width and color
+    static void RenderTextRow(ClayMan* clayMan, const TableColumn* columns, size_t columnCount, const std::string* cells, bool isAlternate);
 
 private:
     static void RenderTableHeader(ClayMan* clayMan, const TableColumn* columns, size_t columnCount);
-    static void RenderProcessRow(ClayMan* clayMan, const ProcessInfo& process, const TableColumn* columns, bool isAlternate);
+    static void RenderProcessRow(ClayMan* clayMan, const ProcessStore::Row& process, const TableColumn* columns, bool isAlternate);
     static void RenderTableCell(ClayMan* clayMan, const std::string& text, uint32_t width, Clay_Color color = { 255, 255, 255, 255 }, uint32_t fontSize = 11);
 };
\ No newline at end of file
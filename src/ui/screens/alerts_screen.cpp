@@ -274,12 +274,15 @@ void AlertsScreen::RenderAlertCard(ClayMan* clayMan, const SystemAlert& alert)
                     detailText.fontId = 0;
                     detailText.fontSize = 12;
                     
-                    std::string currentValueStr = "Current: " + FormatPercentage(alert.currentValue);
-                    clayMan->textElement(currentValueStr, detailText);
-                    
-                    // Threshold
-                    std::string thresholdStr = "Threshold: " + FormatPercentage(alert.threshold);
-                    clayMan->textElement(thresholdStr, detailText);
+                    // An expression alert's value is just its truth, and the message already shows the condition
+                    if (alert.type != AlertRule::EXPRESSION) {
+                        std::string currentValueStr = "Current: " + FormatPercentage(alert.currentValue);
+                        clayMan->textElement(currentValueStr, detailText);
+                        
+                        // Threshold
+                        std::string thresholdStr = "Threshold: " + FormatPercentage(alert.threshold);
+                        clayMan->textElement(thresholdStr, detailText);
+                    }
                     
                     // Timestamp (mock for now)
                     clayMan->textElement("Time: Just now", detailText);
@@ -417,6 +420,9 @@ void AlertsScreen::RenderAlertRuleRow(ClayMan* clayMan, const AlertRule& rule)
         case AlertRule::DISK_USAGE: ruleTypeName = "Disk Usage"; break;
         case AlertRule::NETWORK_USAGE: ruleTypeName = "Network Usage"; break;
         case AlertRule::PROCESS_COUNT: ruleTypeName = "Process Count"; break;
+        case AlertRule::FD_HEADROOM: ruleTypeName = "FD Headroom"; break;
+        case AlertRule::ANOMALY: ruleTypeName = "Anomaly"; break;
+        case AlertRule::EXPRESSION: ruleTypeName = rule.expression.GetSource(); break;
         default: ruleTypeName = "Unknown"; break;
     }
     
@@ -452,7 +458,12 @@ void AlertsScreen::RenderAlertRuleRow(ClayMan* clayMan, const AlertRule& rule)
             thresholdText.textColor = { 180, 180, 180, 255 };
             thresholdText.fontId = 0;
             thresholdText.fontSize = 12;
-            clayMan->textElement(FormatPercentage(rule.threshold), thresholdText);
+            // Fires above the first value, clears at or below the second; an expression is its own threshold
+            if (rule.type == AlertRule::EXPRESSION) {
+                clayMan->textElement("-", thresholdText);
+            } else {
+                clayMan->textElement(FormatPercentage(rule.threshold) + " / " + FormatPercentage(rule.clearThreshold), thresholdText);
+            }
         });
         
         // Duration
@@ -490,14 +501,21 @@ void AlertsScreen::RenderAlertRuleRow(ClayMan* clayMan, const AlertRule& rule)
         statusCell.layout.childAlignment = clayMan->centerXY();
         
         clayMan->element(statusCell, [clayMan, &rule]() {
-            Clay_Color statusColor = rule.isEnabled ? 
-                Clay_Color{0, 255, 150, 255} : Clay_Color{255, 100, 100, 255};
+            const char* status = "Disabled";
+            Clay_Color statusColor = Clay_Color{255, 100, 100, 255};
+            if (rule.isEnabled) {
+                switch (rule.state.phase()) {
+                    case AlertState::Phase::Pending: status = "Pending"; statusColor = Clay_Color{255, 200, 0, 255}; break;
+                    case AlertState::Phase::Firing: status = "Firing"; statusColor = Clay_Color{255, 150, 0, 255}; break;
+                    default: status = "Enabled"; statusColor = Clay_Color{0, 255, 150, 255}; break;
+                }
+            }
             
             Clay_TextElementConfig statusText = {};
             statusText.textColor = statusColor;
             statusText.fontId = 0;
             statusText.fontSize = 12;
-            clayMan->textElement(rule.isEnabled ? "Enabled" : "Disabled", statusText);
+            clayMan->textElement(status, statusText);
         });
     });
 }
\ No newline at end of file
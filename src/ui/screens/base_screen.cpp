@@ -35,4 +35,11 @@ std::string BaseScreen::FormatPercentage(float percentage)
 	std::ostringstream oss;
 	oss << std::fixed << std::setprecision(1) << percentage << "%";
 	return oss.str();
+}
+
+std::string BaseScreen::FormatRate(float perSecond)
+{
+	std::ostringstream oss;
+	oss << std::fixed << std::setprecision(1) << perSecond << "/s";
+	return oss.str();
 }
\ No newline at end of file
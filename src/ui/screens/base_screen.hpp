@@ -12,10 +12,16 @@ public:
 	virtual ~BaseScreen() = default;
 	virtual void Render(ClayMan* clayMan, const SystemState& systemState);
 
+	// Keyboard input for screens with a text field; ignored by default
+	enum class EditKey { Backspace, Clear };
+	virtual void OnTextInput(const char* /*text*/) {}
+	virtual void OnEditKey(EditKey /*key*/) {}
+
 protected:
 	virtual void RenderContent(ClayMan* clayMan, const SystemState& systemState) = 0;
 	static std::string FormatBytes(uint64_t bytes);
 	static std::string FormatPercentage(float percentage);
+	static std::string FormatRate(float perSecond);
 
 private:
 	uint32_t GetScrollPadding() const { return 24; }
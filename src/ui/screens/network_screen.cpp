@@ -20,6 +20,9 @@ void NetworkScreen::RenderContent(ClayMan* clayMan, const SystemState& systemSta
     clayMan->element(networkContainer, [this, clayMan, &systemState, windowWidth]() {
         RenderNetworkSummary(clayMan, systemState, windowWidth);
         RenderNetworkGraphs(clayMan, systemState);
+        if (systemState.networkHealth.isAvailable) {
+            RenderNetworkHealth(clayMan, systemState.networkHealth);
+        }
         RenderNetworkInterfaces(clayMan, systemState.networkStats);
     });
 }
@@ -122,13 +125,9 @@ void NetworkScreen::RenderNetworkGraphs(ClayMan* clayMan, const SystemState& sys
                         graphContainer.layout.sizing = clayMan->expandXY();
                         
                         clayMan->element(graphContainer, [clayMan, &systemState, graphHeight]() {
-                            // Convert download history from uint64_t to float for visualization
-                            RingBuffer<float, 300> downloadFloatHistory;
-                            for (size_t i = 0; i < systemState.downloadHistory.size(); ++i) {
-                                downloadFloatHistory.push(static_cast<float>(systemState.downloadHistory.get(i) / 1024.0f)); // Convert to KB/s
-                            }
-                            GraphComponent::RenderTimeSeriesGraph(clayMan, downloadFloatHistory, 
-                                { 0, 255, 150, 255 }, graphHeight - 100);
+                            // Drawn in KB/s; the scale is applied per value while drawing, so nothing is copied
+                            GraphComponent::RenderTimeSeriesGraph(clayMan, GraphSeries(systemState.downloadHistory.raw(), 1.0f / 1024.0f),
+                                systemState.downloadHistory.rawTimes(), { 0, 255, 150, 255 }, graphHeight - 100);
                         });
                     });
                 }, { 35, 35, 35, 255 }, 0, 0, 12);
@@ -160,13 +159,9 @@ void NetworkScreen::RenderNetworkGraphs(ClayMan* clayMan, const SystemState& sys
                         graphContainer.layout.sizing = clayMan->expandXY();
                         
                         clayMan->element(graphContainer, [clayMan, &systemState, graphHeight]() {
-                            // Convert upload history from uint64_t to float for visualization
-                            RingBuffer<float, 300> uploadFloatHistory;
-                            for (size_t i = 0; i < systemState.uploadHistory.size(); ++i) {
-                                uploadFloatHistory.push(static_cast<float>(systemState.uploadHistory.get(i) / 1024.0f)); // Convert to KB/s
-                            }
-                            GraphComponent::RenderTimeSeriesGraph(clayMan, uploadFloatHistory, 
-                                { 255, 150, 0, 255 }, graphHeight - 100);
+                            // Drawn in KB/s, scaled while drawing
+                            GraphComponent::RenderTimeSeriesGraph(clayMan, GraphSeries(systemState.uploadHistory.raw(), 1.0f / 1024.0f),
+                                systemState.uploadHistory.rawTimes(), { 255, 150, 0, 255 }, graphHeight - 100);
                         });
                     });
                 }, { 35, 35, 35, 255 }, 0, 0, 12);
@@ -226,7 +221,7 @@ void NetworkScreen::RenderCombinedNetworkGraph(ClayMan* clayMan, const SystemSta
             graphContainer.layout.sizing = clayMan->expandXY();
             
             clayMan->element(graphContainer, [clayMan, &systemState, graphHeight]() {
-                GraphComponent::RenderTimeSeriesGraph(clayMan, systemState.networkHistory, 
+                GraphComponent::RenderTimeSeriesGraph(clayMan, systemState.networkHistory.raw(), systemState.networkHistory.rawTimes(), 
                     { 100, 150, 255, 255 }, graphHeight - 80);
             });
         });
@@ -449,6 +444,103 @@ void NetworkScreen::RenderInterfaceDetails(ClayMan* clayMan, const NetworkInterf
     });
 }
 
+void NetworkScreen::RenderNetworkHealth(ClayMan* clayMan, const NetworkHealth& health)
+{
+    // Any of these being non-zero means packets are being lost or resent, so they get highlighted
+    std::vector<std::pair<std::string, std::string>> tcpRows = {
+        {"Retransmits", FormatRate(health.tcpRetransPerSec) + " (" + FormatPercentage(health.tcpRetransPercent) + ")"},
+        {"Listen Overflows", FormatRate(health.listenOverflowsPerSec)},
+        {"Listen Drops", FormatRate(health.listenDropsPerSec)},
+        {"SYN Cookies", FormatRate(health.synCookiesSentPerSec)},
+        {"Segment Errors", FormatRate(health.tcpInErrorsPerSec)}
+    };
+    std::vector<bool> tcpErrors = {
+        health.tcpRetransPerSec > 0.0f, health.listenOverflowsPerSec > 0.0f, health.listenDropsPerSec > 0.0f,
+        health.synCookiesSentPerSec > 0.0f, health.tcpInErrorsPerSec > 0.0f
+    };
+    
+    std::vector<std::pair<std::string, std::string>> socketRows = {
+        {"Out-of-Order", FormatRate(health.outOfOrderPerSec)},
+        {"UDP Buffer Errors", FormatRate(health.udpRcvbufErrorsPerSec)},
+        {"UDP Errors", FormatRate(health.udpInErrorsPerSec)},
+        {"TCP Sockets", std::to_string(health.tcpInUse) + " (" + std::to_string(health.tcpTimeWait) + " TIME_WAIT)"},
+        {"Socket Memory", FormatBytes(health.tcpMemoryBytes + health.udpMemoryBytes)}
+    };
+    // Out-of-order segments are normal on lossy paths, so only UDP drops count as errors here
+    std::vector<bool> socketErrors = {
+        false, health.udpRcvbufErrorsPerSec > 0.0f, health.udpInErrorsPerSec > 0.0f, false, false
+    };
+    
+    UICard::RenderSectionCard(clayMan, "Network Health", [this, clayMan, &tcpRows, &tcpErrors, &socketRows, &socketErrors]() {
+        
+        Clay_ElementDeclaration healthGrid = {};
+        healthGrid.layout.sizing = clayMan->expandXY();
+        healthGrid.layout.layoutDirection = CLAY_LEFT_TO_RIGHT;
+        healthGrid.layout.childGap = 16;
+        
+        clayMan->element(healthGrid, [this, clayMan, &tcpRows, &tcpErrors, &socketRows, &socketErrors]() {
+            RenderHealthColumn(clayMan, tcpRows, tcpErrors);
+            RenderHealthColumn(clayMan, socketRows, socketErrors);
+        });
+        
+    }, 0); // Auto height
+}
+
+void NetworkScreen::RenderHealthColumn(ClayMan* clayMan, const std::vector<std::pair<std::string, std::string>>& rows, const std::vector<bool>& errorFlags)
+{
+    Clay_ElementDeclaration column = {};
+    column.layout.sizing = clayMan->expandXY();
+    column.layout.layoutDirection = CLAY_TOP_TO_BOTTOM;
+    column.layout.childGap = 6;
+    
+    clayMan->element(column, [clayMan, &rows, &errorFlags]() {
+        for (size_t i = 0; i < rows.size(); ++i) {
+            const auto& row = rows[i];
+            bool isError = i < errorFlags.size() && errorFlags[i];
+            
+            Clay_ElementDeclaration healthRow = {};
+            healthRow.layout.sizing = clayMan->expandXfixedY(28);
+            healthRow.layout.layoutDirection = CLAY_LEFT_TO_RIGHT;
+            healthRow.layout.childAlignment = { CLAY_ALIGN_X_LEFT, CLAY_ALIGN_Y_CENTER };
+            healthRow.layout.padding = clayMan->padXY(12, 6);
+            healthRow.cornerRadius = { 6, 6, 6, 6 };
+            if (isError) {
+                healthRow.backgroundColor = { 255, 80, 80, 30 };
+                healthRow.border.width = { 1, 1, 1, 1 };
+                healthRow.border.color = { 255, 80, 80, 120 };
+            } else {
+                healthRow.backgroundColor = { 35, 35, 35, 255 };
+            }
+            
+            clayMan->element(healthRow, [clayMan, &row, isError]() {
+                Clay_ElementDeclaration labelContainer = {};
+                labelContainer.layout.sizing = clayMan->expandXY();
+                labelContainer.layout.childAlignment = { CLAY_ALIGN_X_LEFT, CLAY_ALIGN_Y_CENTER };
+                
+                clayMan->element(labelContainer, [clayMan, &row]() {
+                    Clay_TextElementConfig labelText = {};
+                    labelText.textColor = { 160, 160, 160, 255 };
+                    labelText.fontId = 0;
+                    labelText.fontSize = 12;
+                    clayMan->textElement(row.first, labelText);
+                });
+                
+                Clay_ElementDeclaration valueContainer = {};
+                valueContainer.layout.sizing = clayMan->expandXY();
+                valueContainer.layout.childAlignment = { CLAY_ALIGN_X_RIGHT, CLAY_ALIGN_Y_CENTER };
+                
+                clayMan->element(valueContainer, [clayMan, &row, isError]() {
+                    Clay_TextElementConfig valueText = {};
+                    valueText.textColor = isError ? Clay_Color{ 255, 120, 120, 255 } : Clay_Color{ 200, 200, 200, 255 };
+                    valueText.fontId = 0;
+                    valueText.fontSize = 12;
+                    clayMan->textElement(row.second, valueText);
+                });
+            });
+        }
+    });
+}
+
 void NetworkScreen::RenderInterfaceStats(ClayMan* clayMan, const NetworkInterface& interface)
 {
     std::vector<std::pair<std::string, std::string>> stats = {
@@ -13,6 +13,8 @@ private:
     void RenderNetworkGraphs(ClayMan* clayMan, const SystemState& systemState);
     void RenderCombinedNetworkGraph(ClayMan* clayMan, const SystemState& systemState, uint32_t graphHeight);
     void RenderLegendItem(ClayMan* clayMan, const std::string& label, Clay_Color color);
+    void RenderNetworkHealth(ClayMan* clayMan, const NetworkHealth& health);
+    void RenderHealthColumn(ClayMan* clayMan, const std::vector<std::pair<std::string, std::string>>& rows, const std::vector<bool>& errorFlags);
     void RenderNetworkInterfaces(ClayMan* clayMan, const NetworkStats& networkStats);
     void RenderInterfaceCard(ClayMan* clayMan, const NetworkInterface& interface);
     void RenderInterfaceDetails(ClayMan* clayMan, const NetworkInterface& interface);
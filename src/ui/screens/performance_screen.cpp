@@ -1,5 +1,7 @@
 #include "performance_screen.hpp"
 #include "../components/ui_card.hpp"
+#include <algorithm>
+#include <cmath>
 
 void PerformanceScreen::RenderContent(ClayMan* clayMan, const SystemState& systemState)
 {
@@ -28,6 +30,26 @@ void PerformanceScreen::RenderContent(ClayMan* clayMan, const SystemState& syste
         
         // Hardware Details Section  
         RenderHardwareDetails(clayMan, systemState, windowWidth);
+        
+        // Per-engine and per-process GPU load where the platform reports it
+        if (!systemState.gpu.engines.empty()) {
+            RenderGpuBreakdown(clayMan, systemState.gpu);
+        }
+        
+        // Filesystem capacity (only populated where a filesystem provider exists)
+        if (!systemState.filesystems.empty()) {
+            RenderStorage(clayMan, systemState);
+        }
+        
+        // Hardware sensors; absent on most VMs
+        if (systemState.sensors.isAvailable) {
+            RenderSensors(clayMan, systemState.sensors);
+        }
+        
+        // RAPL power draw; absent on VMs and when energy counters are root-only
+        if (systemState.power.isAvailable) {
+            RenderPower(clayMan, systemState.power, windowWidth);
+        }
     });
 }
 
@@ -80,14 +102,22 @@ void PerformanceScreen::RenderSystemOverview(ClayMan* clayMan, const SystemState
 
 void PerformanceScreen::RenderPerformanceMetrics(ClayMan* clayMan, const SystemState& systemState, uint32_t cardHeight)
 {
-    UICard::RenderSectionCard(clayMan, "Performance Graphs", [this, clayMan, &systemState, cardHeight]() {
+    bool hasNumaNodes = systemState.numa.isAvailable && !systemState.numa.nodes.empty();
+    uint32_t toggleHeight = (hasNumaNodes ? 56 : 0) + 56; // The NUMA toggle and the range selector
+    
+    UICard::RenderSectionCard(clayMan, "Performance Graphs", [this, clayMan, &systemState, cardHeight, hasNumaNodes]() {
         
         Clay_ElementDeclaration metricsGrid = {};
         metricsGrid.layout.sizing = clayMan->expandXY();
         metricsGrid.layout.layoutDirection = CLAY_TOP_TO_BOTTOM;
         metricsGrid.layout.childGap = 20;
         
-        clayMan->element(metricsGrid, [this, clayMan, &systemState, cardHeight]() {
+        clayMan->element(metricsGrid, [this, clayMan, &systemState, cardHeight, hasNumaNodes]() {
+            
+            RenderGraphRangeSelector(clayMan);
+            if (hasNumaNodes) {
+                RenderNumaGroupingToggle(clayMan);
+            }
             
             // First row: CPU and GPU
             Clay_ElementDeclaration topRow = {};
@@ -95,16 +125,25 @@ void PerformanceScreen::RenderPerformanceMetrics(ClayMan* clayMan, const SystemS
             topRow.layout.layoutDirection = CLAY_LEFT_TO_RIGHT;
             topRow.layout.childGap = 20;
             
-            clayMan->element(topRow, [this, clayMan, &systemState, cardHeight]() {
-                // CPU Performance Card
-                RenderEnhancedHardwareCard(clayMan, "CPU Performance", 
-                    systemState.cpuName, systemState.cpuUsagePercent, 
-                    systemState.cpuHistory, { 0, 255, 150, 255 }, cardHeight);
+            clayMan->element(topRow, [this, clayMan, &systemState, cardHeight, hasNumaNodes]() {
+                if (hasNumaNodes && groupCpuByNode_) {
+                    // One CPU card per NUMA node; node histories are raw only, so these stay live at any range
+                    for (const auto& node : systemState.numa.nodes) {
+                        RenderEnhancedHardwareCard(clayMan, "CPU Node " + std::to_string(node.id),
+                            "CPUs " + FormatCpuList(node.cpus) + " | Mem " + FormatPercentage(node.memoryUsagePercent),
+                            node.cpuUsagePercent, node.cpuHistory, { 0, 255, 150, 255 }, cardHeight);
+                    }
+                } else {
+                    // CPU Performance Card
+                    RenderHistoryCard(clayMan, "CPU Performance", 
+                        systemState.cpuName, systemState.cpuUsagePercent, 
+                        systemState.cpuHistory, rangeBuffers_[0], { 0, 255, 150, 255 }, cardHeight, &systemState.cpuQuantiles);
+                }
                 
                 // GPU Performance Card  
-                RenderEnhancedHardwareCard(clayMan, "GPU Performance",
+                RenderHistoryCard(clayMan, "GPU Performance",
                     systemState.gpuName, systemState.gpuUsagePercent,
-                    systemState.gpuHistory, { 255, 150, 0, 255 }, cardHeight);
+                    systemState.gpuHistory, rangeBuffers_[1], { 255, 150, 0, 255 }, cardHeight, &systemState.gpuQuantiles);
             });
             
             // Second row: Memory and Disk
@@ -115,19 +154,176 @@ void PerformanceScreen::RenderPerformanceMetrics(ClayMan* clayMan, const SystemS
             
             clayMan->element(bottomRow, [this, clayMan, &systemState, cardHeight]() {
                 // Memory Performance Card
-                RenderEnhancedHardwareCard(clayMan, "Memory Usage",
+                RenderHistoryCard(clayMan, "Memory Usage",
                     FormatBytes(systemState.usedRAMBytes) + " / " + FormatBytes(systemState.totalRAMBytes),
-                    systemState.memoryUsagePercent, systemState.memoryHistory,
-                    { 100, 150, 255, 255 }, cardHeight);
+                    systemState.memoryUsagePercent, systemState.memoryHistory, rangeBuffers_[2],
+                    { 100, 150, 255, 255 }, cardHeight, &systemState.memoryQuantiles);
                 
                 // Disk Performance Card
-                RenderEnhancedHardwareCard(clayMan, "Disk I/O Activity",
+                RenderHistoryCard(clayMan, "Disk I/O Activity",
                     systemState.primaryDiskName, systemState.diskUsagePercent,
-                    systemState.diskHistory, { 255, 100, 255, 255 }, cardHeight);
+                    systemState.diskHistory, rangeBuffers_[3], { 255, 100, 255, 255 }, cardHeight, &systemState.diskQuantiles);
             });
         });
         
-    }, (cardHeight * 2) + 120);
+    }, (cardHeight * 2) + 120 + toggleHeight);
+}
+
+void PerformanceScreen::RenderGraphRangeSelector(ClayMan* clayMan)
+{
+    Clay_ElementDeclaration selectorRow = {};
+    selectorRow.layout.sizing = clayMan->expandXfixedY(36);
+    selectorRow.layout.layoutDirection = CLAY_LEFT_TO_RIGHT;
+    selectorRow.layout.childAlignment = { CLAY_ALIGN_X_LEFT, CLAY_ALIGN_Y_CENTER };
+    selectorRow.layout.childGap = 8;
+    
+    clayMan->element(selectorRow, [this, clayMan]() {
+        static const std::pair<GraphRange, const char*> Ranges[] = {
+            { GraphRange::Live, "Live" }, { GraphRange::TenMinutes, "10 min" }, { GraphRange::Hour, "1 hour" },
+            { GraphRange::SixHours, "6 hours" }, { GraphRange::TwoDays, "2 days" }
+        };
+        for (const auto& [range, label] : Ranges) {
+            uint32_t index = static_cast<uint32_t>(range);
+            bool selected = range == graphRange_;
+            
+            Clay_ElementDeclaration rangeButton = {};
+            rangeButton.id = CLAY_IDI("GraphRange", index);
+            rangeButton.layout.sizing = clayMan->fixedSize(80, 32);
+            rangeButton.layout.childAlignment = clayMan->centerXY();
+            rangeButton.cornerRadius = { 8, 8, 8, 8 };
+            if (selected) {
+                rangeButton.backgroundColor = { 0, 255, 150, 25 };
+                rangeButton.border.width = { 1, 1, 1, 1 };
+                rangeButton.border.color = { 0, 255, 150, 100 };
+            } else {
+                rangeButton.backgroundColor = { 45, 45, 45, 255 };
+            }
+            
+            clayMan->element(rangeButton, [this, clayMan, range, label, index, selected]() {
+                if (Clay_PointerOver(CLAY_IDI("GraphRange", index)) && clayMan->mousePressed()) {
+                    graphRange_ = range;
+                }
+                
+                Clay_TextElementConfig rangeText = {};
+                rangeText.textColor = selected ? Clay_Color{ 240, 240, 240, 255 } : Clay_Color{ 160, 160, 160, 255 };
+                rangeText.fontId = 0;
+                rangeText.fontSize = 13;
+                clayMan->textElement(label, rangeText);
+            });
+        }
+    });
+}
+
+uint64_t PerformanceScreen::RangeSeconds(GraphRange range)
+{
+    switch (range) {
+        case GraphRange::TenMinutes: return 10 * 60;
+        case GraphRange::Hour: return 60 * 60;
+        case GraphRange::SixHours: return 6 * 60 * 60;
+        case GraphRange::TwoDays: return 48 * 60 * 60;
+        default: return 0;
+    }
+}
+
+void PerformanceScreen::ResampleRange(const TieredSeries& history, uint64_t rangeSeconds, RangeBuffer& buffer)
+{
+    buffer.values.clear();
+    buffer.times.clear();
+    history.query(rangeSeconds, RangeSlots, buffer.points);
+    if (buffer.points.empty()) return;
+    
+    // A slot covers several rollup points once the range is longer than the tier's resolution allows
+    uint64_t slotMs = rangeSeconds * 1000 / RangeSlots;
+    uint64_t newest = history.latestTime();
+    std::array<float, RangeSlots> sums = {};
+    std::array<uint32_t, RangeSlots> counts = {};
+    for (const auto& point : buffer.points) {
+        uint64_t slotsBack = point.time < newest ? (newest - point.time) / slotMs : 0;
+        if (slotsBack >= RangeSlots) continue;
+        size_t slot = RangeSlots - 1 - static_cast<size_t>(slotsBack);
+        sums[slot] += point.avg;
+        counts[slot]++;
+    }
+    for (size_t slot = 0; slot < RangeSlots; ++slot) {
+        if (counts[slot] == 0) continue;
+        buffer.values.push_back(sums[slot] / static_cast<float>(counts[slot]));
+        buffer.times.push_back(newest - (RangeSlots - 1 - slot) * slotMs);
+    }
+}
+
+void PerformanceScreen::RenderHistoryCard(ClayMan* clayMan, const std::string& title, const std::string& subtitle, float currentUsage, const TieredSeries& history, RangeBuffer& buffer, Clay_Color accentColor, uint32_t cardHeight, const QuantileWindows* quantiles)
+{
+    if (graphRange_ == GraphRange::Live) {
+        RenderEnhancedHardwareCard(clayMan, title, subtitle, currentUsage, history.raw(), accentColor, cardHeight, history.rawTimes(), quantiles);
+        return;
+    }
+    
+    uint64_t rangeSeconds = RangeSeconds(graphRange_);
+    ResampleRange(history, rangeSeconds, buffer);
+    GraphTimeAxis axis{ rangeSeconds * 1000 / RangeSlots, RangeSlots };
+    RenderEnhancedHardwareCard(clayMan, title, subtitle, currentUsage, GraphSeries(SeriesView<float>(std::span<const float>(buffer.values))),
+        accentColor, cardHeight, SeriesView<uint64_t>(std::span<const uint64_t>(buffer.times)), quantiles, axis);
+}
+
+void PerformanceScreen::RenderNumaGroupingToggle(ClayMan* clayMan)
+{
+    Clay_ElementDeclaration toggleRow = {};
+    toggleRow.layout.sizing = clayMan->expandXfixedY(36);
+    toggleRow.layout.layoutDirection = CLAY_LEFT_TO_RIGHT;
+    toggleRow.layout.childAlignment = { CLAY_ALIGN_X_LEFT, CLAY_ALIGN_Y_CENTER };
+    
+    clayMan->element(toggleRow, [this, clayMan]() {
+        Clay_ElementDeclaration toggleButton = {};
+        toggleButton.id = CLAY_ID("NumaGroupToggle");
+        toggleButton.layout.sizing = clayMan->fixedSize(220, 32);
+        toggleButton.layout.childAlignment = clayMan->centerXY();
+        toggleButton.cornerRadius = { 8, 8, 8, 8 };
+        if (groupCpuByNode_) {
+            toggleButton.backgroundColor = { 0, 255, 150, 25 };
+            toggleButton.border.width = { 1, 1, 1, 1 };
+            toggleButton.border.color = { 0, 255, 150, 100 };
+        } else {
+            toggleButton.backgroundColor = { 45, 45, 45, 255 };
+        }
+        
+        clayMan->element(toggleButton, [this, clayMan]() {
+            if (Clay_PointerOver(CLAY_ID("NumaGroupToggle")) && clayMan->mousePressed()) {
+                groupCpuByNode_ = !groupCpuByNode_;
+            }
+            
+            Clay_TextElementConfig toggleText = {};
+            toggleText.textColor = groupCpuByNode_ ? Clay_Color{ 240, 240, 240, 255 } : Clay_Color{ 160, 160, 160, 255 };
+            toggleText.fontId = 0;
+            toggleText.fontSize = 13;
+            clayMan->textElement(groupCpuByNode_ ? "Grouped by NUMA node" : "Group CPU by NUMA node", toggleText);
+        });
+    });
+}
+
+std::string PerformanceScreen::FormatCpuList(const std::vector<uint32_t>& cpus)
+{
+    // Collapse consecutive CPU ids back into kernel-style ranges ("0-7,16-23")
+    std::string result;
+    for (size_t i = 0; i < cpus.size(); ) {
+        size_t j = i;
+        while (j + 1 < cpus.size() && cpus[j + 1] == cpus[j] + 1) ++j;
+        if (!result.empty()) result += ",";
+        result += std::to_string(cpus[i]);
+        if (j > i) result += "-" + std::to_string(cpus[j]);
+        i = j + 1;
+    }
+    return result.empty() ? "-" : result;
+}
+
+std::string PerformanceScreen::FormatPercentiles(const QuantileWindows& quantiles)
+{
+    // "p50/p95/p99  1m 12/40/71%  1h 10/35/80%"; whole percents keep it short enough for the footer
+    auto window = [&quantiles](QuantileWindows::Window window) {
+        const QuantileWindows::Percentiles& p = quantiles.percentiles(window);
+        return std::to_string(static_cast<int>(std::lround(p.p50))) + "/" + std::to_string(static_cast<int>(std::lround(p.p95)))
+            + "/" + std::to_string(static_cast<int>(std::lround(p.p99))) + "%";
+    };
+    return "p50/p95/p99  1m " + window(QuantileWindows::Window::LastMinute) + "  1h " + window(QuantileWindows::Window::LastHour);
 }
 
 void PerformanceScreen::RenderHardwareDetails(ClayMan* clayMan, const SystemState& systemState, uint32_t windowWidth)
@@ -171,9 +367,271 @@ void PerformanceScreen::RenderHardwareDetails(ClayMan* clayMan, const SystemStat
     }, cardHeight + 80);
 }
 
-void PerformanceScreen::RenderEnhancedHardwareCard(ClayMan* clayMan, const std::string& title, const std::string& subtitle, float currentUsage, const RingBuffer<float, 300>& historyData, Clay_Color accentColor, uint32_t cardHeight)
+void PerformanceScreen::RenderStorage(ClayMan* clayMan, const SystemState& systemState)
 {
-    UICard::RenderWithBackground(clayMan, [clayMan, &title, &subtitle, currentUsage, &historyData, accentColor, cardHeight]() {
+    UICard::RenderSectionCard(clayMan, "Storage", [this, clayMan, &systemState]() {
+        
+        Clay_ElementDeclaration mountList = {};
+        mountList.layout.sizing = clayMan->expandXY();
+        mountList.layout.layoutDirection = CLAY_TOP_TO_BOTTOM;
+        mountList.layout.childGap = 6;
+        
+        clayMan->element(mountList, [this, clayMan, &systemState]() {
+            for (const auto& fs : systemState.filesystems) {
+                RenderFilesystemRow(clayMan, fs);
+            }
+        });
+        
+    }, 0); // Auto height
+}
+
+void PerformanceScreen::RenderFilesystemRow(ClayMan* clayMan, const FilesystemInfo& fs)
+{
+    float share = fs.hasData ? std::clamp(fs.usagePercent / 100.0f, 0.0f, 1.0f) : 0.0f;
+    
+    // Amber past 80%, red past 90%, matching the default alert thresholds
+    Clay_Color barColor = { 0, 255, 150, 255 };
+    if (fs.usagePercent >= 90.0f) barColor = { 255, 80, 80, 255 };
+    else if (fs.usagePercent >= 80.0f) barColor = { 255, 150, 0, 255 };
+    
+    Clay_ElementDeclaration mountRow = {};
+    mountRow.layout.sizing = clayMan->expandXfixedY(32);
+    mountRow.layout.layoutDirection = CLAY_LEFT_TO_RIGHT;
+    mountRow.layout.childAlignment = { CLAY_ALIGN_X_LEFT, CLAY_ALIGN_Y_CENTER };
+    mountRow.layout.childGap = 12;
+    mountRow.backgroundColor = { 35, 35, 35, 255 };
+    mountRow.cornerRadius = { 6, 6, 6, 6 };
+    mountRow.layout.padding = clayMan->padXY(12, 6);
+    
+    clayMan->element(mountRow, [clayMan, &fs, share, barColor]() {
+        Clay_TextElementConfig labelText = {};
+        labelText.textColor = { 200, 200, 200, 255 };
+        labelText.fontId = 0;
+        labelText.fontSize = 12;
+        
+        Clay_TextElementConfig dimText = labelText;
+        dimText.textColor = { 140, 140, 140, 255 };
+        
+        // Mount point and filesystem type
+        Clay_ElementDeclaration nameCell = {};
+        nameCell.layout.sizing = clayMan->fixedSize(220, 28);
+        nameCell.layout.childAlignment = { CLAY_ALIGN_X_LEFT, CLAY_ALIGN_Y_CENTER };
+        clayMan->element(nameCell, [clayMan, &fs, labelText]() {
+            clayMan->textElement(fs.mountPoint, labelText);
+        });
+        
+        Clay_ElementDeclaration typeCell = {};
+        typeCell.layout.sizing = clayMan->fixedSize(70, 28);
+        typeCell.layout.childAlignment = { CLAY_ALIGN_X_LEFT, CLAY_ALIGN_Y_CENTER };
+        clayMan->element(typeCell, [clayMan, &fs, dimText]() {
+            clayMan->textElement(fs.fsType, dimText);
+        });
+        
+        // Used / total bar
+        Clay_ElementDeclaration barTrack = {};
+        barTrack.layout.sizing = clayMan->expandXfixedY(10);
+        barTrack.backgroundColor = { 25, 25, 25, 255 };
+        barTrack.cornerRadius = { 5, 5, 5, 5 };
+        clayMan->element(barTrack, [clayMan, share, barColor]() {
+            Clay_ElementDeclaration barFill = {};
+            barFill.layout.sizing.width = CLAY_SIZING_PERCENT(share);
+            barFill.layout.sizing.height = CLAY_SIZING_GROW(0);
+            barFill.backgroundColor = barColor;
+            barFill.cornerRadius = { 5, 5, 5, 5 };
+            clayMan->element(barFill, []() {});
+        });
+        
+        // Capacity and inode usage
+        Clay_ElementDeclaration valueCell = {};
+        valueCell.layout.sizing = clayMan->fixedSize(260, 28);
+        valueCell.layout.childAlignment = { CLAY_ALIGN_X_RIGHT, CLAY_ALIGN_Y_CENTER };
+        clayMan->element(valueCell, [clayMan, &fs, labelText]() {
+            std::string value = "Pending...";
+            if (fs.hasData) {
+                value = FormatBytes(fs.usedBytes) + " / " + FormatBytes(fs.usedBytes + fs.freeBytes) +
+                    " (" + FormatPercentage(fs.usagePercent) + ")";
+                if (fs.totalInodes > 0) value += "  inodes " + FormatPercentage(fs.inodeUsagePercent);
+            }
+            clayMan->textElement(value, labelText);
+        });
+        
+        // Network mounts are the ones likely to hang, so both badges help explain odd values
+        Clay_ElementDeclaration badgeCell = {};
+        badgeCell.layout.sizing = clayMan->fixedSize(70, 28);
+        badgeCell.layout.childAlignment = { CLAY_ALIGN_X_RIGHT, CLAY_ALIGN_Y_CENTER };
+        clayMan->element(badgeCell, [clayMan, &fs, dimText]() {
+            Clay_TextElementConfig badgeText = dimText;
+            if (fs.isStale) {
+                badgeText.textColor = { 255, 150, 0, 255 };
+                clayMan->textElement("STALE", badgeText);
+            } else if (fs.isNetwork) {
+                clayMan->textElement("NET", badgeText);
+            }
+        });
+    });
+}
+
+void PerformanceScreen::RenderGpuBreakdown(ClayMan* clayMan, const GpuStats& gpu)
+{
+    UICard::RenderSectionCard(clayMan, "GPU Engines", [this, clayMan, &gpu]() {
+        
+        Clay_ElementDeclaration gpuList = {};
+        gpuList.layout.sizing = clayMan->expandXY();
+        gpuList.layout.layoutDirection = CLAY_TOP_TO_BOTTOM;
+        gpuList.layout.childGap = 6;
+        
+        clayMan->element(gpuList, [this, clayMan, &gpu]() {
+            for (const auto& engine : gpu.engines) {
+                RenderSensorRow(clayMan, engine.name, FormatPercentage(engine.utilizationPercent),
+                    engine.utilizationPercent / 100.0f, false);
+            }
+            
+            // The busiest few clients are what explain a loaded engine
+            size_t shown = std::min<size_t>(gpu.processes.size(), 8);
+            for (size_t i = 0; i < shown; ++i) {
+                const GpuProcess& process = gpu.processes[i];
+                RenderSensorRow(clayMan, process.name + " (" + std::to_string(process.pid) + ")",
+                    FormatPercentage(process.utilizationPercent) + "  " + FormatBytes(process.memoryBytes),
+                    process.utilizationPercent / 100.0f, false);
+            }
+        });
+        
+    }, 0); // Auto height
+}
+
+void PerformanceScreen::RenderSensors(ClayMan* clayMan, const SensorStats& sensors)
+{
+    UICard::RenderSectionCard(clayMan, "Sensors", [this, clayMan, &sensors]() {
+        
+        Clay_ElementDeclaration sensorList = {};
+        sensorList.layout.sizing = clayMan->expandXY();
+        sensorList.layout.layoutDirection = CLAY_TOP_TO_BOTTOM;
+        sensorList.layout.childGap = 6;
+        
+        clayMan->element(sensorList, [this, clayMan, &sensors]() {
+            for (const auto& temperature : sensors.temperatures) {
+                // Without a driver-supplied critical point, scale the bar to 100C
+                float limit = temperature.critical > 0.0f ? temperature.critical : 100.0f;
+                float share = std::clamp(temperature.value / limit, 0.0f, 1.0f);
+                RenderSensorRow(clayMan, temperature.chip + " " + temperature.label,
+                    std::to_string(static_cast<int>(temperature.value + 0.5f)) + " C", share, share >= 0.9f);
+            }
+            
+            for (const auto& fan : sensors.fans) {
+                // Fans expose no maximum, so the bar uses a rough 3000 RPM scale
+                RenderSensorRow(clayMan, fan.chip + " " + fan.label,
+                    std::to_string(static_cast<int>(fan.value)) + " RPM", std::clamp(fan.value / 3000.0f, 0.0f, 1.0f), false);
+            }
+            
+            for (const auto& cpu : sensors.cpuFrequencies) {
+                float share = cpu.maxMHz > 0.0f ? std::clamp(cpu.currentMHz / cpu.maxMHz, 0.0f, 1.0f) : 0.0f;
+                std::string value = std::to_string(static_cast<int>(cpu.currentMHz)) + " MHz";
+                if (cpu.throttleCount > 0) value += "  throttled " + std::to_string(cpu.throttleCount) + "x";
+                RenderSensorRow(clayMan, "CPU " + std::to_string(cpu.cpu), value, share, cpu.throttlesPerSec > 0.0f);
+            }
+        });
+        
+    }, 0); // Auto height
+}
+
+void PerformanceScreen::RenderPower(ClayMan* clayMan, const PowerStats& power, uint32_t windowWidth)
+{
+    uint32_t cardHeight = 140;
+    
+    auto formatWatts = [](float watts) {
+        return std::to_string(static_cast<int>(watts + 0.5f)) + " W";
+    };
+    
+    UICard::RenderSectionCard(clayMan, "Power", [clayMan, &power, cardHeight, windowWidth, &formatWatts]() {
+        
+        Clay_ElementDeclaration powerGrid = {};
+        powerGrid.layout.sizing = clayMan->expandXfixedY(cardHeight);
+        powerGrid.layout.layoutDirection = CLAY_LEFT_TO_RIGHT;
+        powerGrid.layout.childGap = std::max(16u, static_cast<uint32_t>(windowWidth * 0.02f));
+        
+        clayMan->element(powerGrid, [clayMan, &power, cardHeight, &formatWatts]() {
+            UICard::RenderMetricCard(clayMan, "Package Power",
+                formatWatts(power.packageWatts),
+                "All CPU sockets",
+                { 255, 150, 0, 255 }, cardHeight);
+            
+            UICard::RenderMetricCard(clayMan, "Core Power",
+                formatWatts(power.coreWatts),
+                "CPU cores only",
+                { 0, 255, 150, 255 }, cardHeight);
+            
+            UICard::RenderMetricCard(clayMan, "DRAM Power",
+                formatWatts(power.dramWatts),
+                "Memory controllers",
+                { 100, 150, 255, 255 }, cardHeight);
+            
+            std::string efficiency = power.joulesPerCpuSecond > 0.0f
+                ? std::to_string(static_cast<int>(power.joulesPerCpuSecond + 0.5f)) + " J"
+                : "-";
+            UICard::RenderMetricCard(clayMan, "Energy per CPU-second",
+                efficiency,
+                "Package joules per busy CPU second",
+                { 255, 100, 255, 255 }, cardHeight);
+        });
+        
+    }, cardHeight + 80);
+}
+
+void PerformanceScreen::RenderSensorRow(ClayMan* clayMan, const std::string& label, const std::string& value, float share, bool isWarning)
+{
+    Clay_Color barColor = isWarning ? Clay_Color{ 255, 80, 80, 255 } : Clay_Color{ 255, 150, 0, 255 };
+    
+    Clay_ElementDeclaration sensorRow = {};
+    sensorRow.layout.sizing = clayMan->expandXfixedY(28);
+    sensorRow.layout.layoutDirection = CLAY_LEFT_TO_RIGHT;
+    sensorRow.layout.childAlignment = { CLAY_ALIGN_X_LEFT, CLAY_ALIGN_Y_CENTER };
+    sensorRow.layout.childGap = 12;
+    sensorRow.backgroundColor = { 35, 35, 35, 255 };
+    sensorRow.cornerRadius = { 6, 6, 6, 6 };
+    sensorRow.layout.padding = clayMan->padXY(12, 6);
+    
+    clayMan->element(sensorRow, [clayMan, &label, &value, share, barColor, isWarning]() {
+        Clay_TextElementConfig labelText = {};
+        labelText.textColor = { 160, 160, 160, 255 };
+        labelText.fontId = 0;
+        labelText.fontSize = 12;
+        
+        Clay_ElementDeclaration labelCell = {};
+        labelCell.layout.sizing = clayMan->fixedSize(220, 28);
+        labelCell.layout.childAlignment = { CLAY_ALIGN_X_LEFT, CLAY_ALIGN_Y_CENTER };
+        clayMan->element(labelCell, [clayMan, &label, labelText]() {
+            clayMan->textElement(label, labelText);
+        });
+        
+        Clay_ElementDeclaration barTrack = {};
+        barTrack.layout.sizing = clayMan->expandXfixedY(10);
+        barTrack.backgroundColor = { 25, 25, 25, 255 };
+        barTrack.cornerRadius = { 5, 5, 5, 5 };
+        clayMan->element(barTrack, [clayMan, share, barColor]() {
+            Clay_ElementDeclaration barFill = {};
+            barFill.layout.sizing.width = CLAY_SIZING_PERCENT(share);
+            barFill.layout.sizing.height = CLAY_SIZING_GROW(0);
+            barFill.backgroundColor = barColor;
+            barFill.cornerRadius = { 5, 5, 5, 5 };
+            clayMan->element(barFill, []() {});
+        });
+        
+        Clay_ElementDeclaration valueCell = {};
+        valueCell.layout.sizing = clayMan->fixedSize(200, 28);
+        valueCell.layout.childAlignment = { CLAY_ALIGN_X_RIGHT, CLAY_ALIGN_Y_CENTER };
+        clayMan->element(valueCell, [clayMan, &value, isWarning]() {
+            Clay_TextElementConfig valueText = {};
+            valueText.textColor = isWarning ? Clay_Color{ 255, 120, 120, 255 } : Clay_Color{ 200, 200, 200, 255 };
+            valueText.fontId = 0;
+            valueText.fontSize = 12;
+            clayMan->textElement(value, valueText);
+        });
+    });
+}
+
+void PerformanceScreen::RenderEnhancedHardwareCard(ClayMan* clayMan, const std::string& title, const std::string& subtitle, float currentUsage, const GraphSeries& historyData, Clay_Color accentColor, uint32_t cardHeight, SeriesView<uint64_t> historyTimes, const QuantileWindows* quantiles, GraphTimeAxis axis)
+{
+    UICard::RenderWithBackground(clayMan, [clayMan, &title, &subtitle, currentUsage, &historyData, accentColor, cardHeight, historyTimes, quantiles, axis]() {
         
         Clay_ElementDeclaration cardLayout = {};
         cardLayout.layout.sizing = clayMan->expandXY();
@@ -181,7 +639,7 @@ void PerformanceScreen::RenderEnhancedHardwareCard(ClayMan* clayMan, const std::
         cardLayout.layout.padding = clayMan->padAll(16);
         cardLayout.layout.childGap = 12;
         
-        clayMan->element(cardLayout, [clayMan, &title, &subtitle, currentUsage, &historyData, accentColor, cardHeight]() {
+        clayMan->element(cardLayout, [clayMan, &title, &subtitle, currentUsage, &historyData, accentColor, cardHeight, historyTimes, quantiles, axis]() {
             
             // Header section with title and current value
             Clay_ElementDeclaration headerSection = {};
@@ -223,8 +681,12 @@ void PerformanceScreen::RenderEnhancedHardwareCard(ClayMan* clayMan, const std::
             Clay_ElementDeclaration graphSection = {};
             graphSection.layout.sizing = clayMan->expandXfixedY(cardHeight - 120);
             
-            clayMan->element(graphSection, [clayMan, &historyData, accentColor, cardHeight]() {
-                GraphComponent::RenderTimeSeriesGraph(clayMan, historyData, accentColor, cardHeight - 120);
+            clayMan->element(graphSection, [clayMan, &historyData, accentColor, cardHeight, historyTimes, axis]() {
+                if (!historyTimes.empty()) {
+                    GraphComponent::RenderTimeSeriesGraph(clayMan, historyData, historyTimes, accentColor, cardHeight - 120, axis);
+                } else {
+                    GraphComponent::RenderTimeSeriesGraph(clayMan, historyData, accentColor, cardHeight - 120);
+                }
             });
             
             // Footer with subtitle
@@ -234,13 +696,24 @@ void PerformanceScreen::RenderEnhancedHardwareCard(ClayMan* clayMan, const std::
             footerSection.backgroundColor = { 25, 25, 25, 255 };
             footerSection.cornerRadius = { 8, 8, 8, 8 };
             footerSection.layout.padding = clayMan->padXY(12, 8);
+            footerSection.layout.layoutDirection = CLAY_LEFT_TO_RIGHT;
             
-            clayMan->element(footerSection, [clayMan, &subtitle]() {
+            clayMan->element(footerSection, [clayMan, &subtitle, quantiles]() {
                 Clay_TextElementConfig subtitleText = {};
                 subtitleText.textColor = { 160, 160, 160, 255 };
                 subtitleText.fontId = 0;
                 subtitleText.fontSize = 12;
                 clayMan->textElement(subtitle, subtitleText);
+                
+                if (quantiles && !quantiles->empty()) {
+                    Clay_ElementDeclaration spacer = {};
+                    spacer.layout.sizing = clayMan->expandX();
+                    clayMan->element(spacer, []() {});
+                    
+                    Clay_TextElementConfig percentileText = subtitleText;
+                    percentileText.textColor = { 200, 200, 200, 255 };
+                    clayMan->textElement(FormatPercentiles(*quantiles), percentileText);
+                }
             });
         });
         
@@ -338,7 +811,7 @@ void PerformanceScreen::RenderHardwareInfoCard(ClayMan* clayMan, const std::stri
     }, { 40, 40, 40, 255 }, cardHeight, 0, 16);
 }
 
-void PerformanceScreen::RenderHardwareCard(ClayMan* clayMan, const std::string& hardwareName, const std::string& hardwareDetails, float currentUsage, const RingBuffer<float, 300>& historyData, Clay_Color accentColor, uint32_t cardHeight)
+void PerformanceScreen::RenderHardwareCard(ClayMan* clayMan, const std::string& hardwareName, const std::string& hardwareDetails, float currentUsage, const GraphSeries& historyData, Clay_Color accentColor, uint32_t cardHeight)
 {
     // Use the enhanced version
     RenderEnhancedHardwareCard(clayMan, hardwareName, hardwareDetails, currentUsage, historyData, accentColor, cardHeight);
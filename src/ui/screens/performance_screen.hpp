@@ -4,6 +4,8 @@
 #include "../components/ui_card.hpp"
 #include "../components/text_components.hpp"
 #include "../components/layout_components.hpp"
+#include <array>
+#include <cstdint>
 #include <vector>
 #include <utility>
 
@@ -17,11 +19,48 @@ private:
     void RenderSystemOverview(ClayMan* clayMan, const SystemState& systemState, uint32_t windowWidth);
     void RenderPerformanceMetrics(ClayMan* clayMan, const SystemState& systemState, uint32_t cardHeight);
     void RenderHardwareDetails(ClayMan* clayMan, const SystemState& systemState, uint32_t windowWidth);
+    void RenderStorage(ClayMan* clayMan, const SystemState& systemState);
+    void RenderSensors(ClayMan* clayMan, const SensorStats& sensors);
+    void RenderPower(ClayMan* clayMan, const PowerStats& power, uint32_t windowWidth);
+    void RenderGpuBreakdown(ClayMan* clayMan, const GpuStats& gpu);
     
-    // Enhanced card rendering methods
-    void RenderEnhancedHardwareCard(ClayMan* clayMan, const std::string& title, const std::string& subtitle, float currentUsage, const RingBuffer<float, 300>& historyData, Clay_Color accentColor, uint32_t cardHeight);
+    // Enhanced card rendering methods; with historyTimes the graph places samples by time, so missed ticks show as gaps.
+    // Histories are views, so any retention or element type can be drawn without copying.
+    // With quantiles, the footer also shows p50/p95/p99 over the last minute and the last hour.
+    void RenderEnhancedHardwareCard(ClayMan* clayMan, const std::string& title, const std::string& subtitle, float currentUsage, const GraphSeries& historyData, Clay_Color accentColor, uint32_t cardHeight, SeriesView<uint64_t> historyTimes = {}, const QuantileWindows* quantiles = nullptr, GraphTimeAxis axis = {});
+    
+    // A metric card over the selected range: the raw window live, the rollup tier TieredSeries::bestTier picks otherwise
+    struct RangeBuffer;
+    void RenderHistoryCard(ClayMan* clayMan, const std::string& title, const std::string& subtitle, float currentUsage, const TieredSeries& history, RangeBuffer& buffer, Clay_Color accentColor, uint32_t cardHeight, const QuantileWindows* quantiles);
     void RenderHardwareInfoCard(ClayMan* clayMan, const std::string& title, const std::vector<std::pair<std::string, std::string>>& info, Clay_Color accentColor, uint32_t cardHeight);
     
+    void RenderNumaGroupingToggle(ClayMan* clayMan);
+    void RenderGraphRangeSelector(ClayMan* clayMan);
+    void RenderFilesystemRow(ClayMan* clayMan, const FilesystemInfo& fs);
+    void RenderSensorRow(ClayMan* clayMan, const std::string& label, const std::string& value, float share, bool isWarning);
+    static std::string FormatCpuList(const std::vector<uint32_t>& cpus);
+    static std::string FormatPercentiles(const QuantileWindows& quantiles);
+    
     // Legacy method for compatibility
-    void RenderHardwareCard(ClayMan* clayMan, const std::string& hardwareName, const std::string& hardwareDetails, float currentUsage, const RingBuffer<float, 300>& historyData, Clay_Color accentColor, uint32_t cardHeight = 400);
+    void RenderHardwareCard(ClayMan* clayMan, const std::string& hardwareName, const std::string& hardwareDetails, float currentUsage, const GraphSeries& historyData, Clay_Color accentColor, uint32_t cardHeight = 400);
+    
+    // Show one CPU graph per NUMA node instead of a single aggregate graph
+    bool groupCpuByNode_ = false;
+    
+    // How far back the performance graphs reach; past the live view, bars are averaged from the history's rollups
+    enum class GraphRange { Live, TenMinutes, Hour, SixHours, TwoDays };
+    GraphRange graphRange_ = GraphRange::Live;
+    static constexpr size_t RangeSlots = 48; // Bars in a ranged graph, and the pixel budget handed to bestTier
+    static uint64_t RangeSeconds(GraphRange range);
+    
+    // Per-card scratch space for ranged graphs, reused every frame so drawing doesn't allocate once warmed up
+    struct RangeBuffer {
+        std::vector<TieredSeries::Point> points;
+        std::vector<float> values;
+        std::vector<uint64_t> times;
+    };
+    std::array<RangeBuffer, 4> rangeBuffers_; // CPU, GPU, memory, disk
+    
+    // Averages the range's points into RangeSlots slots ending at the newest sample; empty slots are left out
+    static void ResampleRange(const TieredSeries& history, uint64_t rangeSeconds, RangeBuffer& buffer);
 };
\ No newline at end of file
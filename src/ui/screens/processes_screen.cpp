@@ -22,6 +22,20 @@ void ProcessesScreen::RenderContent(ClayMan* clayMan, const SystemState& systemS
     
     clayMan->element(processContainer, [this, clayMan, &systemState, windowWidth]() {
         RenderProcessSummary(clayMan, systemState, windowWidth);
+        uint32_t selectedPid = dataCollector_ ? dataCollector_->GetSelectedProcess() : 0;
+        const ProcessMetadata* metadata = selectedPid != 0 ? dataCollector_->GetProcessMetadata(selectedPid) : nullptr;
+        if (metadata) {
+            RenderProcessDetails(clayMan, systemState, *metadata);
+        }
+        if (systemState.numa.isAvailable && systemState.numa.selectedProcess.isValid) {
+            RenderNumaPlacement(clayMan, systemState);
+        }
+        if (!systemState.users.empty()) {
+            RenderUserTable(clayMan, systemState.users);
+        }
+        if (!systemState.fds.top.empty()) {
+            RenderFdTable(clayMan, systemState.fds);
+        }
         RenderProcessTable(clayMan, systemState.processes);
     });
 }
@@ -52,49 +66,33 @@ void ProcessesScreen::RenderProcessSummary(ClayMan* clayMan, const SystemState&
                 "Active system threads",
                 { 100, 150, 255, 255 }, cardHeight);
             
-            // Top Process by CPU
-            std::string topProcessName = "None";
-            float topProcessCpu = 0.0f;
-            if (!systemState.processes.empty()) {
-                auto topProcess = std::max_element(systemState.processes.begin(), systemState.processes.end(),
-                    [](const ProcessInfo& a, const ProcessInfo& b) {
-                        return a.cpuUsagePercent < b.cpuUsagePercent;
-                    });
-                if (topProcess != systemState.processes.end()) {
-                    topProcessName = topProcess->name;
-                    topProcessCpu = topProcess->cpuUsagePercent;
-                }
+            // Leaders come straight from the collector's ranking; no per-frame scan
+            const ProcessStore& processes = systemState.processes;
+            size_t topCpu = ProcessStore::npos;
+            size_t topMemory = ProcessStore::npos;
+            if (dataCollector_) {
+                const ProcessRanking& ranking = dataCollector_->GetProcessRanking();
+                topCpu = ranking.GetFirst(ProcessSortKey::Cpu);
+                topMemory = ranking.GetFirst(ProcessSortKey::Memory);
             }
+            bool hasCpu = topCpu < processes.size();
+            bool hasMemory = topMemory < processes.size();
             
             UICard::RenderMetricCard(clayMan, "Highest CPU",
-                FormatPercentage(topProcessCpu),
-                topProcessName,
+                FormatPercentage(hasCpu ? processes.cpuUsagePercent(topCpu) : 0.0f),
+                hasCpu ? processes.name(topCpu) : "None",
                 { 255, 150, 0, 255 }, cardHeight);
             
-            // Top Process by Memory
-            std::string topMemoryProcessName = "None";
-            uint64_t topMemoryUsage = 0;
-            if (!systemState.processes.empty()) {
-                auto topMemoryProcess = std::max_element(systemState.processes.begin(), systemState.processes.end(),
-                    [](const ProcessInfo& a, const ProcessInfo& b) {
-                        return a.memoryUsage < b.memoryUsage;
-                    });
-                if (topMemoryProcess != systemState.processes.end()) {
-                    topMemoryProcessName = topMemoryProcess->name;
-                    topMemoryUsage = topMemoryProcess->memoryUsage;
-                }
-            }
-            
             UICard::RenderMetricCard(clayMan, "Highest Memory",
-                FormatBytes(topMemoryUsage),
-                topMemoryProcessName,
+                FormatBytes(hasMemory ? processes.memoryUsage(topMemory) : 0),
+                hasMemory ? processes.name(topMemory) : "None",
                 { 255, 100, 255, 255 }, cardHeight);
         });
         
     }, cardHeight + 80);
 }
 
-void ProcessesScreen::RenderProcessTable(ClayMan* clayMan, const std::vector<ProcessInfo>& processes)
+void ProcessesScreen::RenderProcessTable(ClayMan* clayMan, const ProcessStore& processes)
 {
     UICard::RenderSectionCard(clayMan, "Running Processes", [this, clayMan, &processes]() {
         
@@ -105,6 +103,10 @@ void ProcessesScreen::RenderProcessTable(ClayMan* clayMan, const std::vector<Pro
         
         clayMan->element(tableContainer, [this, clayMan, &processes]() {
             
+            if (dataCollector_) {
+                RenderTableToolbar(clayMan, processes);
+            }
+            
             // Table header
             RenderProcessTableHeader(clayMan);
             
@@ -116,7 +118,9 @@ void ProcessesScreen::RenderProcessTable(ClayMan* clayMan, const std::vector<Pro
             
             clayMan->element(tableContent, [this, clayMan, &processes]() {
                 
-                if (processes.empty()) {
+                if (treeView_ && dataCollector_ && !processes.empty()) {
+                    RenderProcessTree(clayMan, dataCollector_->GetProcessTree());
+                } else if (processes.empty() || !dataCollector_) {
                     // No processes message
                     Clay_ElementDeclaration noDataContainer = {};
                     noDataContainer.layout.sizing = clayMan->expandXfixedY(100);
@@ -130,19 +134,28 @@ void ProcessesScreen::RenderProcessTable(ClayMan* clayMan, const std::vector<Pro
                         clayMan->textElement("No process data available", noDataText);
                     });
                 } else {
-                    // Sort processes by CPU usage (descending)
-                    std::vector<ProcessInfo> sortedProcesses = processes;
-                    std::sort(sortedProcesses.begin(), sortedProcesses.end(),
-                        [](const ProcessInfo& a, const ProcessInfo& b) {
-                            return a.cpuUsagePercent > b.cpuUsagePercent;
-                        });
+                    // Only the rows inside the viewport are emitted; the ranking is sorted just deep enough to cover them
+                    const ProcessFilter& filter = dataCollector_->GetProcessFilter();
+                    size_t rowCount = filter.IsActive() ? filter.GetMatches().size() : processes.size();
+                    if (rowCount == 0) {
+                        Clay_TextElementConfig noMatchText = {};
+                        noMatchText.textColor = { 150, 150, 150, 255 };
+                        noMatchText.fontId = 0;
+                        noMatchText.fontSize = 14;
+                        clayMan->textElement("No processes match the filter", noMatchText);
+                        return;
+                    }
                     
-                    // Limit to top 50 processes for performance
-                    size_t maxProcesses = std::min(static_cast<size_t>(50), sortedProcesses.size());
+                    Clay_ElementId bodyId = CLAY_ID("ProcessTableBody");
+                    uint32_t viewportHeight = std::max(300u, static_cast<uint32_t>(clayMan->getWindowHeight() * 0.6f));
+                    TableComponent::RowRange visible = TableComponent::GetVisibleRows(bodyId, rowCount, viewportHeight);
+                    dataCollector_->EnsureVisibleRankDepth(sortKey_, visible.last);
+                    std::span<const uint32_t> order = dataCollector_->GetVisibleProcessRanking().GetTop(sortKey_);
                     
-                    for (size_t i = 0; i < maxProcesses; ++i) {
-                        RenderProcessRow(clayMan, sortedProcesses[i], i % 2 == 0);
-                    }
+                    TableComponent::RenderVirtualRows(clayMan, bodyId, rowCount, viewportHeight, [this, &processes, order](ClayMan* clayMan, size_t i) {
+                        if (i >= order.size() || order[i] >= processes.size()) return;
+                        RenderProcessRow(clayMan, processes.row(order[i]), i % 2 == 0);
+                    });
                 }
             });
         });
@@ -161,95 +174,106 @@ void ProcessesScreen::RenderProcessTableHeader(ClayMan* clayMan)
     headerRow.layout.padding = clayMan->padXY(12, 8);
     
     clayMan->element(headerRow, [this, clayMan]() {
+        // Clicking a header ranks the list by that column; tree mode keeps its own order
+        RenderSortHeaderCell(clayMan, "Process Name", ProcessSortKey::Name, 0);
+        RenderSortHeaderCell(clayMan, "PID", ProcessSortKey::Pid, 80);
+        RenderSortHeaderCell(clayMan, "CPU %", ProcessSortKey::Cpu, 100);
+        RenderSortHeaderCell(clayMan, "Memory", ProcessSortKey::Memory, 120);
+        RenderSortHeaderCell(clayMan, "I/O", ProcessSortKey::Io, 110);
+        RenderSortHeaderCell(clayMan, "FD %", ProcessSortKey::FdUsage, 80);
+        RenderSortHeaderCell(clayMan, "Status", ProcessSortKey::Count, 100);
+    });
+}
+
+void ProcessesScreen::RenderSortHeaderCell(ClayMan* clayMan, const char* title, ProcessSortKey key, uint32_t width)
+{
+    bool sortable = key != ProcessSortKey::Count && !treeView_;
+    bool active = sortable && key == sortKey_;
+    
+    Clay_ElementDeclaration column = {};
+    column.id = CLAY_IDI("ProcessSortHeader", static_cast<uint32_t>(key));
+    column.layout.sizing = width > 0 ? clayMan->fixedSize(width, 40) : clayMan->expandXfixedY(40);
+    column.layout.childAlignment = width > 0 ? clayMan->centerXY() : Clay_ChildAlignment{ CLAY_ALIGN_X_LEFT, CLAY_ALIGN_Y_CENTER };
+    
+    clayMan->element(column, [this, clayMan, title, key, sortable, active]() {
+        if (sortable && Clay_PointerOver(CLAY_IDI("ProcessSortHeader", static_cast<uint32_t>(key))) && clayMan->mousePressed()) {
+            sortKey_ = key;
+        }
         
-        // Process Name column
-        Clay_ElementDeclaration nameColumn = {};
-        nameColumn.layout.sizing = clayMan->expandXfixedY(40);
-        nameColumn.layout.childAlignment = { CLAY_ALIGN_X_LEFT, CLAY_ALIGN_Y_CENTER };
-        
-        clayMan->element(nameColumn, [clayMan]() {
-            Clay_TextElementConfig headerText = {};
-            headerText.textColor = { 220, 220, 220, 255 };
-            headerText.fontId = 0;
-            headerText.fontSize = 14;
-            clayMan->textElement("Process Name", headerText);
-        });
-        
-        // PID column
-        Clay_ElementDeclaration pidColumn = {};
-        pidColumn.layout.sizing = clayMan->fixedSize(80, 40);
-        pidColumn.layout.childAlignment = clayMan->centerXY();
-        
-        clayMan->element(pidColumn, [clayMan]() {
-            Clay_TextElementConfig headerText = {};
-            headerText.textColor = { 220, 220, 220, 255 };
-            headerText.fontId = 0;
-            headerText.fontSize = 14;
-            clayMan->textElement("PID", headerText);
-        });
-        
-        // CPU Usage column
-        Clay_ElementDeclaration cpuColumn = {};
-        cpuColumn.layout.sizing = clayMan->fixedSize(100, 40);
-        cpuColumn.layout.childAlignment = clayMan->centerXY();
-        
-        clayMan->element(cpuColumn, [clayMan]() {
-            Clay_TextElementConfig headerText = {};
-            headerText.textColor = { 220, 220, 220, 255 };
-            headerText.fontId = 0;
-            headerText.fontSize = 14;
-            clayMan->textElement("CPU %", headerText);
-        });
-        
-        // Memory Usage column
-        Clay_ElementDeclaration memoryColumn = {};
-        memoryColumn.layout.sizing = clayMan->fixedSize(120, 40);
-        memoryColumn.layout.childAlignment = clayMan->centerXY();
-        
-        clayMan->element(memoryColumn, [clayMan]() {
-            Clay_TextElementConfig headerText = {};
-            headerText.textColor = { 220, 220, 220, 255 };
-            headerText.fontId = 0;
-            headerText.fontSize = 14;
-            clayMan->textElement("Memory", headerText);
-        });
-        
-        // Status column
-        Clay_ElementDeclaration statusColumn = {};
-        statusColumn.layout.sizing = clayMan->fixedSize(100, 40);
-        statusColumn.layout.childAlignment = clayMan->centerXY();
-        
-        clayMan->element(statusColumn, [clayMan]() {
-            Clay_TextElementConfig headerText = {};
-            headerText.textColor = { 220, 220, 220, 255 };
-            headerText.fontId = 0;
-            headerText.fontSize = 14;
-            clayMan->textElement("Status", headerText);
-        });
+        Clay_TextElementConfig headerText = {};
+        headerText.textColor = active ? Clay_Color{ 0, 255, 150, 255 } : Clay_Color{ 220, 220, 220, 255 };
+        headerText.fontId = 0;
+        headerText.fontSize = 14;
+        clayMan->textElement(active ? std::string(title) + " *" : std::string(title), headerText);
     });
 }
 
-void ProcessesScreen::RenderProcessRow(ClayMan* clayMan, const ProcessInfo& process, bool isEvenRow)
+void ProcessesScreen::RenderProcessRow(ClayMan* clayMan, const ProcessStore::Row& process, bool isEvenRow, int treeDepth, int treeToggle)
 {
     Clay_Color rowColor = isEvenRow ? Clay_Color{ 35, 35, 35, 255 } : Clay_Color{ 30, 30, 30, 255 };
+    bool isSelected = dataCollector_ && dataCollector_->GetSelectedProcess() == process.pid;
+    if (dataCollector_) {
+        // Rows on screen get their path and command line loaded in the background, once per process
+        dataCollector_->RequestProcessMetadata(process.pid);
+    }
+    if (isSelected) {
+        rowColor = { 0, 255, 150, 40 }; // Subtle green highlight for the selected process
+    }
     
     Clay_ElementDeclaration processRow = {};
-    processRow.layout.sizing = clayMan->expandXfixedY(36);
+    // Indexed ID so clicks can be matched to the row without caching strings
+    processRow.id = CLAY_IDI("ProcessRow", process.pid);
+    processRow.layout.sizing = clayMan->expandXfixedY(TableComponent::RowHeight);
     processRow.layout.layoutDirection = CLAY_LEFT_TO_RIGHT;
     processRow.layout.childGap = 1;
     processRow.backgroundColor = rowColor;
     processRow.layout.padding = clayMan->padXY(12, 6);
     
-    clayMan->element(processRow, [this, clayMan, &process]() {
+    clayMan->element(processRow, [this, clayMan, &process, isSelected, treeDepth, treeToggle]() {
+        // Clicking the tree toggle expands/collapses; anywhere else on the row selects it, and clicking again clears it
+        bool overToggle = treeToggle != 0 && Clay_PointerOver(CLAY_IDI("ProcessTreeToggle", process.pid));
+        if (overToggle && clayMan->mousePressed()) {
+            if (!toggledPids_.erase(process.pid)) toggledPids_.insert(process.pid);
+        } else if (dataCollector_ && Clay_PointerOver(CLAY_IDI("ProcessRow", process.pid)) && clayMan->mousePressed()) {
+            dataCollector_->SetSelectedProcess(isSelected ? 0 : process.pid);
+        }
         
         // Process Name
         Clay_ElementDeclaration nameCell = {};
         nameCell.layout.sizing = clayMan->expandXfixedY(36);
+        nameCell.layout.layoutDirection = CLAY_LEFT_TO_RIGHT;
         nameCell.layout.childAlignment = { CLAY_ALIGN_X_LEFT, CLAY_ALIGN_Y_CENTER };
         
-        clayMan->element(nameCell, [clayMan, &process]() {
+        clayMan->element(nameCell, [clayMan, &process, treeDepth, treeToggle]() {
+            if (treeDepth >= 0) {
+                Clay_ElementDeclaration indent = {};
+                indent.layout.sizing = clayMan->fixedSize(static_cast<uint32_t>(treeDepth) * 16, 20);
+                clayMan->element(indent, []() {});
+                
+                Clay_ElementDeclaration toggle = {};
+                toggle.id = CLAY_IDI("ProcessTreeToggle", process.pid);
+                toggle.layout.sizing = clayMan->fixedSize(22, 20);
+                toggle.layout.childAlignment = clayMan->centerXY();
+                if (treeToggle != 0) {
+                    toggle.backgroundColor = { 55, 55, 55, 255 };
+                    toggle.cornerRadius = { 4, 4, 4, 4 };
+                }
+                clayMan->element(toggle, [clayMan, treeToggle]() {
+                    if (treeToggle == 0) return;
+                    Clay_TextElementConfig toggleText = {};
+                    toggleText.textColor = { 200, 200, 200, 255 };
+                    toggleText.fontId = 0;
+                    toggleText.fontSize = 12;
+                    clayMan->textElement(treeToggle == 1 ? "+" : "-", toggleText);
+                });
+                
+                Clay_ElementDeclaration gap = {};
+                gap.layout.sizing = clayMan->fixedSize(6, 20);
+                clayMan->element(gap, []() {});
+            }
+            
             // Truncate long process names
-            std::string displayName = process.name;
+            std::string displayName = *process.name;
             if (displayName.length() > 25) {
                 displayName = displayName.substr(0, 22) + "...";
             }
@@ -307,6 +331,32 @@ void ProcessesScreen::RenderProcessRow(ClayMan* clayMan, const ProcessInfo& proc
             clayMan->textElement(FormatBytes(process.memoryUsage), memoryText);
         });
         
+        // Disk I/O (read + write)
+        Clay_ElementDeclaration ioCell = {};
+        ioCell.layout.sizing = clayMan->fixedSize(110, 36);
+        ioCell.layout.childAlignment = clayMan->centerXY();
+        
+        clayMan->element(ioCell, [clayMan, &process]() {
+            Clay_TextElementConfig ioText = {};
+            ioText.textColor = { 180, 180, 180, 255 };
+            ioText.fontId = 0;
+            ioText.fontSize = 12;
+            clayMan->textElement(FormatBytes(process.ioBytesPerSec) + "/s", ioText);
+        });
+        
+        // Open file descriptors as a share of the soft limit; red once a service is close to running out
+        Clay_ElementDeclaration fdCell = {};
+        fdCell.layout.sizing = clayMan->fixedSize(80, 36);
+        fdCell.layout.childAlignment = clayMan->centerXY();
+        
+        clayMan->element(fdCell, [clayMan, &process]() {
+            Clay_TextElementConfig fdText = {};
+            fdText.textColor = process.fdUsagePercent >= 80.0f ? Clay_Color{ 255, 100, 100, 255 } : Clay_Color{ 180, 180, 180, 255 };
+            fdText.fontId = 0;
+            fdText.fontSize = 12;
+            clayMan->textElement(process.fdUsagePercent >= 0.0f ? FormatPercentage(process.fdUsagePercent) : "-", fdText);
+        });
+        
         // Status with color coding
         Clay_ElementDeclaration statusCell = {};
         statusCell.layout.sizing = clayMan->fixedSize(100, 36);
@@ -314,7 +364,7 @@ void ProcessesScreen::RenderProcessRow(ClayMan* clayMan, const ProcessInfo& proc
         
         clayMan->element(statusCell, [clayMan, &process]() {
             Clay_Color statusColor = { 0, 255, 150, 255 }; // Green for running
-            if (process.status != "Running") {
+            if (*process.status != "Running") {
                 statusColor = { 255, 255, 100, 255 }; // Yellow for other states
             }
             
@@ -322,7 +372,420 @@ void ProcessesScreen::RenderProcessRow(ClayMan* clayMan, const ProcessInfo& proc
             statusText.textColor = statusColor;
             statusText.fontId = 0;
             statusText.fontSize = 12;
-            clayMan->textElement(process.status, statusText);
+            clayMan->textElement(*process.status, statusText);
+        });
+    });
+}
+
+void ProcessesScreen::RenderProcessDetails(ClayMan* clayMan, const SystemState& systemState, const ProcessMetadata& metadata)
+{
+    uint32_t pid = dataCollector_->GetSelectedProcess();
+    std::string processName = "PID " + std::to_string(pid);
+    size_t row = systemState.processes.find(pid);
+    if (row != ProcessStore::npos) {
+        processName = systemState.processes.name(row) + " (" + std::to_string(pid) + ")";
+    }
+    
+    const ProcessHistory& history = systemState.selectedProcessHistory;
+    UICard::RenderSectionCard(clayMan, "Process Details - " + processName, [this, clayMan, &metadata, &history, pid]() {
+        if (history.pid == pid && !history.cpu.empty()) {
+            RenderProcessHistory(clayMan, history);
+        }
+        
+        Clay_ElementDeclaration detailList = {};
+        detailList.layout.sizing = clayMan->expandXY();
+        detailList.layout.layoutDirection = CLAY_TOP_TO_BOTTOM;
+        detailList.layout.childGap = 6;
+        
+        clayMan->element(detailList, [clayMan, &metadata]() {
+            // Fields the kernel wouldn't give us (other users' processes, kernel threads) show as a dash
+            const std::string unavailable = metadata.timedOut ? "Timed out" : "-";
+            const std::pair<const char*, const std::string*> details[] = {
+                { "Command line", &metadata.commandLine },
+                { "Executable", &metadata.executablePath },
+                { "Working directory", &metadata.workingDirectory },
+                { "Cgroup", &metadata.cgroup }
+            };
+            
+            for (const auto& [label, value] : details) {
+                Clay_ElementDeclaration detailRow = {};
+                // Long command lines wrap, so the row grows with its text
+                detailRow.layout.sizing.width = CLAY_SIZING_GROW(0);
+                detailRow.layout.sizing.height = CLAY_SIZING_FIT(28);
+                detailRow.layout.layoutDirection = CLAY_LEFT_TO_RIGHT;
+                detailRow.layout.childAlignment = { CLAY_ALIGN_X_LEFT, CLAY_ALIGN_Y_CENTER };
+                detailRow.layout.childGap = 12;
+                detailRow.backgroundColor = { 35, 35, 35, 255 };
+                detailRow.cornerRadius = { 6, 6, 6, 6 };
+                detailRow.layout.padding = clayMan->padXY(12, 6);
+                
+                clayMan->element(detailRow, [clayMan, label, value, &unavailable]() {
+                    Clay_ElementDeclaration labelCell = {};
+                    labelCell.layout.sizing = clayMan->fixedSize(140, 28);
+                    labelCell.layout.childAlignment = { CLAY_ALIGN_X_LEFT, CLAY_ALIGN_Y_CENTER };
+                    
+                    clayMan->element(labelCell, [clayMan, label]() {
+                        Clay_TextElementConfig labelText = {};
+                        labelText.textColor = { 160, 160, 160, 255 };
+                        labelText.fontId = 0;
+                        labelText.fontSize = 12;
+                        clayMan->textElement(label, labelText);
+                    });
+                    
+                    Clay_TextElementConfig valueText = {};
+                    valueText.textColor = { 200, 200, 200, 255 };
+                    valueText.fontId = 0;
+                    valueText.fontSize = 12;
+                    clayMan->textElement(value->empty() ? unavailable : *value, valueText);
+                });
+            }
         });
+        
+    }, 0); // Auto height
+}
+
+void ProcessesScreen::FoldProcessHistory(const ProcessHistory& history)
+{
+    HistoryGraph& graph = historyGraph_;
+    if (graph.pid == history.pid && graph.latestTime == history.cpu.latestTime() && graph.samples == history.cpu.size()) return;
+    graph.pid = history.pid;
+    graph.latestTime = history.cpu.latestTime();
+    graph.samples = history.cpu.size();
+    graph.values.clear();
+    graph.times.clear();
+    
+    // The whole history fits in HistorySlots bars; a young one gets a bar per 1 Hz sample
+    int64_t newest = history.cpu.latestTime();
+    uint64_t span = static_cast<uint64_t>(newest - history.cpu.oldestTime());
+    uint64_t slotMs = std::max<uint64_t>(1000, (span + HistorySlots - 1) / HistorySlots);
+    graph.axis = { slotMs, HistorySlots };
+    
+    std::array<float, HistorySlots> sums = {};
+    std::array<uint32_t, HistorySlots> counts = {};
+    history.cpu.forEach([&](int64_t time, float value) {
+        uint64_t slotsBack = static_cast<uint64_t>(newest - time) / slotMs;
+        if (slotsBack >= HistorySlots) return;
+        size_t slot = HistorySlots - 1 - static_cast<size_t>(slotsBack);
+        sums[slot] += value;
+        counts[slot]++;
     });
-}
\ No newline at end of file
+    for (size_t slot = 0; slot < HistorySlots; ++slot) {
+        if (counts[slot] == 0) continue;
+        graph.values.push_back(sums[slot] / static_cast<float>(counts[slot]));
+        graph.times.push_back(static_cast<uint64_t>(newest) - (HistorySlots - 1 - slot) * slotMs);
+    }
+    
+    graph.peakMemory = 0.0f;
+    history.memory.forEach([&graph](int64_t, float value) { graph.peakMemory = std::max(graph.peakMemory, value); });
+}
+
+void ProcessesScreen::RenderProcessHistory(ClayMan* clayMan, const ProcessHistory& history)
+{
+    FoldProcessHistory(history);
+    
+    Clay_ElementDeclaration historySection = {};
+    historySection.layout.sizing = clayMan->expandXfixedY(170);
+    historySection.layout.layoutDirection = CLAY_TOP_TO_BOTTOM;
+    historySection.layout.childGap = 6;
+    
+    clayMan->element(historySection, [this, clayMan, &history]() {
+        size_t storedBytes = history.cpu.encodedBytes() + history.memory.encodedBytes();
+        std::string caption = "CPU since selected - peak memory " + FormatBytes(static_cast<uint64_t>(historyGraph_.peakMemory))
+            + ", " + std::to_string(history.cpu.size()) + " samples in " + FormatBytes(storedBytes);
+        
+        Clay_TextElementConfig captionText = {};
+        captionText.textColor = { 160, 160, 160, 255 };
+        captionText.fontId = 0;
+        captionText.fontSize = 12;
+        clayMan->textElement(caption, captionText);
+        
+        GraphComponent::RenderTimeSeriesGraph(clayMan,
+            GraphSeries(SeriesView<float>(std::span<const float>(historyGraph_.values))),
+            SeriesView<uint64_t>(std::span<const uint64_t>(historyGraph_.times)),
+            { 0, 255, 150, 255 }, 140, historyGraph_.axis);
+    });
+}
+
+void ProcessesScreen::RenderNumaPlacement(ClayMan* clayMan, const SystemState& systemState)
+{
+    const NumaProcessPlacement& placement = systemState.numa.selectedProcess;
+    
+    std::string processName = "PID " + std::to_string(placement.pid);
+    size_t row = systemState.processes.find(placement.pid);
+    if (row != ProcessStore::npos) {
+        processName = systemState.processes.name(row) + " (" + std::to_string(placement.pid) + ")";
+    }
+    
+    UICard::RenderSectionCard(clayMan, "NUMA Placement - " + processName, [clayMan, &systemState, &placement]() {
+        
+        Clay_ElementDeclaration nodeList = {};
+        nodeList.layout.sizing = clayMan->expandXY();
+        nodeList.layout.layoutDirection = CLAY_TOP_TO_BOTTOM;
+        nodeList.layout.childGap = 6;
+        
+        clayMan->element(nodeList, [clayMan, &systemState, &placement]() {
+            for (size_t i = 0; i < placement.nodeBytes.size() && i < systemState.numa.nodes.size(); ++i) {
+                uint64_t bytes = placement.nodeBytes[i];
+                float share = placement.totalBytes > 0
+                    ? static_cast<float>(bytes) / static_cast<float>(placement.totalBytes) : 0.0f;
+                std::string nodeLabel = "Node " + std::to_string(systemState.numa.nodes[i].id);
+                
+                Clay_ElementDeclaration nodeRow = {};
+                nodeRow.layout.sizing = clayMan->expandXfixedY(28);
+                nodeRow.layout.layoutDirection = CLAY_LEFT_TO_RIGHT;
+                nodeRow.layout.childAlignment = { CLAY_ALIGN_X_LEFT, CLAY_ALIGN_Y_CENTER };
+                nodeRow.layout.childGap = 12;
+                nodeRow.backgroundColor = { 35, 35, 35, 255 };
+                nodeRow.cornerRadius = { 6, 6, 6, 6 };
+                nodeRow.layout.padding = clayMan->padXY(12, 6);
+                
+                clayMan->element(nodeRow, [clayMan, &nodeLabel, bytes, share]() {
+                    // Node label
+                    Clay_ElementDeclaration labelCell = {};
+                    labelCell.layout.sizing = clayMan->fixedSize(80, 28);
+                    labelCell.layout.childAlignment = { CLAY_ALIGN_X_LEFT, CLAY_ALIGN_Y_CENTER };
+                    
+                    clayMan->element(labelCell, [clayMan, &nodeLabel]() {
+                        Clay_TextElementConfig labelText = {};
+                        labelText.textColor = { 160, 160, 160, 255 };
+                        labelText.fontId = 0;
+                        labelText.fontSize = 12;
+                        clayMan->textElement(nodeLabel, labelText);
+                    });
+                    
+                    // Share bar
+                    Clay_ElementDeclaration barTrack = {};
+                    barTrack.layout.sizing = clayMan->expandXfixedY(10);
+                    barTrack.backgroundColor = { 25, 25, 25, 255 };
+                    barTrack.cornerRadius = { 5, 5, 5, 5 };
+                    
+                    clayMan->element(barTrack, [clayMan, share]() {
+                        Clay_ElementDeclaration barFill = {};
+                        barFill.layout.sizing.width = CLAY_SIZING_PERCENT(share);
+                        barFill.layout.sizing.height = CLAY_SIZING_GROW(0);
+                        barFill.backgroundColor = { 100, 150, 255, 255 };
+                        barFill.cornerRadius = { 5, 5, 5, 5 };
+                        clayMan->element(barFill, []() {});
+                    });
+                    
+                    // Resident bytes and share
+                    Clay_ElementDeclaration valueCell = {};
+                    valueCell.layout.sizing = clayMan->fixedSize(140, 28);
+                    valueCell.layout.childAlignment = { CLAY_ALIGN_X_RIGHT, CLAY_ALIGN_Y_CENTER };
+                    
+                    clayMan->element(valueCell, [clayMan, bytes, share]() {
+                        Clay_TextElementConfig valueText = {};
+                        valueText.textColor = { 200, 200, 200, 255 };
+                        valueText.fontId = 0;
+                        valueText.fontSize = 12;
+                        clayMan->textElement(FormatBytes(bytes) + " (" + FormatPercentage(share * 100.0f) + ")", valueText);
+                    });
+                });
+            }
+        });
+        
+    }, 0); // Auto height
+}
+
+void ProcessesScreen::RenderUserTable(ClayMan* clayMan, const std::vector<UserUsage>& users)
+{
+    static const std::array<TableColumn, 6> columns = {{
+        {"User", 0, {220, 220, 220, 255}, 12},  // expandable width
+        {"Processes", 100, {160, 160, 160, 255}, 12},
+        {"CPU %", 100, {255, 150, 0, 255}, 12},
+        {"Memory", 120, {100, 150, 255, 255}, 12},
+        {"Disk Read", 120, {180, 180, 180, 255}, 12},
+        {"Disk Write", 120, {180, 180, 180, 255}, 12}
+    }};
+    
+    UICard::RenderSectionCard(clayMan, "Users", [clayMan, &users]() {
+        TableComponent::RenderFixedTable(clayMan, columns.data(), columns.size(),
+            [&users](ClayMan* clayMan, size_t rowIndex) {
+                const UserUsage& user = users[rowIndex];
+                std::array<std::string, 6> cells = {
+                    user.name,
+                    std::to_string(user.processCount),
+                    FormatPercentage(user.cpuUsagePercent),
+                    FormatBytes(user.memoryBytes),
+                    FormatBytes(user.ioReadBytesPerSec) + "/s",
+                    FormatBytes(user.ioWriteBytesPerSec) + "/s"
+                };
+                TableComponent::RenderTextRow(clayMan, columns.data(), columns.size(), cells.data(), rowIndex % 2 == 0);
+            }, users.size(), 400, CLAY_ID("UserTableBody"));
+    }, 0); // Auto height
+}
+
+void ProcessesScreen::RenderFdTable(ClayMan* clayMan, const FdStats& fds)
+{
+    static const std::array<TableColumn, 7> columns = {{
+        {"Process", 0, {220, 220, 220, 255}, 12},
+        {"Open / Limit", 140, {255, 150, 0, 255}, 12},
+        {"FD %", 80, {255, 150, 0, 255}, 12},
+        {"Sockets", 90, {100, 150, 255, 255}, 12},
+        {"Pipes", 80, {180, 180, 180, 255}, 12},
+        {"Files", 80, {180, 180, 180, 255}, 12},
+        {"Other", 80, {180, 180, 180, 255}, 12}
+    }};
+    
+    UICard::RenderSectionCard(clayMan, "File Descriptors - Nearest Their Limit", [clayMan, &fds]() {
+        TableComponent::RenderFixedTable(clayMan, columns.data(), columns.size(),
+            [&fds](ClayMan* clayMan, size_t rowIndex) {
+                const ProcessFdBreakdown& process = fds.top[rowIndex];
+                float usage = process.softLimit > 0
+                    ? static_cast<float>(process.total) / static_cast<float>(process.softLimit) * 100.0f : 0.0f;
+                std::array<std::string, 7> cells = {
+                    process.name + " (" + std::to_string(process.pid) + ")",
+                    std::to_string(process.total) + " / " + std::to_string(process.softLimit),
+                    FormatPercentage(usage),
+                    std::to_string(process.sockets),
+                    std::to_string(process.pipes),
+                    std::to_string(process.files),
+                    std::to_string(process.other)
+                };
+                TableComponent::RenderTextRow(clayMan, columns.data(), columns.size(), cells.data(), rowIndex % 2 == 0);
+            }, fds.top.size(), 400, CLAY_ID("FdTableBody"));
+    }, 0); // Auto height
+}
+
+void ProcessesScreen::RenderTableToolbar(ClayMan* clayMan, const ProcessStore& processes)
+{
+    Clay_ElementDeclaration toolbar = {};
+    toolbar.layout.sizing = clayMan->expandXfixedY(36);
+    toolbar.layout.layoutDirection = CLAY_LEFT_TO_RIGHT;
+    toolbar.layout.childAlignment = { CLAY_ALIGN_X_LEFT, CLAY_ALIGN_Y_CENTER };
+    toolbar.layout.childGap = 12;
+    
+    clayMan->element(toolbar, [this, clayMan, &processes]() {
+        RenderTreeModeToggle(clayMan);
+        RenderFilterBox(clayMan, processes);
+    });
+}
+
+void ProcessesScreen::RenderTreeModeToggle(ClayMan* clayMan)
+{
+    Clay_ElementDeclaration toggleButton = {};
+    toggleButton.id = CLAY_ID("ProcessTreeModeToggle");
+    toggleButton.layout.sizing = clayMan->fixedSize(160, 32);
+    toggleButton.layout.childAlignment = clayMan->centerXY();
+    toggleButton.cornerRadius = { 8, 8, 8, 8 };
+    if (treeView_) {
+        toggleButton.backgroundColor = { 0, 255, 150, 25 };
+        toggleButton.border.width = { 1, 1, 1, 1 };
+        toggleButton.border.color = { 0, 255, 150, 100 };
+    } else {
+        toggleButton.backgroundColor = { 45, 45, 45, 255 };
+    }
+    
+    clayMan->element(toggleButton, [this, clayMan]() {
+        if (Clay_PointerOver(CLAY_ID("ProcessTreeModeToggle")) && clayMan->mousePressed()) {
+            treeView_ = !treeView_;
+        }
+        
+        Clay_TextElementConfig toggleText = {};
+        toggleText.textColor = treeView_ ? Clay_Color{ 240, 240, 240, 255 } : Clay_Color{ 160, 160, 160, 255 };
+        toggleText.fontId = 0;
+        toggleText.fontSize = 13;
+        clayMan->textElement(treeView_ ? "Tree view" : "Show as tree", toggleText);
+    });
+}
+
+void ProcessesScreen::RenderFilterBox(ClayMan* clayMan, const ProcessStore& processes)
+{
+    bool hasQuery = !filterText_.empty();
+    
+    Clay_ElementDeclaration filterBox = {};
+    filterBox.layout.sizing = clayMan->expandXfixedY(32);
+    filterBox.layout.childAlignment = { CLAY_ALIGN_X_LEFT, CLAY_ALIGN_Y_CENTER };
+    filterBox.layout.padding = clayMan->padXY(12, 6);
+    filterBox.backgroundColor = { 30, 30, 30, 255 };
+    filterBox.cornerRadius = { 8, 8, 8, 8 };
+    filterBox.border.width = { 1, 1, 1, 1 };
+    filterBox.border.color = hasQuery ? Clay_Color{ 100, 150, 255, 160 } : Clay_Color{ 60, 60, 60, 255 };
+    
+    clayMan->element(filterBox, [this, clayMan, hasQuery]() {
+        // Typing anywhere on this screen edits the filter; Esc clears it
+        Clay_TextElementConfig filterText = {};
+        filterText.textColor = hasQuery ? Clay_Color{ 230, 230, 230, 255 } : Clay_Color{ 120, 120, 120, 255 };
+        filterText.fontId = 0;
+        filterText.fontSize = 13;
+        clayMan->textElement(hasQuery ? filterText_ + "_" : std::string("Type to filter - name, path, user:, pid:"), filterText);
+    });
+    
+    if (hasQuery && !treeView_) {
+        Clay_TextElementConfig countText = {};
+        countText.textColor = { 160, 160, 160, 255 };
+        countText.fontId = 0;
+        countText.fontSize = 12;
+        clayMan->textElement(std::to_string(dataCollector_->GetProcessFilter().GetMatches().size()) + " of " +
+            std::to_string(processes.size()), countText);
+    }
+}
+
+void ProcessesScreen::OnTextInput(const char* text)
+{
+    if (!dataCollector_ || !text) return;
+    filterText_ += text;
+    dataCollector_->SetProcessFilter(filterText_);
+}
+
+void ProcessesScreen::OnEditKey(EditKey key)
+{
+    if (!dataCollector_ || filterText_.empty()) return;
+    if (key == EditKey::Clear) {
+        filterText_.clear();
+    } else {
+        // Drop the last UTF-8 code point, not just its final byte
+        size_t end = filterText_.size() - 1;
+        while (end > 0 && (static_cast<unsigned char>(filterText_[end]) & 0xC0) == 0x80) --end;
+        filterText_.erase(end);
+    }
+    dataCollector_->SetProcessFilter(filterText_);
+}
+
+void ProcessesScreen::RenderProcessTree(ClayMan* clayMan, const ProcessTree& tree)
+{
+    // Not virtualized like the flat list; the cap and collapsed families keep the visible row count small
+    std::vector<std::pair<const ProcessTree::Node*, int>> rows;
+    CollectTreeRows(tree, tree.GetRoots(), 0, rows, 200);
+    
+    for (size_t i = 0; i < rows.size(); ++i) {
+        const ProcessTree::Node& node = *rows[i].first;
+        bool hasChildren = !node.children.empty();
+        bool expanded = IsExpanded(node);
+        
+        // A collapsed node stands for its whole subtree, so it shows the rolled-up cost
+        const ProcessTotals& totals = (hasChildren && !expanded) ? node.subtree : node.self;
+        std::string status = (hasChildren && !expanded)
+            ? std::to_string(node.subtree.processCount) + " procs"
+            : node.status;
+        ProcessStore::Row display;
+        display.pid = node.pid;
+        display.name = &node.name;
+        display.status = &status;
+        display.cpuUsagePercent = static_cast<float>(std::max(0.0, totals.cpuUsagePercent));
+        display.memoryUsage = static_cast<uint64_t>(std::max<int64_t>(0, totals.memoryBytes));
+        display.ioBytesPerSec = static_cast<uint64_t>(std::max<int64_t>(0, totals.ioReadBytesPerSec + totals.ioWriteBytesPerSec));
+        
+        RenderProcessRow(clayMan, display, i % 2 == 0, rows[i].second, hasChildren ? (expanded ? 2 : 1) : 0);
+    }
+}
+
+void ProcessesScreen::CollectTreeRows(const ProcessTree& tree, const std::vector<uint32_t>& pids, int depth, std::vector<std::pair<const ProcessTree::Node*, int>>& rows, size_t maxRows) const
+{
+    // The tree keeps each level ordered heaviest first, so this is a plain walk
+    for (uint32_t pid : pids) {
+        const ProcessTree::Node* node = tree.Find(pid);
+        if (!node) continue;
+        if (rows.size() >= maxRows) return;
+        rows.emplace_back(node, depth);
+        if (!node->children.empty() && IsExpanded(*node)) {
+            CollectTreeRows(tree, node->children, depth + 1, rows, maxRows);
+        }
+    }
+}
+
+bool ProcessesScreen::IsExpanded(const ProcessTree::Node& node) const
+{
+    bool toggled = toggledPids_.count(node.pid) > 0;
+    return node.isFamilyRoot ? toggled : !toggled;
+}
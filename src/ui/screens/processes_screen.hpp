@@ -2,15 +2,62 @@
 #include "base_screen.hpp"
 #include "../components/ui_card.hpp"
 #include "../components/table_component.hpp"
+#include "../components/graph_component.hpp"
+#include <array>
+#include <unordered_set>
 
 class ProcessesScreen : public BaseScreen
 {
+public:
+    explicit ProcessesScreen(DataCollector* dataCollector) : dataCollector_(dataCollector) {}
+
+    void OnTextInput(const char* text) override;
+    void OnEditKey(EditKey key) override;
+
 protected:
     void RenderContent(ClayMan* clayMan, const SystemState& systemState) override;
     
 private:
     void RenderProcessSummary(ClayMan* clayMan, const SystemState& systemState, uint32_t windowWidth);
-    void RenderProcessTable(ClayMan* clayMan, const std::vector<ProcessInfo>& processes);
+    void RenderProcessTable(ClayMan* clayMan, const ProcessStore& processes);
     void RenderProcessTableHeader(ClayMan* clayMan);
-    void RenderProcessRow(ClayMan* clayMan, const ProcessInfo& process, bool isEvenRow);
+    // width 0 expands; ProcessSortKey::Count marks a column that can't be sorted
+    void RenderSortHeaderCell(ClayMan* clayMan, const char* title, ProcessSortKey key, uint32_t width);
+    // treeDepth >= 0 indents the name for tree mode; treeToggle is 0 (leaf), 1 (collapsed) or 2 (expanded)
+    void RenderProcessRow(ClayMan* clayMan, const ProcessStore::Row& process, bool isEvenRow, int treeDepth = -1, int treeToggle = 0);
+    void RenderTableToolbar(ClayMan* clayMan, const ProcessStore& processes);
+    void RenderTreeModeToggle(ClayMan* clayMan);
+    void RenderFilterBox(ClayMan* clayMan, const ProcessStore& processes);
+    void RenderProcessTree(ClayMan* clayMan, const ProcessTree& tree);
+    void CollectTreeRows(const ProcessTree& tree, const std::vector<uint32_t>& pids, int depth, std::vector<std::pair<const ProcessTree::Node*, int>>& rows, size_t maxRows) const;
+    bool IsExpanded(const ProcessTree::Node& node) const;
+    void RenderNumaPlacement(ClayMan* clayMan, const SystemState& systemState);
+    void RenderProcessDetails(ClayMan* clayMan, const SystemState& systemState, const ProcessMetadata& metadata);
+    void RenderProcessHistory(ClayMan* clayMan, const ProcessHistory& history);
+    void RenderUserTable(ClayMan* clayMan, const std::vector<UserUsage>& users);
+    void RenderFdTable(ClayMan* clayMan, const FdStats& fds);
+
+    DataCollector* dataCollector_ = nullptr;
+    ProcessSortKey sortKey_ = ProcessSortKey::Cpu;
+    std::string filterText_;
+    
+    // Tree mode: families (make, bazel, browsers) start collapsed, everything else expanded;
+    // toggledPids_ holds the nodes the user flipped from that default
+    bool treeView_ = false;
+    std::unordered_set<uint32_t> toggledPids_;
+    
+    // The selected process's compressed history folded into graph slots. Decoding walks every sample, so it is
+    // redone only when a sample arrives, not every frame.
+    static constexpr size_t HistorySlots = 48;
+    struct HistoryGraph {
+        uint32_t pid = 0;
+        int64_t latestTime = 0;
+        size_t samples = 0;
+        GraphTimeAxis axis;
+        std::vector<float> values;
+        std::vector<uint64_t> times;
+        float peakMemory = 0.0f;
+    };
+    HistoryGraph historyGraph_;
+    void FoldProcessHistory(const ProcessHistory& history);
 };
\ No newline at end of file
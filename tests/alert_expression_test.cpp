@@ -0,0 +1,223 @@
+// Compiles and evaluates alert expressions against a small metric table: parse errors and where they are
+// reported, precedence, units, windowed avg/min/max and percentiles over real histories, windows longer than the raw
+// history answered from the rollups, NaN on empty ones, and that evaluating a compiled rule allocates nothing.
+#include "core/alert_expression.hpp"
+#include "test_support.hpp"
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+	size_t allocations = 0;
+}
+
+// Counts every allocation in the process, so a test can assert a stretch of code made none
+void* operator new(size_t size)
+{
+	++allocations;
+	if (void* memory = std::malloc(size ? size : 1)) return memory;
+	throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, size_t) noexcept { std::free(memory); }
+
+namespace
+{
+	struct Memory
+	{
+		uint64_t total = 16ull << 30;
+		uint64_t used = 15ull << 30;
+	};
+
+	// The collector's table in miniature: cpu with a history and percentiles, a plain counter, a computed value
+	// and a history that never receives a sample
+	struct Fixture
+	{
+		SeriesArena arena{ 2 * TieredSeries::storageBytes(300) + QuantileWindows::storageBytes(Mapping) };
+		TieredSeries cpuHistory;
+		TieredSeries idleHistory;
+		QuantileWindows cpuQuantiles;
+		float cpu = 0.0f;
+		float idle = 0.0f;
+		uint32_t procs = 400;
+		Memory memory;
+		MetricTable metrics;
+
+		static constexpr QuantileSketch::Mapping Mapping{ 0.1f, 100.0f, 0.01f };
+
+		Fixture()
+		{
+			cpuHistory.allocate(arena, 300);
+			idleHistory.allocate(arena, 300);
+			cpuQuantiles.allocate(arena, Mapping);
+			// 100 one-second samples: 70 at 10 % and then 30 at 50 %
+			for (uint64_t i = 0; i < 100; ++i) {
+				cpu = i < 70 ? 10.0f : 50.0f;
+				cpuHistory.push(1000 + i * 1000, cpu);
+				cpuQuantiles.push(1000 + i * 1000, cpu);
+			}
+
+			metrics.Add("cpu", cpu, &cpuHistory, &cpuQuantiles);
+			metrics.Add("procs", procs);
+			metrics.Add("idle", idle, &idleHistory);
+			metrics.AddComputed("mem.available", &memory, [](const void* context) {
+				const Memory& memory = *static_cast<const Memory*>(context);
+				return static_cast<double>(memory.total - memory.used);
+			});
+		}
+
+		double Evaluate(const std::string& source)
+		{
+			AlertExpression expression;
+			std::string error;
+			if (!expression.Compile(source, metrics, error)) {
+				std::fprintf(stderr, "unexpected compile error in '%s': %s\n", source.c_str(), error.c_str());
+				return std::nan("");
+			}
+			return expression.Evaluate(metrics);
+		}
+
+		// The error message, or "" if source compiled
+		std::string CompileError(const std::string& source)
+		{
+			AlertExpression expression;
+			std::string error;
+			if (expression.Compile(source, metrics, error)) return "";
+			CHECK(expression.IsEmpty());
+			return error;
+		}
+	};
+
+	void TestParseErrors()
+	{
+		Fixture fixture;
+		CHECK(fixture.CompileError("") == "empty expression at column 1");
+		CHECK(fixture.CompileError("cpu >") == "expression ends early at column 6");
+		CHECK(fixture.CompileError("nope > 1") == "unknown metric 'nope' at column 1");
+		CHECK(fixture.CompileError("cpu > 1 2") == "unexpected '2' at column 9");
+		CHECK(fixture.CompileError("(1 + 2") == "expected ')' at column 7");
+		CHECK(fixture.CompileError("1 = 2") == "unexpected '=' at column 3");
+		CHECK(fixture.CompileError("2XB") == "unknown unit 'XB' at column 2");
+		CHECK(fixture.CompileError("avg(cpu)") == "expected ',' at column 8");
+		CHECK(fixture.CompileError("avg(cpu, 30)") == "expected a duration such as 30s, 5m or 1h at column 12");
+		CHECK(fixture.CompileError("avg(cpu, 0s)") == "window out of range at column 12");
+		CHECK(fixture.CompileError("avg(procs, 30s)") == "metric 'procs' has no history at column 5");
+		CHECK(fixture.CompileError("p95(idle, 1m)") == "metric 'idle' has no percentiles at column 5");
+		CHECK(fixture.CompileError("p95(cpu, 5m)") == "expected a percentile window: 1m, 1h or all at column 10");
+
+		// Nesting is bounded so a hostile rule can't exhaust the parser's stack or the evaluation stack
+		std::string deep = std::string(100, '(') + "1" + std::string(100, ')');
+		CHECK(fixture.CompileError(deep).find("nested too deeply") != std::string::npos);
+		std::string wide = "0";
+		for (int i = 0; i < 40; ++i) wide = "1 + (" + wide + ")";
+		CHECK(fixture.CompileError(wide).find("too large") != std::string::npos);
+	}
+
+	void TestPrecedence()
+	{
+		Fixture fixture;
+		CHECK(fixture.Evaluate("1 + 2 * 3") == 7.0);
+		CHECK(fixture.Evaluate("(1 + 2) * 3") == 9.0);
+		CHECK(fixture.Evaluate("8 - 2 - 1") == 5.0); // Left to right
+		CHECK(fixture.Evaluate("10 / 4") == 2.5);
+		CHECK(fixture.Evaluate("-2 - -3") == 1.0);
+		CHECK(fixture.Evaluate("1 or 0 and 0") == 1.0); // and binds tighter than or
+		CHECK(fixture.Evaluate("not 1 > 2") == 1.0); // not applies to the whole comparison
+		CHECK(fixture.Evaluate("!(1 > 2) && 1 || 0") == 1.0);
+		CHECK(fixture.Evaluate("1 < 2 and 2 <= 2 and 3 > 2 and 3 >= 3 and 1 == 1 and 1 != 2") == 1.0);
+		CHECK(fixture.Evaluate("procs > 300 and cpu == 50") == 1.0);
+	}
+
+	void TestUnits()
+	{
+		Fixture fixture;
+		CHECK(fixture.Evaluate("80%") == 80.0);
+		CHECK(fixture.Evaluate("1KiB") == 1024.0);
+		CHECK(fixture.Evaluate("1GiB") == 1073741824.0);
+		CHECK(fixture.Evaluate("1.5MB") == 1.5e6);
+		CHECK(fixture.Evaluate("1TB") == 1e12);
+		CHECK(fixture.Evaluate("mem.available") == static_cast<double>(1ull << 30));
+		CHECK(fixture.Evaluate("mem.available < 2GiB") == 1.0);
+	}
+
+	void TestWindows()
+	{
+		Fixture fixture;
+		CHECK(fixture.Evaluate("avg(cpu, 30s)") == 50.0);
+		CHECK_NEAR(fixture.Evaluate("avg(cpu, 31s)"), (50.0 * 30 + 10.0) / 31.0, 1e-4);
+		CHECK_NEAR(fixture.Evaluate("avg(cpu, 100m)"), 22.0, 1e-4); // Longer than the history: all of it
+		CHECK(fixture.Evaluate("min(cpu, 30s)") == 50.0);
+		CHECK(fixture.Evaluate("min(cpu, 1m)") == 10.0);
+		CHECK(fixture.Evaluate("max(cpu, 1h)") == 50.0);
+		CHECK(fixture.Evaluate("avg(cpu, 30s) > 40 and mem.available < 2GiB") == 1.0);
+
+		// Percentiles come from the sketches, within their 1% relative error
+		CHECK_NEAR(fixture.Evaluate("p50(cpu, 1m)"), 50.0, 0.5); // The last 60 s: 10 at 10 %, 50 at 50 %
+		CHECK_NEAR(fixture.Evaluate("p50(cpu, all)"), 10.0, 0.1);
+		CHECK_NEAR(fixture.Evaluate("p99(cpu, 1h)"), 50.0, 0.5);
+		CHECK(fixture.Evaluate("p95(cpu, 1h) > 40") == 1.0);
+
+		// An empty history gives NaN, and every comparison with NaN is false
+		CHECK(std::isnan(fixture.Evaluate("avg(idle, 30s)")));
+		CHECK(fixture.Evaluate("avg(idle, 30s) > 1") == 0.0);
+		CHECK(fixture.Evaluate("avg(idle, 30s) < 1") == 0.0);
+		CHECK(fixture.Evaluate("avg(idle, 30s) != 1") == 0.0);
+	}
+
+	// A one-minute raw window under 8 hours of samples: 10 for the first hour, 50 after. Windows past the raw
+	// samples come from the 10 s rollups while those reach back far enough, and from the 1 min rollups beyond.
+	void TestLongWindows()
+	{
+		SeriesArena arena{ TieredSeries::storageBytes(60) };
+		TieredSeries history;
+		history.allocate(arena, 60);
+		float load = 0.0f;
+		for (uint64_t second = 1; second <= 8 * 3600; ++second) {
+			load = second < 3600 ? 10.0f : 50.0f;
+			history.push(second * 1000, load);
+		}
+		MetricTable metrics;
+		metrics.Add("load", load, &history);
+
+		auto evaluate = [&metrics](const std::string& source) {
+			AlertExpression expression;
+			std::string error;
+			if (!expression.Compile(source, metrics, error)) return std::nan("");
+			return expression.Evaluate(metrics);
+		};
+		CHECK(evaluate("avg(load, 30s)") == 50.0); // Raw
+		CHECK(evaluate("min(load, 5h)") == 50.0); // 10 s rollups
+		CHECK(evaluate("min(load, 7h)") == 50.0); // 1 min rollups, stopping at the first hour's end
+		CHECK(evaluate("min(load, 8h)") == 10.0);
+		CHECK(evaluate("max(load, 2h)") == 50.0);
+		CHECK_NEAR(evaluate("avg(load, 8h)"), (3599.0 * 10.0 + 25201.0 * 50.0) / 28800.0, 1e-3);
+		CHECK_NEAR(evaluate("avg(load, 30m)"), 50.0, 1e-4);
+	}
+
+	void TestNoAllocations()
+	{
+		Fixture fixture;
+		AlertExpression expression;
+		std::string error;
+		CHECK(expression.Compile("avg(cpu, 30s) > 10 and not (max(cpu, 1h) > cpu * 2) or min(cpu, 5m) == 3 or p95(cpu, 1m) > 90",
+			fixture.metrics, error));
+
+		size_t before = allocations;
+		size_t hits = 0;
+		for (int i = 0; i < 1000; ++i) hits += expression.Test(fixture.metrics) ? 1 : 0;
+		CHECK(allocations == before);
+		CHECK(hits == 1000);
+	}
+}
+
+int main()
+{
+	TestParseErrors();
+	TestPrecedence();
+	TestUnits();
+	TestWindows();
+	TestLongWindows();
+	TestNoAllocations();
+	return TestSupport::Result();
+}
@@ -0,0 +1,148 @@
+// Runs LinuxGpuMonitor against a fake /proc/[pid]/fdinfo tree, since CI machines have no GPU.
+#include "platform/linux/linux_gpu_monitor.hpp"
+#include "test_support.hpp"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+using TestSupport::TempDir;
+
+namespace
+{
+	std::string FdInfo(const std::string& clientId, uint64_t renderNs, uint64_t videoNs, const std::string& memory)
+	{
+		return "pos:\t0\nflags:\t02100002\n"
+			"drm-driver:\ti915\n"
+			"drm-pdev:\t0000:00:02.0\n"
+			"drm-client-id:\t" + clientId + "\n"
+			"drm-engine-render:\t" + std::to_string(renderNs) + " ns\n"
+			"drm-engine-video:\t" + std::to_string(videoNs) + " ns\n"
+			"drm-engine-capacity-video:\t2\n"
+			+ memory;
+	}
+
+	void AddProcess(const TempDir& root, uint32_t pid, const std::string& name)
+	{
+		std::string dir = "proc/" + std::to_string(pid) + "/";
+		root.Write(dir + "comm", name + "\n");
+		root.Link(dir + "fd/0", "/dev/null");
+	}
+
+	void AddDrmFd(const TempDir& root, uint32_t pid, uint32_t fd, const std::string& fdinfo)
+	{
+		std::string dir = "proc/" + std::to_string(pid) + "/";
+		root.Link(dir + "fd/" + std::to_string(fd), "/dev/dri/renderD128");
+		root.Write(dir + "fdinfo/" + std::to_string(fd), fdinfo);
+	}
+
+	const GpuProcess* FindProcess(const GpuStats& gpu, uint32_t pid)
+	{
+		auto it = std::find_if(gpu.processes.begin(), gpu.processes.end(), [pid](const GpuProcess& p) { return p.pid == pid; });
+		return it != gpu.processes.end() ? &*it : nullptr;
+	}
+
+	const GpuEngine* FindEngine(const GpuStats& gpu, const std::string& name)
+	{
+		auto it = std::find_if(gpu.engines.begin(), gpu.engines.end(), [&name](const GpuEngine& e) { return e.name == name; });
+		return it != gpu.engines.end() ? &*it : nullptr;
+	}
+
+	void TestParseFdInfo()
+	{
+		LinuxGpuMonitor::FdInfo info;
+		CHECK(LinuxGpuMonitor::ParseFdInfo(FdInfo("7", 1500, 20, "drm-memory-system:\t2 MiB\ndrm-memory-local:\t512 KiB\n"), info));
+		CHECK(info.driver == "i915");
+		CHECK(info.pdev == "0000:00:02.0");
+		CHECK(info.clientId == "7");
+		CHECK(info.engineNs["render"] == 1500);
+		CHECK(info.engineNs["video"] == 20);
+		CHECK(info.engineCapacity["video"] == 2);
+		CHECK(info.memoryBytes == 2 * 1024 * 1024 + 512 * 1024);
+
+		// drm-resident-* replaces the legacy drm-memory-* totals when both are present
+		LinuxGpuMonitor::FdInfo resident;
+		CHECK(LinuxGpuMonitor::ParseFdInfo(FdInfo("8", 0, 0, "drm-memory-system:\t4 MiB\ndrm-resident-system:\t1 MiB\n"), resident));
+		CHECK(resident.memoryBytes == 1024 * 1024);
+
+		// Not a DRM fd
+		LinuxGpuMonitor::FdInfo plain;
+		CHECK(!LinuxGpuMonitor::ParseFdInfo("pos:\t0\nflags:\t02\nmnt_id:\t25\n", plain));
+	}
+
+	void TestEngineDeltas()
+	{
+		TempDir root;
+		root.Link("sys/class/drm/card0/device/driver", "../../../../bus/pci/drivers/i915");
+		root.Write("sys/class/drm/card0-DP-1/status", "connected\n");
+
+		// Process 100 holds client 1 through two fds (a dup); process 200 has clients 2 and 3
+		const std::string memory = "drm-memory-system:\t1 MiB\n";
+		AddProcess(root, 100, "firefox");
+		AddDrmFd(root, 100, 5, FdInfo("1", 1'000'000'000, 0, memory));
+		AddDrmFd(root, 100, 6, FdInfo("1", 1'000'000'000, 0, memory));
+		AddProcess(root, 200, "Xorg");
+		AddDrmFd(root, 200, 3, FdInfo("2", 0, 0, memory));
+		AddDrmFd(root, 200, 4, FdInfo("3", 0, 0, memory));
+		AddProcess(root, 300, "bash"); // No GPU fds
+
+		LinuxGpuMonitor monitor(root.Path() + "/proc", root.Path() + "/sys");
+		CHECK(monitor.IsAvailable());
+		CHECK(monitor.GetGpu().driver == "i915");
+		monitor.Update();
+
+		// Busy time since the first sample: 100 ms render and 100 ms of video (two instances) for client 1,
+		// 25 ms render for each of clients 2 and 3
+		std::this_thread::sleep_for(std::chrono::milliseconds(200));
+		root.Write("proc/100/fdinfo/5", FdInfo("1", 1'100'000'000, 100'000'000, memory));
+		root.Write("proc/100/fdinfo/6", FdInfo("1", 1'100'000'000, 100'000'000, memory));
+		root.Write("proc/200/fdinfo/3", FdInfo("2", 25'000'000, 0, memory));
+		root.Write("proc/200/fdinfo/4", FdInfo("3", 25'000'000, 0, memory));
+		monitor.Update();
+
+		const GpuStats& gpu = monitor.GetGpu();
+		const GpuProcess* firefox = FindProcess(gpu, 100);
+		const GpuProcess* xorg = FindProcess(gpu, 200);
+		CHECK(firefox && xorg && !FindProcess(gpu, 300));
+		if (!firefox || !xorg) return;
+		CHECK(firefox->name == "firefox");
+
+		// One client seen through two fds counts once, in time and in memory; two clients in one process add up
+		CHECK(firefox->memoryBytes == 1024 * 1024);
+		CHECK(xorg->memoryBytes == 2 * 1024 * 1024);
+		CHECK(firefox->utilizationPercent >= 10.0f && firefox->utilizationPercent <= 50.0f);
+		CHECK_NEAR(xorg->utilizationPercent / firefox->utilizationPercent, 0.5, 0.01);
+		CHECK(gpu.processes.front().pid == 100); // Busiest first
+
+		const GpuEngine* render = FindEngine(gpu, "render");
+		const GpuEngine* video = FindEngine(gpu, "video");
+		CHECK(render && video);
+		if (!render || !video) return;
+		CHECK_NEAR(render->utilizationPercent / firefox->utilizationPercent, 1.5, 0.01);
+		CHECK_NEAR(video->utilizationPercent / firefox->utilizationPercent, 0.5, 0.01); // Spread over two instances
+		CHECK_NEAR(monitor.GetUtilizationPercent(), render->utilizationPercent, 0.001);
+		CHECK(monitor.GetMemoryUsed() == 3 * 1024 * 1024);
+	}
+
+	void TestNoGpu()
+	{
+		TempDir root;
+		root.Write("sys/class/drm/version", "drm 1.1.0\n");
+		AddProcess(root, 100, "bash");
+
+		LinuxGpuMonitor monitor(root.Path() + "/proc", root.Path() + "/sys");
+		CHECK(!monitor.IsAvailable());
+		monitor.Update();
+		CHECK(monitor.GetGpu().engines.empty());
+		CHECK(monitor.GetGpu().processes.empty());
+		CHECK(monitor.GetUtilizationPercent() == 0.0f);
+		CHECK(monitor.GetMemoryUsed() == 0);
+	}
+}
+
+int main()
+{
+	TestParseFdInfo();
+	TestEngineDeltas();
+	TestNoGpu();
+	return TestSupport::Result();
+}
@@ -0,0 +1,110 @@
+// Runs LinuxPowerMonitor against fixture powercap trees: a wrapped counter, a machine without RAPL, and a
+// package with core and DRAM subzones.
+#include "platform/linux/linux_power_monitor.hpp"
+#include "test_support.hpp"
+#include <chrono>
+#include <thread>
+
+using TestSupport::TempDir;
+
+namespace
+{
+	void WriteZone(const TempDir& root, const std::string& zone, const std::string& name, uint64_t energy, uint64_t maxRange)
+	{
+		std::string dir = "sys/class/powercap/" + zone + "/";
+		root.Write(dir + "name", name + "\n");
+		root.Write(dir + "energy_uj", std::to_string(energy) + "\n");
+		root.Write(dir + "max_energy_range_uj", std::to_string(maxRange) + "\n");
+	}
+
+	void WriteEnergy(const TempDir& root, const std::string& zone, uint64_t energy)
+	{
+		root.Write("sys/class/powercap/" + zone + "/energy_uj", std::to_string(energy) + "\n");
+	}
+
+	// Watts come from wall-clock time between updates; sleeping 200 ms bounds it to roughly [0.2 s, 1 s]
+	void WaitAndUpdate(LinuxPowerMonitor& monitor)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(200));
+		monitor.Update();
+	}
+
+	void TestEnergyDelta()
+	{
+		CHECK(LinuxPowerMonitor::EnergyDelta(5, 10, 100) == 5);
+		CHECK(LinuxPowerMonitor::EnergyDelta(90, 5, 100) == 15);
+		CHECK(LinuxPowerMonitor::EnergyDelta(10, 5, 0) == 0); // Wrapped with no known range
+		CHECK(LinuxPowerMonitor::EnergyDelta(200, 5, 100) == 0); // Previous reading outside the range
+	}
+
+	void TestWraparound()
+	{
+		TempDir root;
+		WriteZone(root, "intel-rapl:0", "package-0", 262'000'000'000ull - 2'000'000, 262'000'000'000ull);
+		root.Write("proc/stat", "cpu  100 0 100 1000 0 0 0 0 0 0\n");
+
+		LinuxPowerMonitor monitor(root.Path() + "/sys", root.Path() + "/proc");
+		CHECK(monitor.IsAvailable());
+		monitor.Update();
+
+		// 2 J up to the wrap and 3 J after it
+		WriteEnergy(root, "intel-rapl:0", 3'000'000);
+		WaitAndUpdate(monitor);
+		const PowerStats& power = monitor.GetPower();
+		CHECK(power.packageWatts >= 5.0f && power.packageWatts <= 25.0f);
+		CHECK(power.domains.size() == 1 && power.domains[0].type == PowerDomain::PACKAGE);
+	}
+
+	void TestMissingPowercap()
+	{
+		TempDir root;
+		root.Write("proc/stat", "cpu  100 0 100 1000 0 0 0 0 0 0\n");
+
+		LinuxPowerMonitor monitor(root.Path() + "/sys", root.Path() + "/proc");
+		CHECK(!monitor.IsAvailable());
+		monitor.Update();
+		CHECK(monitor.GetPower().domains.empty());
+		CHECK(monitor.GetPower().packageWatts == 0.0f);
+	}
+
+	void TestSubzones()
+	{
+		TempDir root;
+		const uint64_t range = 262'000'000'000ull;
+		WriteZone(root, "intel-rapl:0", "package-0", 1'000'000, range);
+		WriteZone(root, "intel-rapl:0:0", "core", 1'000'000, range);
+		WriteZone(root, "intel-rapl:0:1", "dram", 1'000'000, range);
+		root.Write("sys/class/powercap/intel-rapl-mmio:0/name", "package-0\n"); // Not a RAPL MSR zone; skipped
+		root.Write("proc/stat", "cpu  100 0 100 1000 0 0 0 0 0 0\n");
+
+		LinuxPowerMonitor monitor(root.Path() + "/sys", root.Path() + "/proc");
+		const PowerStats& power = monitor.GetPower();
+		CHECK(power.domains.size() == 3);
+		if (power.domains.size() != 3) return;
+		CHECK(power.domains[0].type == PowerDomain::PACKAGE);
+		CHECK(power.domains[1].type == PowerDomain::CORE && power.domains[1].name == "core");
+		CHECK(power.domains[2].type == PowerDomain::DRAM && power.domains[2].name == "dram");
+
+		monitor.Update();
+		WriteEnergy(root, "intel-rapl:0", 5'000'000); // 4 J
+		WriteEnergy(root, "intel-rapl:0:0", 3'000'000); // 2 J
+		WriteEnergy(root, "intel-rapl:0:1", 2'000'000); // 1 J
+		root.Write("proc/stat", "cpu  150 0 150 1100 0 0 0 0 0 0\n"); // 100 busy ticks
+		WaitAndUpdate(monitor);
+
+		// Subzones are part of the package, so only the package adds to packageWatts
+		CHECK(power.packageWatts >= 4.0f && power.packageWatts <= 20.0f);
+		CHECK_NEAR(power.coreWatts / power.packageWatts, 0.5, 0.01);
+		CHECK_NEAR(power.dramWatts / power.packageWatts, 0.25, 0.01);
+		CHECK(power.joulesPerCpuSecond > 0.0f);
+	}
+}
+
+int main()
+{
+	TestEnergyDelta();
+	TestWraparound();
+	TestMissingPowercap();
+	TestSubzones();
+	return TestSupport::Result();
+}
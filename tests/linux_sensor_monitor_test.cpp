@@ -0,0 +1,157 @@
+// Runs LinuxSensorMonitor against fixture sysfs trees: hwmon chips with labelled and unlabelled channels,
+// cpufreq and thermal_throttle per core, values changing between ticks, a read that fails, and a machine
+// with no sensors at all.
+#include "platform/linux/linux_sensor_monitor.hpp"
+#include "test_support.hpp"
+#include <chrono>
+#include <filesystem>
+#include <thread>
+
+using TestSupport::TempDir;
+
+namespace
+{
+	// coretemp with a labelled package sensor and an unlabelled core numbered out of order, a fan on a chip
+	// without a name, and two cores (only the first with a throttle counter)
+	void WriteTree(const TempDir& root)
+	{
+		root.Write("sys/class/hwmon/hwmon0/name", "coretemp\n");
+		root.Write("sys/class/hwmon/hwmon0/temp1_input", "45000\n");
+		root.Write("sys/class/hwmon/hwmon0/temp1_label", "Package id 0\n");
+		root.Write("sys/class/hwmon/hwmon0/temp1_crit", "100000\n");
+		root.Write("sys/class/hwmon/hwmon0/temp3_input", "51500\n");
+		root.Write("sys/class/hwmon/hwmon0/temp2_crit", "100000\n"); // No input; not a channel
+		root.Write("sys/class/hwmon/hwmon0/temp1_max", "84000\n");
+		root.Write("sys/class/hwmon/hwmon2/fan2_input", "1200\n");
+
+		const std::string cpu = "sys/devices/system/cpu/";
+		root.Write(cpu + "cpu0/cpufreq/scaling_cur_freq", "2400000\n");
+		root.Write(cpu + "cpu0/cpufreq/cpuinfo_max_freq", "3600000\n");
+		root.Write(cpu + "cpu0/thermal_throttle/core_throttle_count", "5\n");
+		root.Write(cpu + "cpu1/cpufreq/scaling_cur_freq", "800000\n");
+		root.Write(cpu + "cpu1/cpufreq/cpuinfo_max_freq", "3600000\n");
+		root.Write(cpu + "cpufreq/policy0/scaling_cur_freq", "2400000\n"); // Not a cpuN directory
+		root.Write(cpu + "online", "0-1\n");
+	}
+
+	void TestDiscovery()
+	{
+		TempDir root;
+		WriteTree(root);
+
+		LinuxSensorMonitor monitor(root.Path() + "/sys");
+		CHECK(monitor.IsAvailable());
+		monitor.Update();
+
+		const SensorStats& sensors = monitor.GetSensors();
+		CHECK(sensors.temperatures.size() == 2);
+		CHECK(sensors.fans.size() == 1);
+		CHECK(sensors.cpuFrequencies.size() == 2);
+		if (sensors.temperatures.size() != 2 || sensors.fans.size() != 1 || sensors.cpuFrequencies.size() != 2) return;
+
+		const SensorReading& package = sensors.temperatures[0];
+		CHECK(package.chip == "coretemp" && package.label == "Package id 0");
+		CHECK_NEAR(package.value, 45.0, 1e-4);
+		CHECK_NEAR(package.critical, 100.0, 1e-4);
+		const SensorReading& core = sensors.temperatures[1];
+		CHECK(core.chip == "coretemp" && core.label == "temp3");
+		CHECK_NEAR(core.value, 51.5, 1e-4);
+		CHECK(core.critical == 0.0f);
+
+		CHECK(sensors.fans[0].chip == "hwmon2" && sensors.fans[0].label == "fan2");
+		CHECK(sensors.fans[0].value == 1200.0f);
+
+		const CpuFrequency& cpu0 = sensors.cpuFrequencies[0];
+		CHECK(cpu0.cpu == 0 && cpu0.currentMHz == 2400.0f && cpu0.maxMHz == 3600.0f);
+		CHECK(cpu0.throttleCount == 5 && cpu0.throttlesPerSec == 0.0f); // No rate from the first tick
+		const CpuFrequency& cpu1 = sensors.cpuFrequencies[1];
+		CHECK(cpu1.cpu == 1 && cpu1.currentMHz == 800.0f && cpu1.throttleCount == 0);
+	}
+
+	// The inputs stay open across ticks, so rewriting a file in place is what a changing sensor looks like
+	void TestRereads()
+	{
+		TempDir root;
+		WriteTree(root);
+		LinuxSensorMonitor monitor(root.Path() + "/sys");
+		monitor.Update();
+
+		root.Write("sys/class/hwmon/hwmon0/temp1_input", "72000\n");
+		root.Write("sys/class/hwmon/hwmon2/fan2_input", "2350\n");
+		root.Write("sys/devices/system/cpu/cpu0/cpufreq/scaling_cur_freq", "4100000\n");
+		root.Write("sys/devices/system/cpu/cpu0/thermal_throttle/core_throttle_count", "15\n");
+		// Throttles per second come from wall-clock time between updates; 200 ms bounds it to roughly [0.2 s, 1 s]
+		std::this_thread::sleep_for(std::chrono::milliseconds(200));
+		monitor.Update();
+
+		const SensorStats& sensors = monitor.GetSensors();
+		if (sensors.temperatures.size() != 2 || sensors.fans.size() != 1 || sensors.cpuFrequencies.size() != 2) {
+			CHECK(false);
+			return;
+		}
+		CHECK_NEAR(sensors.temperatures[0].value, 72.0, 1e-4);
+		CHECK_NEAR(sensors.temperatures[1].value, 51.5, 1e-4); // Unchanged
+		CHECK(sensors.fans[0].value == 2350.0f);
+		CHECK(sensors.cpuFrequencies[0].currentMHz == 4100.0f);
+		CHECK(sensors.cpuFrequencies[0].throttleCount == 15);
+		CHECK(sensors.cpuFrequencies[0].throttlesPerSec >= 10.0f && sensors.cpuFrequencies[0].throttlesPerSec <= 50.0f);
+	}
+
+	// A sensor that stops answering (an empty read) or returns garbage keeps its last value
+	void TestFailedRead()
+	{
+		TempDir root;
+		WriteTree(root);
+		LinuxSensorMonitor monitor(root.Path() + "/sys");
+		monitor.Update();
+
+		root.Write("sys/class/hwmon/hwmon0/temp1_input", "");
+		root.Write("sys/class/hwmon/hwmon2/fan2_input", "not a number\n");
+		root.Write("sys/devices/system/cpu/cpu0/cpufreq/scaling_cur_freq", "");
+		root.Write("sys/class/hwmon/hwmon0/temp3_input", "53000\n");
+		monitor.Update();
+
+		const SensorStats& sensors = monitor.GetSensors();
+		if (sensors.temperatures.size() != 2 || sensors.fans.size() != 1 || sensors.cpuFrequencies.size() != 2) {
+			CHECK(false);
+			return;
+		}
+		CHECK_NEAR(sensors.temperatures[0].value, 45.0, 1e-4);
+		CHECK_NEAR(sensors.temperatures[1].value, 53.0, 1e-4); // The others still update
+		CHECK(sensors.fans[0].value == 1200.0f);
+		CHECK(sensors.cpuFrequencies[0].currentMHz == 2400.0f);
+
+		root.Write("sys/class/hwmon/hwmon0/temp1_input", "46000\n");
+		monitor.Update();
+		CHECK_NEAR(sensors.temperatures[0].value, 46.0, 1e-4); // And it recovers
+	}
+
+	// VMs and containers often have no hwmon or cpufreq at all
+	void TestNoSensors()
+	{
+		TempDir root;
+		std::filesystem::create_directories(root.Path() + "/sys");
+		LinuxSensorMonitor monitor(root.Path() + "/sys");
+		CHECK(!monitor.IsAvailable());
+		monitor.Update();
+		CHECK(monitor.GetSensors().temperatures.empty());
+		CHECK(monitor.GetSensors().fans.empty());
+		CHECK(monitor.GetSensors().cpuFrequencies.empty());
+
+		// An hwmon chip that exposes only thresholds, and a cpu without cpufreq, still count as nothing
+		root.Write("sys/class/hwmon/hwmon0/name", "acpitz\n");
+		root.Write("sys/class/hwmon/hwmon0/temp1_crit", "105000\n");
+		root.Write("sys/devices/system/cpu/cpu0/online", "1\n");
+		LinuxSensorMonitor sparse(root.Path() + "/sys");
+		CHECK(!sparse.IsAvailable());
+	}
+}
+
+int main()
+{
+	TestDiscovery();
+	TestRereads();
+	TestFailedRead();
+	TestNoSensors();
+	return TestSupport::Result();
+}
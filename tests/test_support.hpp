@@ -0,0 +1,80 @@
+// TestSupport: The checks and fixture helpers the unit tests share. Each test is its own executable that returns
+// nonzero when a check failed, so ctest runs them without a framework; checks stay active in Release builds.
+#pragma once
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+
+namespace TestSupport
+{
+	inline int& Failures()
+	{
+		static int failures = 0;
+		return failures;
+	}
+
+	inline void Fail(const char* file, int line, const char* expression)
+	{
+		std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expression);
+		++Failures();
+	}
+
+	// Exit code for main(): 0 when every check passed
+	inline int Result()
+	{
+		if (Failures() > 0) std::fprintf(stderr, "%d check(s) failed\n", Failures());
+		return Failures() > 0 ? 1 : 0;
+	}
+
+	// A scratch directory for fixture trees (a fake /sys or /proc), removed when the test is done
+	class TempDir
+	{
+	public:
+		TempDir()
+		{
+			std::random_device random;
+			path_ = std::filesystem::temp_directory_path() / ("pulse-test-" + std::to_string(random()));
+			std::filesystem::create_directories(path_);
+		}
+
+		~TempDir()
+		{
+			std::error_code ignored;
+			std::filesystem::remove_all(path_, ignored);
+		}
+
+		TempDir(const TempDir&) = delete;
+		TempDir& operator=(const TempDir&) = delete;
+
+		std::string Path() const { return path_.string(); }
+
+		// Creates (or replaces) relativePath with content, making parent directories as needed
+		void Write(const std::string& relativePath, const std::string& content) const
+		{
+			std::filesystem::path file = path_ / relativePath;
+			std::filesystem::create_directories(file.parent_path());
+			std::ofstream(file, std::ios::binary | std::ios::trunc) << content;
+		}
+
+		// A symlink at relativePath pointing at target, which need not exist (fd entries under a fake /proc)
+		void Link(const std::string& relativePath, const std::string& target) const
+		{
+			std::filesystem::path link = path_ / relativePath;
+			std::filesystem::create_directories(link.parent_path());
+			std::filesystem::create_symlink(target, link);
+		}
+
+	private:
+		std::filesystem::path path_;
+	};
+}
+
+#define CHECK(expression) \
+	do { if (!(expression)) TestSupport::Fail(__FILE__, __LINE__, #expression); } while (0)
+
+#define CHECK_NEAR(actual, expected, tolerance) \
+	do { if (!(std::fabs(static_cast<double>(actual) - static_cast<double>(expected)) <= (tolerance))) \
+		TestSupport::Fail(__FILE__, __LINE__, #actual " near " #expected); } while (0)
@@ -0,0 +1,104 @@
+// Moves a TieredSeries and QuantileWindows onto a new arena as DataCollector::SetHistoryRetention does: the
+// raw window keeps its newest samples (shrinking or growing), the rollups and percentile windows carry over
+// unchanged, and pushes continue from where they left off.
+#include "core/quantile_sketch.hpp"
+#include "core/tiered_series.hpp"
+#include "test_support.hpp"
+#include <memory>
+#include <vector>
+
+namespace
+{
+	constexpr QuantileSketch::Mapping Percent{ 0.1f, 100.0f, 0.01f };
+
+	// Two hours of 1 Hz samples: 10 for the first hour, then 50 and 60 alternating
+	float Sample(uint64_t second)
+	{
+		return second < 3600 ? 10.0f : (second % 2 ? 50.0f : 60.0f);
+	}
+
+	void TestReallocate()
+	{
+		auto arena = std::make_unique<SeriesArena>(TieredSeries::storageBytes(60) + QuantileWindows::storageBytes(Percent));
+		TieredSeries history;
+		QuantileWindows quantiles;
+		history.allocate(*arena, 60);
+		quantiles.allocate(*arena, Percent);
+		for (uint64_t second = 1; second <= 2 * 3600; ++second) {
+			history.push(second * 1000, Sample(second));
+			quantiles.push(second * 1000, Sample(second));
+		}
+
+		SeriesStats::Summary hours = history.summarize(2 * 3'600'000);
+		std::vector<TieredSeries::Point> before;
+		history.queryTier(TieredSeries::Tier::OneMinute, 2 * 3600, before);
+		QuantileWindows::Percentiles lastHour = quantiles.percentiles(QuantileWindows::Window::LastHour);
+
+		// Shrinking keeps the newest 30 raw samples; the old arena is freed only afterwards
+		auto smaller = std::make_unique<SeriesArena>(TieredSeries::storageBytes(30) + QuantileWindows::storageBytes(Percent));
+		CHECK(history.reallocate(*smaller, 30));
+		quantiles.reallocate(*smaller, Percent);
+		arena = std::move(smaller);
+
+		CHECK(history.size() == 30);
+		CHECK(history.latestTime() == 2 * 3600 * 1000);
+		CHECK(history.rawTimes().get(0) == (2 * 3600 - 29) * 1000);
+		CHECK(history.get(0) == Sample(2 * 3600 - 29));
+		CHECK(history.latest() == Sample(2 * 3600));
+
+		SeriesStats::Summary after = history.summarize(2 * 3'600'000);
+		CHECK(after.count == hours.count);
+		CHECK(after.min == hours.min && after.max == hours.max);
+		CHECK_NEAR(after.sum, hours.sum, 1e-3);
+		std::vector<TieredSeries::Point> points;
+		history.queryTier(TieredSeries::Tier::OneMinute, 2 * 3600, points);
+		CHECK(points.size() == before.size());
+		for (size_t i = 0; i < points.size() && i < before.size(); ++i) {
+			CHECK(points[i].time == before[i].time && points[i].avg == before[i].avg);
+		}
+
+		CHECK(quantiles.sketch(QuantileWindows::Window::SinceStart).count() == 2 * 3600);
+		CHECK(quantiles.percentiles(QuantileWindows::Window::LastHour).p50 == lastHour.p50);
+		CHECK_NEAR(quantiles.quantile(QuantileWindows::Window::SinceStart, 0.25f), 10.0, 0.1);
+
+		// Growing keeps what there is and fills the rest from new pushes
+		auto larger = std::make_unique<SeriesArena>(TieredSeries::storageBytes(120) + QuantileWindows::storageBytes(Percent));
+		CHECK(history.reallocate(*larger, 120));
+		quantiles.reallocate(*larger, Percent);
+		arena = std::move(larger);
+		CHECK(history.size() == 30);
+		for (uint64_t second = 2 * 3600 + 1; second <= 2 * 3600 + 100; ++second) {
+			history.push(second * 1000, 70.0f);
+			quantiles.push(second * 1000, 70.0f);
+		}
+		CHECK(history.size() == 120);
+		CHECK(history.get(19) == Sample(2 * 3600));
+		CHECK(history.get(20) == 70.0f);
+		CHECK(history.summarize(3'600'000).max == 70.0f);
+		CHECK_NEAR(quantiles.quantile(QuantileWindows::Window::LastMinute, 0.5f), 70.0, 0.7);
+	}
+
+	// A series that never had storage moves like an empty one; an arena too small leaves it empty
+	void TestReallocateEdges()
+	{
+		SeriesArena arena{ TieredSeries::storageBytes(10) };
+		TieredSeries history;
+		CHECK(history.reallocate(arena, 10));
+		CHECK(history.empty());
+		history.push(1000, 1.0f);
+		CHECK(history.size() == 1);
+
+		SeriesArena tooSmall{ TieredSeries::storageBytes(10) - 1 };
+		CHECK(!history.reallocate(tooSmall, 10));
+		CHECK(history.empty());
+		history.push(2000, 2.0f);
+		CHECK(history.empty());
+	}
+}
+
+int main()
+{
+	TestReallocate();
+	TestReallocateEdges();
+	return TestSupport::Result();
+}